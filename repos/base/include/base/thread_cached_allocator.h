@@ -0,0 +1,447 @@
+/*
+ * \brief  Allocator front end with per-thread caches of small blocks
+ * \author agent
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__BASE__THREAD_CACHED_ALLOCATOR_H_
+#define _INCLUDE__BASE__THREAD_CACHED_ALLOCATOR_H_
+
+#include <base/allocator.h>
+#include <base/thread.h>
+
+namespace Genode { class Thread_cached_allocator; }
+
+
+/**
+ * Allocator that keeps freed small blocks in per-thread magazines
+ *
+ * Each thread that allocates a block of a cached size obtains a cache of its
+ * own, identified by its 'Thread' object. Only the owner accesses the
+ * magazines of its cache, which therefore need no lock. Allocations are
+ * rounded up to one of 'NUM_SIZE_CLASSES' power-of-two size classes,
+ * including a header that names the owning cache. A block freed by the owner
+ * goes to its magazine. A block freed by another thread is pushed onto a
+ * lock-free list of the owning cache and moved to the magazines by the owner
+ * on its next allocation. Only magazine misses and overflows reach the
+ * backing allocator, e.g., a 'Heap'.
+ *
+ * Blocks held in magazines remain allocated at the backing allocator. Each
+ * cache holds at most 'MAX_CACHED_BYTES'. If the backing allocator denies an
+ * allocation, the cache of the calling thread and the caches released by
+ * exited threads are flushed before the allocation is retried.
+ *
+ * A thread should call 'release_cache' before it exits. Its cache is then
+ * flushed and taken over by the next thread that needs one. Beyond
+ * 'MAX_CACHES' concurrent caches, threads allocate from the backing
+ * allocator directly, as do threads without a 'Thread' object and
+ * allocations larger than the biggest size class.
+ */
+class Genode::Thread_cached_allocator : public Allocator
+{
+	public:
+
+		enum {
+			MAX_CACHES       = 32,
+			NUM_SIZE_CLASSES = 8,
+			MIN_CLASS_LOG2   = 5,   /* 32 bytes */
+			MAGAZINE_SIZE    = 16,
+			MAX_CACHED_BYTES = 32*1024,
+		};
+
+	private:
+
+		/*
+		 * Noncopyable
+		 */
+		Thread_cached_allocator(Thread_cached_allocator const &);
+		Thread_cached_allocator &operator = (Thread_cached_allocator const &);
+
+		struct Cache;
+
+		/*
+		 * Header in front of each block, padded to keep the 16-byte
+		 * alignment of the blocks returned by the backing allocator
+		 */
+		struct alignas(16) Header
+		{
+			Cache  *cache;  /* owning cache, or nullptr if not cached */
+			size_t  size;   /* size of the block at the backing allocator */
+		};
+
+		struct Magazine
+		{
+			unsigned  count { 0 };
+			Header   *blocks[MAGAZINE_SIZE] { };
+		};
+
+		struct Cache
+		{
+			/*
+			 * Noncopyable
+			 */
+			Cache(Cache const &);
+			Cache &operator = (Cache const &);
+
+			Thread const *owner;                 /* accessed atomically */
+			Header       *remote       { };      /* accessed atomically */
+			size_t        cached_bytes { 0 };    /* written by the owner only */
+			Magazine      magazines[NUM_SIZE_CLASSES] { };
+
+			Cache(Thread const *owner) : owner(owner) { }
+
+			bool owned_by(Thread const *thread) const {
+				return __atomic_load_n(&owner, __ATOMIC_ACQUIRE) == thread; }
+		};
+
+		Allocator &_backing;
+
+		Cache *_caches[MAX_CACHES] { };  /* accessed atomically */
+
+		Cache *_cache(unsigned i) const {
+			return __atomic_load_n(&_caches[i], __ATOMIC_ACQUIRE); }
+
+		/*
+		 * Owner of a released cache while it is flushed by another thread,
+		 * which never matches a 'Thread' object
+		 */
+		Thread const *_flushing() const { return (Thread const *)this; }
+
+		static constexpr size_t _class_size(unsigned idx) {
+			return (size_t)1 << (idx + MIN_CLASS_LOG2); }
+
+		/**
+		 * Return size-class index for 'size' or NUM_SIZE_CLASSES if too big
+		 */
+		static unsigned _class_idx(size_t size)
+		{
+			unsigned idx = 0;
+			while (idx < NUM_SIZE_CLASSES && _class_size(idx) < size)
+				idx++;
+			return idx;
+		}
+
+		static void *_payload(Header *header) { return header + 1; }
+
+		static Header *_header(void *payload) { return (Header *)payload - 1; }
+
+		/*
+		 * Link of a block in the remote-free list, stored in its payload
+		 */
+		static Header *&_next(Header *header) { return *(Header **)_payload(header); }
+
+		static void _cached_bytes(Cache &cache, size_t value) {
+			__atomic_store_n(&cache.cached_bytes, value, __ATOMIC_RELAXED); }
+
+		/**
+		 * Return cache of the calling thread or nullptr if there is none
+		 */
+		Cache *_my_cache()
+		{
+			Thread const * const myself = Thread::myself();
+			if (!myself)
+				return nullptr;
+
+			for (unsigned i = 0; i < MAX_CACHES; i++) {
+				Cache * const cache = _cache(i);
+				if (!cache)
+					break;
+				if (cache->owned_by(myself))
+					return cache;
+			}
+
+			/* take over a cache released by an exited thread */
+			for (unsigned i = 0; i < MAX_CACHES; i++) {
+				Cache * const cache = _cache(i);
+				if (!cache)
+					break;
+
+				Thread const *expected = nullptr;
+				if (__atomic_compare_exchange_n(&cache->owner, &expected, myself,
+				                                false, __ATOMIC_ACQUIRE,
+				                                __ATOMIC_RELAXED))
+					return cache;
+			}
+
+			/* create a new cache */
+			return _backing.try_alloc(sizeof(Cache)).convert<Cache *>(
+				[&] (void *ptr) -> Cache * {
+					Cache * const cache = construct_at<Cache>(ptr, myself);
+
+					for (unsigned i = 0; i < MAX_CACHES; i++) {
+						Cache *expected = nullptr;
+						if (__atomic_compare_exchange_n(&_caches[i], &expected, cache,
+						                                false, __ATOMIC_RELEASE,
+						                                __ATOMIC_RELAXED))
+							return cache;
+					}
+					cache->~Cache();
+					_backing.free(ptr, sizeof(Cache));
+					return nullptr; },
+				[&] (Alloc_error) -> Cache * { return nullptr; });
+		}
+
+		/**
+		 * Put block into a magazine of 'cache', called by the owner only
+		 *
+		 * \return false if the magazine is full or the cache limit reached
+		 */
+		static bool _cache_block(Cache &cache, Header *header)
+		{
+			Magazine &magazine = cache.magazines[_class_idx(header->size)];
+
+			if (magazine.count == MAGAZINE_SIZE
+			 || cache.cached_bytes + header->size > MAX_CACHED_BYTES)
+				return false;
+
+			magazine.blocks[magazine.count++] = header;
+			_cached_bytes(cache, cache.cached_bytes + header->size);
+			return true;
+		}
+
+		/**
+		 * Move blocks freed by other threads into the magazines of 'cache'
+		 */
+		void _drain_remote(Cache &cache)
+		{
+			if (!__atomic_load_n(&cache.remote, __ATOMIC_RELAXED))
+				return;
+
+			Header *header = __atomic_exchange_n(&cache.remote, nullptr,
+			                                     __ATOMIC_ACQUIRE);
+			while (header) {
+				Header * const next = _next(header);
+				if (!_cache_block(cache, header))
+					_backing.free(header, header->size);
+				header = next;
+			}
+		}
+
+		static void _push_remote(Cache &cache, Header *header)
+		{
+			Header *head = __atomic_load_n(&cache.remote, __ATOMIC_RELAXED);
+			do {
+				_next(header) = head;
+			} while (!__atomic_compare_exchange_n(&cache.remote, &head, header,
+			                                      true, __ATOMIC_RELEASE,
+			                                      __ATOMIC_RELAXED));
+		}
+
+		/**
+		 * Release all blocks of 'cache', which must be owned by the caller
+		 */
+		void _flush(Cache &cache)
+		{
+			_drain_remote(cache);
+
+			for (Magazine &magazine : cache.magazines)
+				while (magazine.count) {
+					Header * const header = magazine.blocks[--magazine.count];
+					_backing.free(header, header->size);
+				}
+
+			_cached_bytes(cache, 0);
+		}
+
+		/**
+		 * Flush the caches of exited threads
+		 */
+		void _flush_released()
+		{
+			for (unsigned i = 0; i < MAX_CACHES; i++) {
+				Cache * const cache = _cache(i);
+				if (!cache)
+					break;
+
+				Thread const *expected = nullptr;
+				if (!__atomic_compare_exchange_n(&cache->owner, &expected, _flushing(),
+				                                 false, __ATOMIC_ACQUIRE,
+				                                 __ATOMIC_RELAXED))
+					continue;
+
+				_flush(*cache);
+				__atomic_store_n(&cache->owner, nullptr, __ATOMIC_RELEASE);
+			}
+		}
+
+		Alloc_result _backing_alloc(size_t size, Cache *cache)
+		{
+			Alloc_result result = _backing.try_alloc(size);
+			if (result.ok())
+				return result;
+
+			if (cache)
+				_flush(*cache);
+			_flush_released();
+
+			return _backing.try_alloc(size);
+		}
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param backing  allocator used for magazine misses and big blocks,
+		 *                 which must be thread safe
+		 */
+		Thread_cached_allocator(Allocator &backing) : _backing(backing) { }
+
+		/**
+		 * Destructor
+		 *
+		 * Must not be called while other threads use the allocator.
+		 */
+		~Thread_cached_allocator()
+		{
+			for (unsigned i = 0; i < MAX_CACHES; i++) {
+				Cache * const cache = _cache(i);
+				if (!cache)
+					break;
+
+				_flush(*cache);
+				cache->~Cache();
+				_backing.free(cache, sizeof(Cache));
+			}
+		}
+
+		/**
+		 * Flush the cache of the calling thread and release it for the use
+		 * by other threads, to be called by a thread before it exits
+		 *
+		 * Blocks of the cache freed later are kept for the next owner.
+		 */
+		void release_cache()
+		{
+			Thread const * const myself = Thread::myself();
+			if (!myself)
+				return;
+
+			for (unsigned i = 0; i < MAX_CACHES; i++) {
+				Cache * const cache = _cache(i);
+				if (!cache)
+					break;
+
+				if (cache->owned_by(myself)) {
+					_flush(*cache);
+					__atomic_store_n(&cache->owner, nullptr, __ATOMIC_RELEASE);
+					return;
+				}
+			}
+		}
+
+		/**
+		 * Release the blocks cached by the calling thread and by exited
+		 * threads to the backing allocator
+		 *
+		 * The caches of other threads are left untouched.
+		 */
+		void flush()
+		{
+			Thread const * const myself = Thread::myself();
+
+			for (unsigned i = 0; myself && i < MAX_CACHES; i++) {
+				Cache * const cache = _cache(i);
+				if (cache && cache->owned_by(myself))
+					_flush(*cache);
+			}
+
+			_flush_released();
+		}
+
+		/**
+		 * Return number of bytes currently held in magazines
+		 *
+		 * Blocks freed by other threads and not yet drained by the owner
+		 * are not included.
+		 */
+		size_t cached() const
+		{
+			size_t result = 0;
+			for (unsigned i = 0; i < MAX_CACHES; i++)
+				if (Cache const * const cache = _cache(i))
+					result += __atomic_load_n(&cache->cached_bytes, __ATOMIC_RELAXED);
+			return result;
+		}
+
+
+		/*************************
+		 ** Allocator interface **
+		 *************************/
+
+		Alloc_result try_alloc(size_t size) override
+		{
+			size_t   const total = size + sizeof(Header);
+			unsigned const idx   = _class_idx(total);
+
+			Cache * const cache = (idx < NUM_SIZE_CLASSES) ? _my_cache() : nullptr;
+			if (cache) {
+				_drain_remote(*cache);
+
+				Magazine &magazine = cache->magazines[idx];
+				if (magazine.count) {
+					Header * const header = magazine.blocks[--magazine.count];
+					_cached_bytes(*cache, cache->cached_bytes - header->size);
+					return _payload(header);
+				}
+			}
+
+			size_t const backing_size = cache ? _class_size(idx) : total;
+
+			return _backing_alloc(backing_size, cache).convert<Alloc_result>(
+				[&] (void *ptr) {
+					Header * const header = (Header *)ptr;
+					header->cache = cache;
+					header->size  = backing_size;
+					return _payload(header); },
+				[&] (Alloc_error error) {
+					return error; });
+		}
+
+		void free(void *addr, size_t) override
+		{
+			if (!addr)
+				return;
+
+			Header * const header = _header(addr);
+			Cache  * const cache  = header->cache;
+
+			if (!cache) {
+				_backing.free(header, header->size);
+				return;
+			}
+
+			Thread const * const myself = Thread::myself();
+			if (myself && cache->owned_by(myself)) {
+				if (!_cache_block(*cache, header))
+					_backing.free(header, header->size);
+				return;
+			}
+
+			/* return the block to its owner */
+			_push_remote(*cache, header);
+		}
+
+		size_t consumed() const override { return _backing.consumed(); }
+
+		size_t overhead(size_t size) const override
+		{
+			size_t   const total = size + sizeof(Header);
+			unsigned const idx   = _class_idx(total);
+			size_t   const backing_size =
+				(idx < NUM_SIZE_CLASSES) ? _class_size(idx) : total;
+
+			return backing_size - size + _backing.overhead(backing_size);
+		}
+
+		bool need_size_for_free() const override { return false; }
+};
+
+#endif /* _INCLUDE__BASE__THREAD_CACHED_ALLOCATOR_H_ */
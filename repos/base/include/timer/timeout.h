@@ -85,8 +85,7 @@ struct Genode::Time_source : Interface
  * example, in a Timer-session server. If this is not the case, the classes
  * Periodic_timeout and One_shot_timeout are the better choice.
  */
-class Genode::Timeout : private Noncopyable,
-                        public Genode::List<Timeout>::Element
+class Genode::Timeout : private Noncopyable
 {
 	friend class Timeout_scheduler;
 
@@ -102,6 +101,14 @@ class Genode::Timeout : private Noncopyable,
 		bool                   _in_discard_blockade { false };
 		Blockade               _discard_blockade    { };
 
+		/*
+		 * Links within the timing-wheel slot of the scheduler
+		 */
+		Timeout               *_wheel_prev          { nullptr };
+		Timeout               *_wheel_next          { nullptr };
+		unsigned               _wheel_slot          { 0 };
+		bool                   _in_wheel            { false };
+
 		Timeout(Timeout const &);
 
 		Timeout &operator = (Timeout const &);
@@ -130,6 +137,18 @@ class Genode::Timeout : private Noncopyable,
 
 /**
  * Multiplexes one time source amongst different timeouts
+ *
+ * Scheduled timeouts are kept in a hierarchical timing wheel. Each level
+ * of the wheel has 64 slots, and each slot is an intrusive doubly-linked
+ * list of timeouts. A slot of level n covers 64^n microseconds. Hence,
+ * scheduling and discarding a timeout take constant time, independent of
+ * the number of scheduled timeouts.
+ *
+ * When the time advances, the slots that were passed are emptied. Their
+ * timeouts either trigger or move to a finer level. Each timeout moves at
+ * most once per level. The time source is programmed to the start of the
+ * earliest occupied slot, which is the exact deadline for the finest level
+ * and a lower bound for the coarser levels.
  */
 class Genode::Timeout_scheduler : private Noncopyable,
                                   public  Timeout_handler
@@ -142,16 +161,44 @@ class Genode::Timeout_scheduler : private Noncopyable,
 
 		static constexpr uint64_t max_sleep_time_us { 60'000'000 };
 
+		static constexpr unsigned SLOTS_LOG2 = 6;
+		static constexpr unsigned SLOTS      = 1u << SLOTS_LOG2;
+		static constexpr unsigned LEVELS     = (64 + SLOTS_LOG2 - 1) / SLOTS_LOG2;
+		static constexpr unsigned NO_SLOT    = LEVELS * SLOTS;
+
 		Mutex               _mutex              { };
 		Time_source        &_time_source;
 		Microseconds const  _max_sleep_time     { min(_time_source.max_timeout().value, max_sleep_time_us) };
-		List<Timeout>       _timeouts           { };
+		Timeout            *_wheel[LEVELS * SLOTS] { };
+		uint64_t            _occupied[LEVELS]   { };  /* bitmap of non-empty slots */
+		uint64_t            _wheel_time_us      { 0 };
 		Microseconds        _current_time       { 0 };
 		bool                _destructor_called  { false };
 		Microseconds        _rate_limit_period;
 		Microseconds        _rate_limit_deadline;
 
-		void _insert_into_timeouts_list(Timeout &timeout);
+		void _insert_into_timeouts_wheel(Timeout &timeout);
+
+		void _remove_from_timeouts_wheel(Timeout &timeout);
+
+		/**
+		 * Advance the wheel to 'now_us'
+		 *
+		 * Timeouts with a deadline not later than 'now_us' are removed from
+		 * the wheel and added to 'expired' with their mutex acquired.
+		 */
+		void _advance_timeouts_wheel(uint64_t                      now_us,
+		                             List<List_element<Timeout> > &expired);
+
+		/**
+		 * Return index of the earliest occupied slot, or 'NO_SLOT'
+		 */
+		unsigned _first_occupied_slot() const;
+
+		/**
+		 * Return start time of the given slot, a lower bound of its deadlines
+		 */
+		uint64_t _slot_start_us(unsigned slot) const;
 
 		void _set_time_source_timeout();
 
@@ -85,20 +85,12 @@ void Timeout_scheduler::handle_timeout(Duration curr_time)
 
 		/*
 		 * Filter out all pending timeouts to a local list first. The
-		 * processing of pending timeouts can have effects on the '_timeouts'
-		 * list and these would interfere with the filtering if we would do
+		 * processing of pending timeouts can have effects on the timeouts
+		 * wheel and these would interfere with the filtering if we would do
 		 * it all in the same loop.
 		 */
-		while (Timeout *timeout = _timeouts.first()) {
+		_advance_timeouts_wheel(_current_time.value, pending_timeouts);
 
-			timeout->_mutex.acquire();
-			if (timeout->_deadline.value > _current_time.value) {
-				timeout->_mutex.release();
-				break;
-			}
-			_timeouts.remove(timeout);
-			pending_timeouts.insert(&timeout->_pending_timeouts_le);
-		}
 		/*
 		 * Do the framework-internal processing of the pending timeouts and
 		 * then release their mutexes.
@@ -153,9 +145,9 @@ void Timeout_scheduler::handle_timeout(Duration curr_time)
 				if (deadline_us < _current_time.value) {
 					deadline_us = ~(uint64_t)0;
 				}
-				/* re-insert timeout into timeouts list */
+				/* re-insert timeout into timeouts wheel */
 				timeout._deadline = Microseconds { deadline_us };
-				_insert_into_timeouts_list(timeout);
+				_insert_into_timeouts_wheel(timeout);
 			}
 			timeout._mutex.release();
 		}
@@ -223,9 +215,10 @@ Timeout_scheduler::~Timeout_scheduler()
 	_destructor_called = true;
 
 	/* discard all scheduled timeouts */
-	while (Timeout *timeout = _timeouts.first()) {
-		Mutex::Guard const timeout_guard { timeout->_mutex };
-		_discard_timeout_unsynchronized(*timeout);
+	for (unsigned slot; (slot = _first_occupied_slot()) != NO_SLOT; ) {
+		Timeout &timeout { *_wheel[slot] };
+		Mutex::Guard const timeout_guard { timeout._mutex };
+		_discard_timeout_unsynchronized(timeout);
 	}
 }
 
@@ -242,10 +235,14 @@ void Timeout_scheduler::_enable()
 
 void Timeout_scheduler::_set_time_source_timeout()
 {
-	_set_time_source_timeout(
-		_timeouts.first() ?
-			_timeouts.first()->_deadline.value - _current_time.value :
-			~(uint64_t)0);
+	unsigned const slot { _first_occupied_slot() };
+	if (slot == NO_SLOT) {
+		_set_time_source_timeout(~(uint64_t)0);
+		return;
+	}
+	uint64_t const start_us { _slot_start_us(slot) };
+	_set_time_source_timeout(start_us > _current_time.value ?
+	                         start_us - _current_time.value : 0);
 }
 
 
@@ -296,9 +293,8 @@ void Timeout_scheduler::_schedule_timeout(Timeout         &timeout,
 	Mutex::Guard const timeout_guard(timeout._mutex);
 
 	/* prevent inserting a timeout twice */
-	if (timeout._handler != nullptr) {
-		_timeouts.remove(&timeout);
-	}
+	_remove_from_timeouts_wheel(timeout);
+
 	/* determine timeout deadline */
 	uint64_t const curr_time_us {
 		_time_source.curr_time().trunc_to_plain_us().value };
@@ -307,42 +303,177 @@ void Timeout_scheduler::_schedule_timeout(Timeout         &timeout,
 		duration.value <= ~(uint64_t)0 - curr_time_us ?
 			curr_time_us + duration.value : ~(uint64_t)0 };
 
-	/* set up timeout object and insert into timeouts list */
+	/* set up timeout object and insert into timeouts wheel */
 	timeout._handler = &handler;
 	timeout._deadline = Microseconds { deadline_us };
 	timeout._period = period;
-	_insert_into_timeouts_list(timeout);
+	_insert_into_timeouts_wheel(timeout);
+
+	/*
+	 * If the new timeout is in the first slot to trigger, we have to update
+	 * the time-source timeout.
+	 */
+	if (_first_occupied_slot() == timeout._wheel_slot) {
+		uint64_t const start_us { _slot_start_us(timeout._wheel_slot) };
+		_set_time_source_timeout(start_us > curr_time_us ?
+		                         start_us - curr_time_us : 0);
+	}
+}
+
+
+/*
+ * Return the bits of 'value' from bit 'shift' on upwards
+ */
+static uint64_t high_bits(uint64_t value, unsigned shift)
+{
+	return shift < 64 ? value >> shift : 0;
+}
 
+
+void Timeout_scheduler::_insert_into_timeouts_wheel(Timeout &timeout)
+{
 	/*
-	 * If the new timeout is the first to trigger, we have to  update the
-	 * time-source timeout.
+	 * The level of a timeout is determined by the most significant bit in
+	 * which its deadline differs from the time of the wheel. Deadlines that
+	 * have already passed go to the current slot of the finest level.
 	 */
-	if (_timeouts.first() == &timeout) {
-		_set_time_source_timeout(deadline_us - curr_time_us);
+	uint64_t const deadline_us { max(timeout._deadline.value, _wheel_time_us) };
+	uint64_t const diff        { deadline_us ^ _wheel_time_us };
+
+	unsigned const level {
+		diff ? (unsigned)(63 - __builtin_clzll(diff)) / SLOTS_LOG2 : 0 };
+
+	unsigned const slot {
+		level * SLOTS +
+		(unsigned)(high_bits(deadline_us, level * SLOTS_LOG2) & (SLOTS - 1)) };
+
+	Timeout *const head { _wheel[slot] };
+	timeout._wheel_prev = nullptr;
+	timeout._wheel_next = head;
+	timeout._wheel_slot = slot;
+	timeout._in_wheel   = true;
+	if (head) {
+		head->_wheel_prev = &timeout;
 	}
+	_wheel[slot] = &timeout;
+	_occupied[level] |= (uint64_t)1 << (slot % SLOTS);
 }
 
 
-void Timeout_scheduler::_insert_into_timeouts_list(Timeout &timeout)
+void Timeout_scheduler::_remove_from_timeouts_wheel(Timeout &timeout)
 {
-	/* if timeout list is empty, insert as first element */
-	if (_timeouts.first() == nullptr) {
-		_timeouts.insert(&timeout);
+	if (!timeout._in_wheel) {
 		return;
 	}
-	/* if timeout has the shortest deadline, insert as first element */
-	if (_timeouts.first()->_deadline.value >= timeout._deadline.value) {
-		_timeouts.insert(&timeout);
+	timeout._in_wheel = false;
+
+	unsigned const slot { timeout._wheel_slot };
+	if (timeout._wheel_prev) {
+		timeout._wheel_prev->_wheel_next = timeout._wheel_next;
+	} else {
+		_wheel[slot] = timeout._wheel_next;
+	}
+	if (timeout._wheel_next) {
+		timeout._wheel_next->_wheel_prev = timeout._wheel_prev;
+	}
+	if (!_wheel[slot]) {
+		_occupied[slot / SLOTS] &= ~((uint64_t)1 << (slot % SLOTS));
+	}
+	timeout._wheel_prev = nullptr;
+	timeout._wheel_next = nullptr;
+}
+
+
+void Timeout_scheduler::_advance_timeouts_wheel(uint64_t                      now_us,
+                                                List<List_element<Timeout> > &expired)
+{
+	uint64_t const old_us { _wheel_time_us };
+	if (now_us < old_us) {
 		return;
 	}
-	/* find list element with next shorter deadline and insert behind it */
-	Timeout *curr_timeout { _timeouts.first() };
-	for (;
-	     curr_timeout->next() != nullptr &&
-	     curr_timeout->next()->_deadline.value < timeout._deadline.value;
-	     curr_timeout = curr_timeout->_next);
-
-	_timeouts.insert(&timeout, curr_timeout);
+	_wheel_time_us = now_us;
+
+	for (unsigned level = 0; level < LEVELS; level++) {
+
+		unsigned const shift { level * SLOTS_LOG2 };
+
+		/*
+		 * If the time advanced beyond the span of the level, all of its
+		 * slots were passed. Otherwise, only the slots up to the current
+		 * one were passed. The timeouts of a coarser level always lie in a
+		 * slot after the one of the wheel time, whereas timeouts of the
+		 * finest level may lie in the current slot.
+		 */
+		uint64_t passed { ~(uint64_t)0 };
+		if (high_bits(old_us, shift + SLOTS_LOG2) ==
+		    high_bits(now_us, shift + SLOTS_LOG2)) {
+
+			unsigned const from {
+				(unsigned)(high_bits(old_us, shift) & (SLOTS - 1)) + (level ? 1 : 0) };
+
+			unsigned const to {
+				(unsigned)(high_bits(now_us, shift) & (SLOTS - 1)) };
+
+			if (from > to) {
+				continue;
+			}
+			passed = (~(uint64_t)0 << from) & (~(uint64_t)0 >> (63 - to));
+		}
+		passed &= _occupied[level];
+
+		/* empty the passed slots and re-distribute their timeouts */
+		while (passed) {
+
+			unsigned const slot {
+				level * SLOTS + (unsigned)__builtin_ctzll(passed) };
+
+			passed &= passed - 1;
+
+			Timeout *next { _wheel[slot] };
+			_wheel[slot] = nullptr;
+			_occupied[level] &= ~((uint64_t)1 << (slot % SLOTS));
+			while (Timeout *timeout = next) {
+
+				next = timeout->_wheel_next;
+				timeout->_wheel_prev = nullptr;
+				timeout->_wheel_next = nullptr;
+				timeout->_in_wheel   = false;
+
+				if (timeout->_deadline.value > now_us) {
+					_insert_into_timeouts_wheel(*timeout);
+					continue;
+				}
+				timeout->_mutex.acquire();
+				expired.insert(&timeout->_pending_timeouts_le);
+			}
+		}
+	}
+}
+
+
+unsigned Timeout_scheduler::_first_occupied_slot() const
+{
+	/*
+	 * All timeouts of a finer level trigger before those of a coarser
+	 * level, and the slots of a level are ordered by time.
+	 */
+	for (unsigned level = 0; level < LEVELS; level++) {
+		if (_occupied[level]) {
+			return level * SLOTS + (unsigned)__builtin_ctzll(_occupied[level]);
+		}
+	}
+	return NO_SLOT;
+}
+
+
+uint64_t Timeout_scheduler::_slot_start_us(unsigned slot) const
+{
+	unsigned const shift { (slot / SLOTS) * SLOTS_LOG2 };
+	uint64_t const upper {
+		shift + SLOTS_LOG2 < 64 ?
+			(_wheel_time_us >> (shift + SLOTS_LOG2)) << (shift + SLOTS_LOG2) : 0 };
+
+	return upper | ((uint64_t)(slot % SLOTS) << shift);
 }
 
 
@@ -393,7 +524,7 @@ void Timeout_scheduler::_discard_timeout_unsynchronized(Timeout &timeout)
 		timeout._mutex.acquire();
 		timeout._in_discard_blockade = false;
 	}
-	_timeouts.remove(&timeout);
+	_remove_from_timeouts_wheel(timeout);
 	timeout._handler = nullptr;
 }
 
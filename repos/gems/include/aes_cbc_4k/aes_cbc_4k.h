@@ -14,6 +14,11 @@
 #ifndef _AES_CBC_4K_H_
 #define _AES_CBC_4K_H_
 
+/* Genode includes */
+#include <base/stdint.h>
+
+struct evp_cipher_ctx_st;
+
 namespace Aes_cbc_4k {
 
 	struct Key   { char values[32];   };
@@ -26,6 +31,61 @@ namespace Aes_cbc_4k {
 
 	void encrypt(Key const &, Block_number, Plaintext  const &, Ciphertext &);
 	void decrypt(Key const &, Block_number, Ciphertext const &, Plaintext  &);
+
+	class Key_schedule;
 }
 
+
+/**
+ * Expanded key material for encrypting/decrypting with one key
+ *
+ * Expanding the AES key and deriving the ESSIV key from the hash of the key
+ * is done once on construction instead of for each block. The cipher
+ * contexts use the AES instructions of the CPU (AES-NI, ARMv8 crypto
+ * extension) if available. All key material is wiped on destruction.
+ *
+ * Encrypting and decrypting modify the state of the cipher contexts. Hence,
+ * a key schedule must not be used by multiple threads concurrently.
+ */
+class Aes_cbc_4k::Key_schedule
+{
+	private:
+
+		evp_cipher_ctx_st *_encrypt { nullptr };
+		evp_cipher_ctx_st *_decrypt { nullptr };
+		evp_cipher_ctx_st *_essiv   { nullptr };
+
+		bool _iv(Block_number, unsigned char (&)[16]);
+
+		/*
+		 * Noncopyable
+		 */
+		Key_schedule(Key_schedule const &) = delete;
+		Key_schedule &operator = (Key_schedule const &) = delete;
+
+	public:
+
+		Key_schedule(Key const &);
+
+		~Key_schedule();
+
+		bool valid() const { return _encrypt && _decrypt && _essiv; }
+
+		/**
+		 * Encrypt 'num_blocks' blocks with consecutive block numbers
+		 *
+		 * \return  false if the cipher reported an error
+		 */
+		bool encrypt(Block_number first, Plaintext const *plain,
+		             Ciphertext *cipher, Genode::size_t num_blocks = 1);
+
+		/**
+		 * Decrypt 'num_blocks' blocks with consecutive block numbers
+		 *
+		 * \return  false if the cipher reported an error
+		 */
+		bool decrypt(Block_number first, Ciphertext const *cipher,
+		             Plaintext *plain, Genode::size_t num_blocks = 1);
+};
+
 #endif /* _AES_CBC_4K_H_ */
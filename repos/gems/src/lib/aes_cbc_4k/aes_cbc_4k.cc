@@ -12,11 +12,13 @@
  */
 
 #include <base/log.h>
+#include <base/mutex.h>
+#include <util/reconstructible.h>
 #include <util/string.h>
 
 #include <aes_cbc_4k/aes_cbc_4k.h>
 
-#include <openssl/aes.h>
+#include <openssl/evp.h>
 #include <openssl/sha.h>
 
 namespace Aes_cbc
@@ -67,100 +69,196 @@ static void inline cleanup_crypto_data(T &t)
 	asm volatile(""::"r"(&t):"memory");
 }
 
-template <typename T, typename S>
-static void inline cleanup_crypto_data(T &t, S &s)
+Aes_cbc_4k::Key_schedule::Key_schedule(Key const &key)
+:
+	_encrypt(EVP_CIPHER_CTX_new()), _decrypt(EVP_CIPHER_CTX_new()),
+	_essiv(EVP_CIPHER_CTX_new())
 {
-	Genode::memset(&t,  0, sizeof(t));
-	Genode::memset(&s,  0, sizeof(s));
-	/* trigger compiler to not drop the memsets */
-	asm volatile(""::"r"(&t),"r"(&s):"memory");
+	static_assert(sizeof(key.values) == 32, "Key size mismatch");
+
+	if (!valid()) {
+		Genode::error("allocating cipher contexts");
+		return;
+	}
+
+	unsigned char const * const key_values =
+		reinterpret_cast<unsigned char const *>(key.values);
+
+	/*
+	 * Derive the key for calculating the initialization vectors according to
+	 * the "Encrypted salt-sector initialization vector" (ESSIV) algorithm
+	 * by Clemens Fruhwirth (July 18, 2005) published in "New Methods in Hard
+	 * Disk Encryption" paper. Encrypting the single-block sector number in
+	 * CBC mode with a zero IV, as done originally, equals ECB mode.
+	 */
+	Aes_cbc::Hash hash_of_key;
+	bool const ok =
+		hash_key(key, hash_of_key) &&
+		EVP_EncryptInit_ex(_encrypt, EVP_aes_256_cbc(), nullptr, key_values,         nullptr) &&
+		EVP_DecryptInit_ex(_decrypt, EVP_aes_256_cbc(), nullptr, key_values,         nullptr) &&
+		EVP_EncryptInit_ex(_essiv,   EVP_aes_256_ecb(), nullptr, hash_of_key.values, nullptr);
+
+	/* clean up crypto relevant data which stays otherwise on stack */
+	cleanup_crypto_data(hash_of_key);
+
+	if (!ok) {
+		Genode::error("setting up key schedule");
+		EVP_CIPHER_CTX_free(_encrypt); _encrypt = nullptr;
+		EVP_CIPHER_CTX_free(_decrypt); _decrypt = nullptr;
+		EVP_CIPHER_CTX_free(_essiv);   _essiv   = nullptr;
+		return;
+	}
+
+	/* we always process whole blocks */
+	EVP_CIPHER_CTX_set_padding(_encrypt, 0);
+	EVP_CIPHER_CTX_set_padding(_decrypt, 0);
+	EVP_CIPHER_CTX_set_padding(_essiv,   0);
 }
 
-/**
- * Calculate initialization vector (IV) according to
- * "Encrypted salt-sector initialization vector" (ESSIV) algorithm
- * by Clemens Fruhwirth (July 18, 2005) published in
- * "New Methods in Hard Disk Encryption" paper.
- */
-static bool calculate_iv(Aes_cbc_4k::Key          const &key,
-                         Aes_cbc_4k::Block_number const &block,
-                         Aes_cbc::Iv                    &cipher_iv)
+Aes_cbc_4k::Key_schedule::~Key_schedule()
 {
-	Aes_cbc::Hash hash_of_key;
-	if (!hash_key(key, hash_of_key))
-		return false;
+	/* freeing the contexts wipes the expanded keys */
+	EVP_CIPHER_CTX_free(_encrypt);
+	EVP_CIPHER_CTX_free(_decrypt);
+	EVP_CIPHER_CTX_free(_essiv);
+}
+
+bool Aes_cbc_4k::Key_schedule::_iv(Block_number block, unsigned char (&iv)[16])
+{
+	Aes_cbc::Sn const plain { block };
+
+	static_assert(sizeof(plain.values) == sizeof(iv),
+	              "-plain- size vs -iv- size mismatch");
+
+	int len = 0;
+	return EVP_EncryptUpdate(_essiv, iv, &len, plain.values, (int)sizeof(plain.values))
+	    && len == (int)sizeof(iv);
+}
 
-	AES_KEY key_for_iv;
-	if (AES_set_encrypt_key(hash_of_key.values, sizeof(hash_of_key.values) * 8,
-	                        &key_for_iv)) {
-		/* clean up crypto relevant data which stays otherwise on stack */
-		cleanup_crypto_data(hash_of_key);
+bool Aes_cbc_4k::Key_schedule::encrypt(Block_number first, Plaintext const *plain,
+                                       Ciphertext *cipher, Genode::size_t num_blocks)
+{
+	static_assert(sizeof(plain->values)  == 4096, "Plain text size mismatch");
+	static_assert(sizeof(cipher->values) == 4096, "Cipher size mismatch");
+
+	if (!valid())
 		return false;
+
+	for (Genode::size_t i = 0; i < num_blocks; i++) {
+
+		Aes_cbc::Iv iv;
+		int len = 0;
+		bool const ok =
+			_iv({ first.value + i }, iv.values) &&
+			EVP_EncryptInit_ex(_encrypt, nullptr, nullptr, nullptr, iv.values) &&
+			EVP_EncryptUpdate(_encrypt,
+			                  reinterpret_cast<unsigned char *>(cipher[i].values), &len,
+			                  reinterpret_cast<unsigned char const *>(plain[i].values),
+			                  (int)sizeof(plain[i].values)) &&
+			len == (int)sizeof(cipher[i].values);
+
+		cleanup_crypto_data(iv);
+
+		if (!ok)
+			return false;
 	}
+	return true;
+}
 
-	Aes_cbc::Sn const plain  { block };
-	Aes_cbc::Iv       ivec   { };       /* zero IV */
+bool Aes_cbc_4k::Key_schedule::decrypt(Block_number first, Ciphertext const *cipher,
+                                       Plaintext *plain, Genode::size_t num_blocks)
+{
+	if (!valid())
+		return false;
 
-	static_assert(sizeof(plain.values) == sizeof(cipher_iv.values),
-	              "-plain- size vs -iv- size mismatch");
+	for (Genode::size_t i = 0; i < num_blocks; i++) {
 
-	AES_cbc_encrypt(plain.values, cipher_iv.values, sizeof(plain.values),
-	                &key_for_iv, ivec.values, AES_ENCRYPT);
+		Aes_cbc::Iv iv;
+		int len = 0;
+		bool const ok =
+			_iv({ first.value + i }, iv.values) &&
+			EVP_DecryptInit_ex(_decrypt, nullptr, nullptr, nullptr, iv.values) &&
+			EVP_DecryptUpdate(_decrypt,
+			                  reinterpret_cast<unsigned char *>(plain[i].values), &len,
+			                  reinterpret_cast<unsigned char const *>(cipher[i].values),
+			                  (int)sizeof(cipher[i].values)) &&
+			len == (int)sizeof(plain[i].values);
 
-	cleanup_crypto_data(hash_of_key, key_for_iv);
+		cleanup_crypto_data(iv);
 
+		if (!ok)
+			return false;
+	}
 	return true;
 }
 
+/**
+ * Key schedule of the key last used with the single-block functions
+ *
+ * Users of the single-block functions typically pass the same key for many
+ * blocks in a row. Caching its schedule avoids hashing and expanding the key
+ * and allocating the cipher contexts for each block.
+ */
+class Cached_key_schedule
+{
+	private:
+
+		Genode::Mutex                                   _mutex    { };
+		Aes_cbc_4k::Key                                 _key      { };
+		Genode::Constructible<Aes_cbc_4k::Key_schedule> _schedule { };
+
+	public:
+
+		~Cached_key_schedule() { cleanup_crypto_data(_key); }
+
+		/**
+		 * Call 'fn' with the key schedule of 'key'
+		 *
+		 * 
+eturn  false if the key schedule is invalid or 'fn' failed
+		 */
+		bool with_schedule(Aes_cbc_4k::Key const &key, auto const &fn)
+		{
+			Genode::Mutex::Guard guard { _mutex };
+
+			if (!_schedule.constructed()
+			 || Genode::memcmp(_key.values, key.values, sizeof(key.values))) {
+
+				_schedule.construct(key);
+				Genode::memcpy(_key.values, key.values, sizeof(key.values));
+			}
+			return _schedule->valid() && fn(*_schedule);
+		}
+};
+
+static Cached_key_schedule &cached_key_schedule()
+{
+	static Cached_key_schedule schedule { };
+	return schedule;
+}
+
 void Aes_cbc_4k::encrypt(Key const &key, Block_number const block_number,
                          Plaintext const &plain, Ciphertext &cipher)
 {
-	static_assert(sizeof(plain.values)  == 4096, "Plain text size mismatch");
-	static_assert(sizeof(cipher.values) == 4096, "Cipher size mismatch");
-	static_assert(sizeof(key.values)    ==   32, "Key size mismatch");
-
-	AES_KEY aes_key;
-	if (AES_set_encrypt_key(reinterpret_cast<unsigned char const *>(key.values),
-	                        sizeof(key.values) * 8, &aes_key)) {
-		Genode::error("setting encrypt key");
-		return;
-	}
+	bool const ok = cached_key_schedule().with_schedule(key, [&] (Key_schedule &ks) {
+		return ks.encrypt(block_number, &plain, &cipher); });
 
-	Aes_cbc::Iv iv;
-	if (!calculate_iv(key, block_number, iv)) {
-		Genode::error("iv calculation");
-		cleanup_crypto_data(aes_key);
-		return;
+	/* never leave stale data or a partially encrypted block behind */
+	if (!ok) {
+		Genode::error("encrypting block ", block_number.value);
+		cleanup_crypto_data(cipher);
 	}
-
-	AES_cbc_encrypt(reinterpret_cast<unsigned char const *>(plain.values),
-	                reinterpret_cast<unsigned char *>(cipher.values),
-	                sizeof(cipher.values), &aes_key, iv.values, AES_ENCRYPT);
-
-	/* clean up crypto relevant data which stays otherwise on stack */
-	cleanup_crypto_data(aes_key, iv);
 }
 
 void Aes_cbc_4k::decrypt(Key const &key, Block_number const block_number,
                          Ciphertext const &cipher, Plaintext &plain)
 {
-	AES_KEY aes_key;
-	if (AES_set_decrypt_key(reinterpret_cast<unsigned char const *>(key.values),
-	                        sizeof(key.values) * 8, &aes_key)) {
-		Genode::error("setting decrypt key");
-		return;
-	}
+	bool const ok = cached_key_schedule().with_schedule(key, [&] (Key_schedule &ks) {
+		return ks.decrypt(block_number, &cipher, &plain); });
 
-	Aes_cbc::Iv iv;
-	if (!calculate_iv(key, block_number, iv)) {
-		Genode::error("iv calculation");
-		cleanup_crypto_data(aes_key);
-		return;
+	/* never leave stale data or a partially decrypted block behind */
+	if (!ok) {
+		Genode::error("decrypting block ", block_number.value);
+		cleanup_crypto_data(plain);
 	}
-
-	AES_cbc_encrypt(reinterpret_cast<unsigned char const *>(cipher.values),
-	                reinterpret_cast<unsigned char *>(plain.values),
-	                sizeof(plain.values), &aes_key, iv.values, AES_DECRYPT);
-
-	cleanup_crypto_data(aes_key, iv);
 }
@@ -18,14 +18,24 @@
 using namespace Tresor;
 
 
-bool Block_io::Sync::execute(Vfs::Vfs_handle &file)
+bool Block_io::Sync::execute(Vfs::Vfs_handle &file, Write_cache &cache)
 {
 	bool progress = false;
 	switch (_helper.state) {
 	case INIT:
 
 		_file.construct(_helper.state, file);
-		_helper.state = SYNC;
+		_entry = cache.any_valid();
+		_helper.state = _entry ? WRITE : SYNC;
+		progress = true;
+		break;
+
+	case WRITE: _file->write(WRITE_OK, FILE_ERR, _entry->pba * BLOCK_SIZE, { (char *)&_entry->block, BLOCK_SIZE }, progress); break;
+	case WRITE_OK:
+
+		_entry->valid = false;
+		_entry = cache.any_valid();
+		_helper.state = _entry ? WRITE : SYNC;
 		progress = true;
 		break;
 
@@ -38,12 +48,53 @@ bool Block_io::Sync::execute(Vfs::Vfs_handle &file)
 }
 
 
-bool Block_io::Read::execute(Vfs::Vfs_handle &file)
+bool Block_io::Flush::execute(Vfs::Vfs_handle &file, Write_cache &cache)
 {
 	bool progress = false;
 	switch (_helper.state) {
 	case INIT:
 
+		_file.construct(_helper.state, file);
+		_entry = cache.any_valid();
+		if (_entry) {
+			_helper.state = WRITE;
+			progress = true;
+		} else
+			_helper.mark_succeeded(progress);
+		break;
+
+	case WRITE: _file->write(WRITE_OK, FILE_ERR, _entry->pba * BLOCK_SIZE, { (char *)&_entry->block, BLOCK_SIZE }, progress); break;
+	case WRITE_OK:
+
+		_entry->valid = false;
+		_entry = cache.any_valid();
+		if (_entry) {
+			_helper.state = WRITE;
+			progress = true;
+		} else
+			_helper.mark_succeeded(progress);
+		break;
+
+	case FILE_ERR: _helper.mark_failed(progress, "file operation failed"); break;
+	default: break;
+	}
+	return progress;
+}
+
+
+bool Block_io::Read::execute(Vfs::Vfs_handle &file, Write_cache &cache)
+{
+	bool progress = false;
+	switch (_helper.state) {
+	case INIT:
+
+		if (Write_cache::Entry const *entry = cache.lookup(_attr.in_pba)) {
+			_attr.out_block = entry->block;
+			_helper.mark_succeeded(progress);
+			if (VERBOSE_BLOCK_IO && (!VERBOSE_BLOCK_IO_PBA_FILTER || VERBOSE_BLOCK_IO_PBA == _attr.in_pba))
+				log("block_io: ", *this, " (cached) hash ", hash(_attr.out_block));
+			break;
+		}
 		_file.construct(_helper.state, file);
 		_helper.state = READ;
 		progress = true;
@@ -64,12 +115,13 @@ bool Block_io::Read::execute(Vfs::Vfs_handle &file)
 }
 
 
-bool Block_io::Write::execute(Vfs::Vfs_handle &file)
+bool Block_io::Write::execute(Vfs::Vfs_handle &file, Write_cache &cache)
 {
 	bool progress = false;
 	switch (_helper.state) {
 	case INIT:
 
+		cache.drop(_attr.in_pba);
 		_file.construct(_helper.state, file);
 		_helper.state = WRITE;
 		progress = true;
@@ -88,3 +140,41 @@ bool Block_io::Write::execute(Vfs::Vfs_handle &file)
 	}
 	return progress;
 }
+
+
+bool Block_io::Write_node::execute(Vfs::Vfs_handle &file, Write_cache &cache)
+{
+	bool progress = false;
+	switch (_helper.state) {
+	case INIT:
+
+		_entry = cache.lookup(_attr.in_pba);
+		if (!_entry) {
+			_entry = &cache.victim();
+			if (_entry->valid) {
+
+				/* write back least recently written node to make room */
+				_file.construct(_helper.state, file);
+				_helper.state = EVICT;
+				progress = true;
+				break;
+			}
+		}
+		_helper.state = EVICT_OK;
+		progress = true;
+		break;
+
+	case EVICT: _file->write(EVICT_OK, FILE_ERR, _entry->pba * BLOCK_SIZE, { (char *)&_entry->block, BLOCK_SIZE }, progress); break;
+	case EVICT_OK:
+
+		cache.store(*_entry, _attr.in_pba, _attr.in_block);
+		_helper.mark_succeeded(progress);
+		if (VERBOSE_BLOCK_IO && (!VERBOSE_BLOCK_IO_PBA_FILTER || VERBOSE_BLOCK_IO_PBA == _attr.in_pba))
+			log("block_io: ", *this, " hash ", hash(_attr.in_block));
+		break;
+
+	case FILE_ERR: _helper.mark_failed(progress, "file operation failed"); break;
+	default: break;
+	}
+	return progress;
+}
@@ -28,10 +28,15 @@ bool Tresor::check_hash(Block const &blk, Hash const &expected_hash)
 
 void Tresor::calc_hash(Block const &blk, Hash &hash)
 {
-	SHA256_CTX context { };
-	ASSERT(SHA256_Init(&context));
-	ASSERT(SHA256_Update(&context, &blk, BLOCK_SIZE));
-	ASSERT(SHA256_Final((unsigned char *)(&hash), &context));
+	calc_hash_of_each(&blk, &hash, 1);
+}
+
+
+void Tresor::calc_hash_of_each(Block const *blks, Hash *hashes, Genode::size_t num)
+{
+	static_assert(sizeof(Hash) == SHA256_DIGEST_LENGTH, "hash size mismatch");
+	for (Genode::size_t i = 0; i < num; i++)
+		ASSERT(SHA256((unsigned char const *)&blks[i], BLOCK_SIZE, (unsigned char *)&hashes[i]));
 }
 
 
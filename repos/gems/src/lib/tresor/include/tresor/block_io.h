@@ -22,17 +22,99 @@ namespace Tresor { class Block_io; }
 
 class Tresor::Block_io : Noncopyable
 {
+	public:
+
+		/*
+		 * Write-back cache for tree nodes
+		 *
+		 * Inner nodes of the trees are re-written on each update of a branch. As
+		 * long as a node keeps its PBA, i.e., until the generation it belongs to is
+		 * secured, these writes are combined in the cache and written back only on
+		 * 'Flush' or 'Sync', or when the least recently written entry is evicted.
+		 * All entries are dirty. Reads are served from the cache, plain writes
+		 * invalidate the cached entry of their PBA.
+		 */
+		class Write_cache : Noncopyable
+		{
+			public:
+
+				static constexpr unsigned NUM_ENTRIES = 64;
+
+				struct Entry
+				{
+					Physical_block_address pba { INVALID_PBA };
+					Block block { };
+					uint64_t last_write { 0 };
+					bool valid { false };
+				};
+
+			private:
+
+				Entry _entries[NUM_ENTRIES] { };
+				uint64_t _num_writes { 0 };
+
+			public:
+
+				Entry *lookup(Physical_block_address pba)
+				{
+					for (Entry &entry : _entries)
+						if (entry.valid && entry.pba == pba)
+							return &entry;
+
+					return nullptr;
+				}
+
+				/**
+				 * Return invalid entry or, if all are in use, the least recently written one
+				 */
+				Entry &victim()
+				{
+					Entry *result = &_entries[0];
+					for (Entry &entry : _entries) {
+						if (!entry.valid)
+							return entry;
+
+						if (entry.last_write < result->last_write)
+							result = &entry;
+					}
+					return *result;
+				}
+
+				Entry *any_valid()
+				{
+					for (Entry &entry : _entries)
+						if (entry.valid)
+							return &entry;
+
+					return nullptr;
+				}
+
+				void store(Entry &entry, Physical_block_address pba, Block const &block)
+				{
+					entry = { pba, block, ++_num_writes, true };
+				}
+
+				void drop(Physical_block_address pba)
+				{
+					if (Entry *entry = lookup(pba))
+						entry->valid = false;
+				}
+		};
+
+		class Read;
+		class Write;
+		class Write_node;
+		class Flush;
+		class Sync;
+
 	private:
 
 		Vfs::Vfs_handle &_file;
 		addr_t _user { };
+		Write_cache _write_cache { };
 
 	public:
 
-		class Read;
-		class Write;
-		class Sync;
-
 		Block_io(Vfs::Vfs_handle &file) : _file(file) { }
 
 		template <typename REQ>
@@ -44,7 +126,7 @@ class Tresor::Block_io : Noncopyable
 			if (_user != (addr_t)&req)
 				return false;
 
-			bool progress = req.execute(_file);
+			bool progress = req.execute(_file, _write_cache);
 			if (req.complete())
 				_user = 0;
 
@@ -80,7 +162,7 @@ class Tresor::Block_io::Read : Noncopyable
 
 		void print(Output &out) const { Genode::print(out, "read pba ", _attr.in_pba); }
 
-		bool execute(Vfs::Vfs_handle &);
+		bool execute(Vfs::Vfs_handle &, Write_cache &);
 
 		bool complete() const { return _helper.complete(); }
 		bool success() const { return _helper.success(); }
@@ -112,12 +194,95 @@ class Tresor::Block_io::Write : Noncopyable
 
 		void print(Output &out) const { Genode::print(out, "write pba ", _attr.in_pba); }
 
-		bool execute(Vfs::Vfs_handle &);
+		bool execute(Vfs::Vfs_handle &, Write_cache &);
 
 		bool complete() const { return _helper.complete(); }
 		bool success() const { return _helper.success(); }
 };
 
+/*
+ * Write of a tree node that may be combined with later writes to the same PBA
+ */
+class Tresor::Block_io::Write_node : Noncopyable
+{
+	public:
+
+		using Module = Block_io;
+
+		struct Attr
+		{
+			Physical_block_address const in_pba;
+			Block const &in_block;
+		};
+
+	private:
+
+		enum State { INIT, COMPLETE, EVICT, EVICT_OK, FILE_ERR };
+
+		Request_helper<Write_node, State> _helper;
+		Attr const _attr;
+		Write_cache::Entry *_entry { };
+		Constructible<File<State> > _file { };
+
+		/*
+		 * Noncopyable
+		 */
+		Write_node(Write_node const &) = delete;
+		Write_node &operator = (Write_node const &) = delete;
+
+	public:
+
+		Write_node(Attr const &attr) : _helper(*this), _attr(attr) { }
+
+		void print(Output &out) const { Genode::print(out, "write node pba ", _attr.in_pba); }
+
+		bool execute(Vfs::Vfs_handle &, Write_cache &);
+
+		bool complete() const { return _helper.complete(); }
+		bool success() const { return _helper.success(); }
+};
+
+/*
+ * Write back all nodes of the write cache
+ */
+class Tresor::Block_io::Flush : Noncopyable
+{
+	public:
+
+		using Module = Block_io;
+
+		struct Attr { };
+
+	private:
+
+		enum State { INIT, COMPLETE, WRITE, WRITE_OK, FILE_ERR };
+
+		Request_helper<Flush, State> _helper;
+		Attr const _attr;
+		Write_cache::Entry *_entry { };
+		Constructible<File<State> > _file { };
+
+		/*
+		 * Noncopyable
+		 */
+		Flush(Flush const &) = delete;
+		Flush &operator = (Flush const &) = delete;
+
+	public:
+
+		Flush(Attr const &attr) : _helper(*this), _attr(attr) { }
+
+		void print(Output &out) const { Genode::print(out, "flush"); }
+
+		bool execute(Vfs::Vfs_handle &, Write_cache &);
+
+		bool complete() const { return _helper.complete(); }
+		bool success() const { return _helper.success(); }
+};
+
+/*
+ * Write back all nodes of the write cache and sync the back end
+ */
 class Tresor::Block_io::Sync : Noncopyable
 {
 	public:
@@ -128,19 +293,26 @@ class Tresor::Block_io::Sync : Noncopyable
 
 	private:
 
-		enum State { INIT, COMPLETE, SYNC, SYNC_OK, FILE_ERR };
+		enum State { INIT, COMPLETE, WRITE, WRITE_OK, SYNC, SYNC_OK, FILE_ERR };
 
 		Request_helper<Sync, State> _helper;
 		Attr const _attr;
+		Write_cache::Entry *_entry { };
 		Constructible<File<State> > _file { };
 
+		/*
+		 * Noncopyable
+		 */
+		Sync(Sync const &) = delete;
+		Sync &operator = (Sync const &) = delete;
+
 	public:
 
 		Sync(Attr const &attr) : _helper(*this), _attr(attr) { }
 
 		void print(Output &out) const { Genode::print(out, "sync"); }
 
-		bool execute(Vfs::Vfs_handle &);
+		bool execute(Vfs::Vfs_handle &, Write_cache &);
 
 		bool complete() const { return _helper.complete(); }
 		bool success() const { return _helper.success(); }
@@ -87,7 +87,7 @@ class Tresor::Free_tree::Allocate_pbas : Noncopyable
 		Tree_degree_log_2 _vbd_degree_log_2 { 0 };
 		Tree_level_index _lvl { 0 };
 		Generatable_request<Helper, State, Block_io::Read> _read_block { };
-		Generatable_request<Helper, State, Block_io::Write> _write_block { };
+		Generatable_request<Helper, State, Block_io::Write_node> _write_block { };
 		Generatable_request<Helper, State, Meta_tree::Allocate_pba> _allocate_pba { };
 
 		void _alloc_pba_of(Type_2_node &);
@@ -149,7 +149,7 @@ class Tresor::Free_tree::Extend_tree : Noncopyable
 		Tree_level_index _alloc_lvl { 0 };
 		Physical_block_address _alloc_pba { 0 };
 		Generatable_request<Helper, State, Block_io::Read> _read_block { };
-		Generatable_request<Helper, State, Block_io::Write> _write_block { };
+		Generatable_request<Helper, State, Block_io::Write_node> _write_block { };
 		Generatable_request<Helper, State, Meta_tree::Allocate_pba> _allocate_pba { };
 
 		bool _check_and_decode_read_blk(bool &);
@@ -14,6 +14,9 @@
 #ifndef _TRESOR__HASH_H_
 #define _TRESOR__HASH_H_
 
+/* base includes */
+#include <base/stdint.h>
+
 namespace Tresor {
 
 	class Block;
@@ -21,6 +24,14 @@ namespace Tresor {
 
 	void calc_hash(Block const &, Hash &);
 
+	/**
+	 * Calculate the hash of each of 'num' blocks
+	 *
+	 * The blocks are hashed one after another, each with one call of
+	 * 'SHA256()'.
+	 */
+	void calc_hash_of_each(Block const *, Hash *, Genode::size_t num);
+
 	bool check_hash(Block const &, Hash const &);
 
 	Hash hash(Block const &);
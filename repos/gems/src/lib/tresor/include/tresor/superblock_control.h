@@ -46,9 +46,9 @@ class Tresor::Superblock_control : Noncopyable
 			private:
 
 				enum State {
-					INIT, COMPLETE, WRITE_BLOCK, WRITE_BLOCK_SUCCEEDED, SYNC_BLOCK_IO, SYNC_BLOCK_IO_SUCCEEDED,
-					ENCRYPT_KEY, ENCRYPT_CURR_KEY_SUCCEEDED, ENCRYPT_PREV_KEY_SUCCEEDED, WRITE_SB_HASH,
-					WRITE_SB_HASH_SUCCEEDED };
+					INIT, COMPLETE, FLUSH_BLOCK_IO, FLUSH_BLOCK_IO_SUCCEEDED, WRITE_BLOCK, WRITE_BLOCK_SUCCEEDED,
+					SYNC_BLOCK_IO, SYNC_BLOCK_IO_SUCCEEDED, ENCRYPT_KEY, ENCRYPT_CURR_KEY_SUCCEEDED,
+					ENCRYPT_PREV_KEY_SUCCEEDED, WRITE_SB_HASH, WRITE_SB_HASH_SUCCEEDED };
 
 				using Helper = Request_helper<Secure_superblock, State>;
 
@@ -58,6 +58,7 @@ class Tresor::Superblock_control : Noncopyable
 				Block _blk { };
 				Hash _hash { };
 				Generation _gen { };
+				Generatable_request<Helper, State, Block_io::Flush> _flush_block_io { };
 				Generatable_request<Helper, State, Block_io::Write> _write_block { };
 				Generatable_request<Helper, State, Block_io::Sync> _sync_block_io { };
 				Generatable_request<Helper, State, Trust_anchor::Encrypt_key> _encrypt_key { };
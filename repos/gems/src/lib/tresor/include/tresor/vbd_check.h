@@ -42,8 +42,20 @@ struct Tresor::Vbd_check : Noncopyable
 			Number_of_leaves _num_remaining_leaves { 0 };
 			Generatable_request<Request_helper<Check, State>, State, Block_io::Read> _read_block { };
 
+			/*
+			 * Leaves are read in a row and then hashed one after another
+			 */
+			enum { MAX_NUM_READ_LEAVES = 16 };
+
+			Block _leaf_blks[MAX_NUM_READ_LEAVES] { };
+			Hash _leaf_hashes[MAX_NUM_READ_LEAVES] { };
+			Tree_node_index _leaf_node_idx[MAX_NUM_READ_LEAVES] { };
+			unsigned _num_read_leaves { 0 };
+
 			bool _execute_node(Block_io &, Tree_level_index, Tree_node_index, bool &);
 
+			bool _check_leaf_hashes(bool &);
+
 		public:
 
 			Check(Attr const &attr) : _helper(*this), _attr(attr) { }
@@ -32,9 +32,32 @@ class Tresor::Virtual_block_device : Noncopyable
 		class Write_vba;
 		class Extend_tree;
 
+	private:
+
+		/*
+		 * Inner-node blocks of the branch of the last read VBA
+		 *
+		 * A node block is identified by its PBA and by the hash that its
+		 * already verified parent holds for it. Reading consecutive VBAs
+		 * thereby reads and hashes each inner node block only once.
+		 */
+		struct Verified_node_block
+		{
+			Physical_block_address pba { INVALID_PBA };
+			Hash hash { };
+			Type_1_node_block blk { };
+			bool valid { false };
+		};
+
+		Verified_node_block _verified_node_blks[TREE_MAX_NR_OF_LEVELS] { };
+
+	public:
+
 		template <typename REQUEST, typename... ARGS>
 		bool execute(REQUEST &req, ARGS &&... args) { return req.execute(args...); }
 
+		bool execute(Read_vba &, Client_data_interface &, Block_io &, Crypto &);
+
 		static constexpr char const *name() { return "vbd"; }
 };
 
@@ -61,7 +84,7 @@ class Tresor::Virtual_block_device::Rekey_vba : Noncopyable
 	private:
 
 		enum State {
-			INIT, COMPLETE, READ_BLK, READ_BLK_SUCCEEDED, WRITE_BLK, WRITE_BLK_SUCCEEDED,
+			INIT, COMPLETE, READ_BLK, READ_BLK_SUCCEEDED, WRITE_BLK, WRITE_NODE, WRITE_BLK_SUCCEEDED,
 			DECRYPT_BLOCK, DECRYPT_BLOCK_SUCCEEDED, ENCRYPT_BLOCK, ENCRYPT_BLOCK_SUCCEEDED,
 			ALLOC_PBAS, ALLOC_PBAS_SUCCEEDED };
 
@@ -83,6 +106,7 @@ class Tresor::Virtual_block_device::Rekey_vba : Noncopyable
 		bool _first_snapshot { false };
 		Generatable_request<Helper, State, Block_io::Read> _read_block { };
 		Generatable_request<Helper, State, Block_io::Write> _write_block { };
+		Generatable_request<Helper, State, Block_io::Write_node> _write_node { };
 		Generatable_request<Helper, State, Crypto::Encrypt> _encrypt_block { };
 		Generatable_request<Helper, State, Crypto::Decrypt> _decrypt_block { };
 		Generatable_request<Helper, State, Free_tree::Allocate_pbas> _alloc_pbas { };
@@ -129,7 +153,8 @@ class Tresor::Virtual_block_device::Read_vba : Noncopyable
 
 	private:
 
-		enum State { INIT, COMPLETE, READ_BLK, READ_BLK_SUCCEEDED, DECRYPT_BLOCK, DECRYPT_BLOCK_SUCCEEDED };
+		enum State {
+			INIT, COMPLETE, READ_BLK, READ_BLK_SUCCEEDED, NODE_VERIFIED, DECRYPT_BLOCK, DECRYPT_BLOCK_SUCCEEDED };
 
 		using Helper = Request_helper<Read_vba, State>;
 
@@ -145,6 +170,12 @@ class Tresor::Virtual_block_device::Read_vba : Noncopyable
 
 		bool _check_and_decode_read_blk(bool &);
 
+		Hash const &_expected_hash();
+
+		void _read_node(Virtual_block_device &, Physical_block_address, bool &);
+
+		void _descend(Virtual_block_device &, bool &);
+
 	public:
 
 		Read_vba(Attr const &attr) : _helper(*this), _attr(attr) { }
@@ -153,7 +184,7 @@ class Tresor::Virtual_block_device::Read_vba : Noncopyable
 
 		void print(Output &out) const { Genode::print(out, "read vba"); }
 
-		bool execute(Client_data_interface &, Block_io &, Crypto &);
+		bool execute(Virtual_block_device &, Client_data_interface &, Block_io &, Crypto &);
 
 		bool complete() const { return _helper.complete(); }
 		bool success() const { return _helper.success(); }
@@ -188,7 +219,7 @@ class Tresor::Virtual_block_device::Write_vba : Noncopyable
 
 		enum State {
 			INIT, COMPLETE, READ_BLK, READ_BLK_SUCCEEDED, DECRYPT_BLOCK, DECRYPT_BLOCK_SUCCEEDED,
-			WRITE_BLK, WRITE_BLK_SUCCEEDED, ENCRYPT_BLOCK, ENCRYPT_BLOCK_SUCCEEDED, ALLOC_PBAS, ALLOC_PBAS_SUCCEEDED };
+			WRITE_BLK, WRITE_NODE, WRITE_BLK_SUCCEEDED, ENCRYPT_BLOCK, ENCRYPT_BLOCK_SUCCEEDED, ALLOC_PBAS, ALLOC_PBAS_SUCCEEDED };
 
 		using Helper = Request_helper<Write_vba, State>;
 
@@ -208,6 +239,7 @@ class Tresor::Virtual_block_device::Write_vba : Noncopyable
 		Generatable_request<Helper, State, Crypto::Encrypt> _encrypt_block { };
 		Generatable_request<Helper, State, Free_tree::Allocate_pbas> _alloc_pbas { };
 		Generatable_request<Helper, State, Block_io::Write> _write_block { };
+		Generatable_request<Helper, State, Block_io::Write_node> _write_node { };
 
 		bool _check_and_decode_read_blk(bool &);
 
@@ -261,7 +293,7 @@ class Tresor::Virtual_block_device::Extend_tree : Noncopyable
 	private:
 
 		enum State {
-			INIT, COMPLETE, READ_BLK, READ_BLK_SUCCEEDED, WRITE_BLK, WRITE_BLK_SUCCEEDED, ALLOC_PBAS, ALLOC_PBAS_SUCCEEDED };
+			INIT, COMPLETE, READ_BLK, READ_BLK_SUCCEEDED, WRITE_BLK, WRITE_NODE, WRITE_BLK_SUCCEEDED, ALLOC_PBAS, ALLOC_PBAS_SUCCEEDED };
 
 		using Helper = Request_helper<Extend_tree, State>;
 
@@ -280,6 +312,7 @@ class Tresor::Virtual_block_device::Extend_tree : Noncopyable
 		Generation _free_gen { 0 };
 		Generatable_request<Helper, State, Block_io::Read> _read_block { };
 		Generatable_request<Helper, State, Block_io::Write> _write_block { };
+		Generatable_request<Helper, State, Block_io::Write_node> _write_node { };
 		Generatable_request<Helper, State, Free_tree::Allocate_pbas> _alloc_pbas { };
 
 		bool _add_new_root_lvl_to_snap();
@@ -393,6 +393,13 @@ bool Superblock_control::Secure_superblock::execute(Execute_attr const &attr)
 	switch (_helper.state) {
 	case INIT:
 
+		/* write back the combined node writes of this generation before the superblock */
+		_flush_block_io.generate(_helper, FLUSH_BLOCK_IO, FLUSH_BLOCK_IO_SUCCEEDED, progress);
+		break;
+
+	case FLUSH_BLOCK_IO: progress |= _flush_block_io.execute(attr.block_io); break;
+	case FLUSH_BLOCK_IO_SUCCEEDED:
+
 		attr.sb.curr_snap().gen = attr.curr_gen;
 		attr.sb.discard_disposable_snapshots();
 		_sb_ciphertext.copy_all_but_key_values_from(attr.sb);
@@ -17,6 +17,24 @@
 
 using namespace Tresor;
 
+bool Vbd_check::Check::_check_leaf_hashes(bool &progress)
+{
+	calc_hash_of_each(_leaf_blks, _leaf_hashes, _num_read_leaves);
+	for (unsigned idx { 0 }; idx < _num_read_leaves; idx++) {
+		Tree_node_index const node_idx { _leaf_node_idx[idx] };
+		Type_1_node const &node = _t1_blks.items[1].nodes[node_idx];
+		if (_leaf_hashes[idx] != node.hash) {
+			_helper.mark_failed(progress, { "lvl 1 node ", node_idx, " (", node, ") has bad hash" });
+			return false;
+		}
+		if (VERBOSE_CHECK)
+			log(Level_indent { 1, _attr.in_vbd.max_lvl }, "    lvl 1 node ", node_idx, ": good hash");
+	}
+	_num_read_leaves = 0;
+	return true;
+}
+
+
 bool Vbd_check::Check::_execute_node(Block_io &block_io, Tree_level_index lvl, Tree_node_index node_idx, bool &progress)
 {
 	bool &check_node = _check_node[lvl][node_idx];
@@ -48,6 +66,14 @@ bool Vbd_check::Check::_execute_node(Block_io &block_io, Tree_level_index lvl, T
 					log(Level_indent { lvl, _attr.in_vbd.max_lvl }, "    lvl ", lvl, " node ", node_idx, ": uninitialized");
 				break;
 			}
+			if (_num_read_leaves == MAX_NUM_READ_LEAVES && !_check_leaf_hashes(progress))
+				break;
+
+			_read_block.generate(_helper, READ_BLK, READ_BLK_SUCCEEDED, progress, node.pba, _leaf_blks[_num_read_leaves]);
+			if (VERBOSE_CHECK)
+				log(Level_indent { lvl, _attr.in_vbd.max_lvl }, "    lvl ", lvl, " node ", node_idx, " (", node,
+				    "): load leaf");
+			break;
 		} else {
 			if (!node.valid()) {
 				if (_num_remaining_leaves) {
@@ -71,17 +97,24 @@ bool Vbd_check::Check::_execute_node(Block_io &block_io, Tree_level_index lvl, T
 	case READ_BLK: progress |= _read_block.execute(block_io); break;
 	case READ_BLK_SUCCEEDED:
 
-		if (!(lvl > 1 && node.gen == INITIAL_GENERATION) && !check_hash(_blk, node.hash)) {
-			_helper.mark_failed(progress, { "lvl ", lvl, " node ", node_idx, " (", node, ") has bad hash" });
+		if (lvl == 1) {
+
+			/* the hash is checked together with those of the following leaves */
+			_leaf_node_idx[_num_read_leaves++] = node_idx;
+			_num_remaining_leaves--;
+			check_node = false;
+			_helper.state = IN_PROGRESS;
+			progress = true;
 			break;
 		}
-		if (lvl == 1)
-			_num_remaining_leaves--;
-		else {
-			_t1_blks.items[lvl - 1].decode_from_blk(_blk);
-			for (bool &cn : _check_node[lvl - 1])
-				cn = true;
+		if (node.gen != INITIAL_GENERATION && !check_hash(_blk, node.hash)) {
+			_helper.mark_failed(progress, { "lvl ", lvl, " node ", node_idx, " (", node, ") has bad hash" });
+			break;
 		}
+		_t1_blks.items[lvl - 1].decode_from_blk(_blk);
+		for (bool &cn : _check_node[lvl - 1])
+			cn = true;
+
 		check_node = false;
 		_helper.state = IN_PROGRESS;
 		progress = true;
@@ -104,15 +137,20 @@ bool Vbd_check::Check::execute(Block_io &block_io)
 				_check_node[lvl][node_idx] = false;
 
 		_num_remaining_leaves = _attr.in_vbd.num_leaves;
+		_num_read_leaves = 0;
 		_t1_blks.items[_attr.in_vbd.max_lvl + 1].nodes[0] = _attr.in_vbd.t1_node();
 		_check_node[_attr.in_vbd.max_lvl + 1][0] = true;
 		_helper.state = IN_PROGRESS;
 	}
-	for (Tree_level_index lvl { 1 }; lvl <= _attr.in_vbd.max_lvl + 1; lvl++)
+	for (Tree_level_index lvl { 1 }; lvl <= _attr.in_vbd.max_lvl + 1; lvl++) {
 		for (Tree_node_index node_idx { 0 }; node_idx < _attr.in_vbd.degree; node_idx++)
 			if (_execute_node(block_io, lvl, node_idx, progress))
 				return progress;
 
+		/* check remaining leaves before the parent level-1 node gets replaced */
+		if (lvl == 1 && _num_read_leaves && !_check_leaf_hashes(progress))
+			return progress;
+	}
 	_helper.mark_succeeded(progress);
 	return progress;
 }
@@ -44,21 +44,72 @@ bool Virtual_block_device::Read_vba::_check_and_decode_read_blk(bool &progress)
 }
 
 
-bool Virtual_block_device::Read_vba::execute(Client_data_interface &client_data, Block_io &block_io, Crypto &crypto)
+Hash const &Virtual_block_device::Read_vba::_expected_hash()
+{
+	if (_lvl < _attr.in_snap.max_level)
+		return _t1_blks.node(_attr.in_vba, _lvl + 1, _attr.in_vbd_degree).hash;
+
+	return _attr.in_snap.hash;
+}
+
+
+void Virtual_block_device::Read_vba::_read_node(Virtual_block_device &vbd, Physical_block_address pba, bool &progress)
+{
+	_new_pbas.pbas[_lvl] = pba;
+	Verified_node_block const &verified { vbd._verified_node_blks[_lvl] };
+	if (verified.valid && verified.pba == pba && verified.hash == _expected_hash()) {
+		_t1_blks.items[_lvl] = verified.blk;
+		_helper.state = NODE_VERIFIED;
+		progress = true;
+		return;
+	}
+	_read_block.generate(_helper, READ_BLK, READ_BLK_SUCCEEDED, progress, pba, _blk);
+}
+
+
+void Virtual_block_device::Read_vba::_descend(Virtual_block_device &vbd, bool &progress)
+{
+	Type_1_node &node { _t1_blks.node(_attr.in_vba, _lvl, _attr.in_vbd_degree) };
+	if (VERBOSE_READ_VBA)
+		log("    ", Branch_lvl_prefix("lvl ", _lvl, " node ", tree_node_index(_attr.in_vba, _lvl, _attr.in_vbd_degree), ": "), node);
+
+	_lvl--;
+	if (_lvl)
+		_read_node(vbd, node.pba, progress);
+	else {
+		_new_pbas.pbas[_lvl] = node.pba;
+		if (node.gen == INITIAL_GENERATION) {
+			memset(&_blk, 0, BLOCK_SIZE);
+			_helper.state = DECRYPT_BLOCK_SUCCEEDED;
+			progress = true;
+		} else
+			_read_block.generate(_helper, READ_BLK, READ_BLK_SUCCEEDED, progress, _new_pbas.pbas[_lvl], _blk);
+	}
+}
+
+
+bool Virtual_block_device::execute(Read_vba &req, Client_data_interface &client_data, Block_io &block_io, Crypto &crypto)
+{
+	return req.execute(*this, client_data, block_io, crypto);
+}
+
+
+bool Virtual_block_device::Read_vba::execute(Virtual_block_device &vbd, Client_data_interface &client_data,
+                                             Block_io &block_io, Crypto &crypto)
 {
 	bool progress = false;
 	switch (_helper.state) {
 	case INIT:
 
 		_lvl = _attr.in_snap.max_level;
-		_read_block.generate(_helper, READ_BLK, READ_BLK_SUCCEEDED, progress, _attr.in_snap.pba, _blk);
+		_read_node(vbd, _attr.in_snap.pba, progress);
 		if (VERBOSE_READ_VBA)
 			log("  load branch:\n    ", Branch_lvl_prefix("root: "), _attr.in_snap);
 		break;
 
 	case READ_BLK: progress |= _read_block.execute(block_io); break;
 	case READ_BLK_SUCCEEDED:
-	{
+
 		if (!_check_and_decode_read_blk(progress))
 			break;
 
@@ -70,23 +121,11 @@ bool Virtual_block_device::Read_vba::execute(Client_data_interface &client_data,
 				_helper, DECRYPT_BLOCK, DECRYPT_BLOCK_SUCCEEDED, progress, _attr.in_key_id, _new_pbas.pbas[_lvl], _blk);
 			break;
 		}
-		Type_1_node &node { _t1_blks.node(_attr.in_vba, _lvl, _attr.in_vbd_degree) };
-		if (VERBOSE_READ_VBA)
-			log("    ", Branch_lvl_prefix("lvl ", _lvl, " node ", tree_node_index(_attr.in_vba, _lvl, _attr.in_vbd_degree), ": "), node);
-
-		_lvl--;
-		_new_pbas.pbas[_lvl] = node.pba;
-		if (_lvl)
-			_read_block.generate(_helper, READ_BLK, READ_BLK_SUCCEEDED, progress, _new_pbas.pbas[_lvl], _blk);
-		else
-			if (node.gen == INITIAL_GENERATION) {
-				memset(&_blk, 0, BLOCK_SIZE);
-				_helper.state = DECRYPT_BLOCK_SUCCEEDED;
-				progress = true;
-			} else
-				_read_block.generate(_helper, READ_BLK, READ_BLK_SUCCEEDED, progress, _new_pbas.pbas[_lvl], _blk);
+		vbd._verified_node_blks[_lvl] = { _new_pbas.pbas[_lvl], _hash, _t1_blks.items[_lvl], true };
+		_descend(vbd, progress);
 		break;
-	}
+
+	case NODE_VERIFIED: _descend(vbd, progress); break;
 	case DECRYPT_BLOCK: progress |= _decrypt_block.execute(crypto); break;
 	case DECRYPT_BLOCK_SUCCEEDED:
 
@@ -119,7 +158,7 @@ void Virtual_block_device::Rekey_vba::_generate_write_blk_req(bool &progress)
 {
 	if (_lvl) {
 		_t1_blks.items[_lvl].encode_to_blk(_encoded_blk);
-		_write_block.generate(_helper, WRITE_BLK, WRITE_BLK_SUCCEEDED, progress, _new_pbas.pbas[_lvl], _encoded_blk);
+		_write_node.generate(_helper, WRITE_NODE, WRITE_BLK_SUCCEEDED, progress, _new_pbas.pbas[_lvl], _encoded_blk);
 	} else
 		_write_block.generate(_helper, WRITE_BLK, WRITE_BLK_SUCCEEDED, progress, _new_pbas.pbas[_lvl], _data_blk);
 }
@@ -275,6 +314,7 @@ bool Virtual_block_device::Rekey_vba::execute(Block_io &block_io, Crypto &crypto
 		break;
 
 	case WRITE_BLK: progress |= _write_block.execute(block_io); break;
+	case WRITE_NODE: progress |= _write_node.execute(block_io); break;
 	case WRITE_BLK_SUCCEEDED:
 	{
 		Snapshot &snap = _attr.in_out_snapshots.items[_snap_idx];
@@ -477,6 +517,7 @@ bool Virtual_block_device::Write_vba::execute(Client_data_interface &client_data
 		break;
 
 	case WRITE_BLK: progress |= _write_block.execute(block_io); break;
+	case WRITE_NODE: progress |= _write_node.execute(block_io); break;
 	case WRITE_BLK_SUCCEEDED:
 
 		if (!_lvl)
@@ -518,7 +559,7 @@ void Virtual_block_device::Write_vba::_generate_write_blk_req(bool &progress)
 {
 	if (_lvl) {
 		_t1_blks.items[_lvl].encode_to_blk(_encoded_blk);
-		_write_block.generate(_helper, WRITE_BLK, WRITE_BLK_SUCCEEDED, progress, _new_pbas.pbas[_lvl], _encoded_blk);
+		_write_node.generate(_helper, WRITE_NODE, WRITE_BLK_SUCCEEDED, progress, _new_pbas.pbas[_lvl], _encoded_blk);
 	} else
 		_write_block.generate(_helper, WRITE_BLK, WRITE_BLK_SUCCEEDED, progress, _new_pbas.pbas[_lvl], _data_blk);
 }
@@ -603,6 +644,7 @@ bool Virtual_block_device::Extend_tree::execute(Block_io &block_io, Free_tree &f
 		break;
 	}
 	case WRITE_BLK: progress |= _write_block.execute(block_io); break;
+	case WRITE_NODE: progress |= _write_node.execute(block_io); break;
 	case WRITE_BLK_SUCCEEDED:
 	{
 		Snapshot &snap = _attr.in_out_snapshots.items[_snap_idx];
@@ -721,7 +763,7 @@ void Virtual_block_device::Extend_tree::_generate_write_blk_req(bool &progress)
 {
 	if (_lvl) {
 		_t1_blks.items[_lvl].encode_to_blk(_encoded_blk);
-		_write_block.generate(_helper, WRITE_BLK, WRITE_BLK_SUCCEEDED, progress, _new_pbas.pbas[_lvl], _encoded_blk);
+		_write_node.generate(_helper, WRITE_NODE, WRITE_BLK_SUCCEEDED, progress, _new_pbas.pbas[_lvl], _encoded_blk);
 	} else
 		_write_block.generate(_helper, WRITE_BLK, WRITE_BLK_SUCCEEDED, progress, _new_pbas.pbas[_lvl], _data_blk);
 }
@@ -14,6 +14,7 @@
 
 /* base includes */
 #include <base/log.h>
+#include <util/reconstructible.h>
 #include <util/string.h>
 
 /* tresor includes */
@@ -33,9 +34,9 @@ struct Crypto : Tresor_crypto::Interface
 	struct Key_value_size_mismatch : Genode::Exception { };
 
 	struct {
-		uint32_t        id   { };
-		Aes_cbc_4k::Key key  { };
-		bool            used { false };
+		uint32_t                                 id       { };
+		Constructible<Aes_cbc_4k::Key_schedule> schedule { };
+		bool                                     used     { false };
 	} keys [Slots::NUM_SLOTS];
 
 	struct {
@@ -136,13 +137,19 @@ struct Crypto : Tresor_crypto::Interface
 	             size_t             value_len) override
 	{
 		return apply_to_unused_key([&](auto &key_slot) {
-			if (value_len != sizeof(key_slot.key))
+			Aes_cbc_4k::Key key { };
+			if (value_len != sizeof(key.values))
 				return false;
 
-			if (!_slots.store(id))
-				return false;
+			/* expand the key once instead of for each block */
+			Genode::memcpy(key.values, value, sizeof(key.values));
+			key_slot.schedule.construct(key);
+			Genode::memset(key.values, 0, sizeof(key.values));
 
-			Genode::memcpy(key_slot.key.values, value, sizeof(key_slot.key));
+			if (!key_slot.schedule->valid() || !_slots.store(id)) {
+				key_slot.schedule.destruct();
+				return false;
+			}
 			key_slot.id   = id;
 			key_slot.used = true;
 
@@ -153,7 +160,7 @@ struct Crypto : Tresor_crypto::Interface
 	bool remove_key(uint32_t const id) override
 	{
 		return apply_key (id, [&] (auto &meta) {
-			Genode::memset(meta.key.values, 0, sizeof(meta.key.values));
+			meta.schedule.destruct();
 
 			meta.used = false;
 
@@ -179,16 +186,15 @@ struct Crypto : Tresor_crypto::Interface
 				job.blk_nr = block_number;
 				job.key_id = key_id;
 
-				uint64_t block_id = job.blk_nr;
-
-				Aes_cbc_4k::Block_number     block_number { block_id };
-				Aes_cbc_4k::Plaintext const &plaintext  = *reinterpret_cast<Aes_cbc_4k::Plaintext const *>(src.start);
-				Aes_cbc_4k::Ciphertext      &ciphertext = *reinterpret_cast<Aes_cbc_4k::Ciphertext *>(&job.data);
+				Aes_cbc_4k::Block_number     first_block { job.blk_nr };
+				Aes_cbc_4k::Plaintext const *plaintext  = reinterpret_cast<Aes_cbc_4k::Plaintext const *>(src.start);
+				Aes_cbc_4k::Ciphertext      *ciphertext = reinterpret_cast<Aes_cbc_4k::Ciphertext *>(&job.data);
 
 				/* paranoia */
-				static_assert(sizeof(plaintext) == sizeof(job.data), "size mismatch");
+				static_assert(sizeof(*plaintext) == sizeof(job.data), "size mismatch");
 
-				Aes_cbc_4k::encrypt(meta.key, block_number, plaintext, ciphertext);
+				if (!meta.schedule->encrypt(first_block, plaintext, ciphertext))
+					error("encrypting block ", job.blk_nr);
 			});
 		});
 	}
@@ -255,14 +261,15 @@ struct Crypto : Tresor_crypto::Interface
 			bool ok = apply_key (job.key_id, [&] (auto &meta) {
 				block_id = job.blk_nr;
 
-				Aes_cbc_4k::Block_number      block_number { block_id };
-				Aes_cbc_4k::Ciphertext const &ciphertext = *reinterpret_cast<Aes_cbc_4k::Ciphertext const *>(&job.data);
-				Aes_cbc_4k::Plaintext        &plaintext  = *reinterpret_cast<Aes_cbc_4k::Plaintext *>(dst.start);
+				Aes_cbc_4k::Block_number      first_block { block_id };
+				Aes_cbc_4k::Ciphertext const *ciphertext = reinterpret_cast<Aes_cbc_4k::Ciphertext const *>(&job.data);
+				Aes_cbc_4k::Plaintext        *plaintext  = reinterpret_cast<Aes_cbc_4k::Plaintext *>(dst.start);
 
 				/* paranoia */
-				static_assert(sizeof(ciphertext) == sizeof(job.data), "size mismatch");
+				static_assert(sizeof(*ciphertext) == sizeof(job.data), "size mismatch");
 
-				Aes_cbc_4k::decrypt(meta.key, block_number, ciphertext, plaintext);
+				if (!meta.schedule->decrypt(first_block, ciphertext, plaintext))
+					error("decrypting block ", block_id);
 
 				return true;
 			});
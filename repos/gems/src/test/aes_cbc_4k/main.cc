@@ -73,6 +73,12 @@ struct Test::Main
 	Aes_cbc_4k::Ciphertext _ciphertext { };
 	Aes_cbc_4k::Plaintext  _decrypted_plaintext  { };
 
+	enum { BATCH = 8 };
+
+	Aes_cbc_4k::Plaintext  _batch_plaintext  [BATCH] { };
+	Aes_cbc_4k::Ciphertext _batch_ciphertext [BATCH] { };
+	Aes_cbc_4k::Plaintext  _batch_decrypted  [BATCH] { };
+
 	bool encrypt_decrypt_compare(Aes_cbc_4k::Key const &key,
 	                             Aes_cbc_4k::Plaintext const &plaintext,
 	                             Aes_cbc_4k::Block_number const &block_number)
@@ -99,6 +105,36 @@ struct Test::Main
 		return true;
 	}
 
+	/**
+	 * Compare batched en-/decryption with a key schedule to the
+	 * single-block functions
+	 */
+	bool batch_compare(Aes_cbc_4k::Key_schedule &key_schedule,
+	                   Aes_cbc_4k::Key const &key,
+	                   Aes_cbc_4k::Block_number const &first)
+	{
+		if (!key_schedule.encrypt(first, _batch_plaintext, _batch_ciphertext, BATCH)
+		 || !key_schedule.decrypt(first, _batch_ciphertext, _batch_decrypted, BATCH)) {
+			error("batched en-/decryption failed");
+			return false;
+		}
+
+		for (unsigned i = 0; i < BATCH; i++) {
+
+			Aes_cbc_4k::encrypt(key, { first.value + i }, _batch_plaintext[i], _ciphertext);
+
+			if (memcmp(_ciphertext.values, _batch_ciphertext[i].values, sizeof(_ciphertext.values))) {
+				error("batched ciphertext of block ", first.value + i, " differs");
+				return false;
+			}
+			if (memcmp(_batch_plaintext[i].values, _batch_decrypted[i].values, sizeof(_batch_plaintext[i].values))) {
+				error("batched plaintext of block ", first.value + i, " differs");
+				return false;
+			}
+		}
+		return true;
+	}
+
 	Main(Env &env) : _env(env)
 	{
 		Attached_rom_dataspace config(env, "config");
@@ -138,6 +174,38 @@ struct Test::Main
 			log("rounds=", test_rounds, ", cycles=", t_end - t_start,
 			    " cycles/rounds=", (t_end - t_start)/test_rounds);
 
+		/* batched en-/decryption with a key expanded only once */
+		Aes_cbc_4k::Key_schedule key_schedule { key };
+		if (!key_schedule.valid()) {
+			error("key schedule invalid");
+			return;
+		}
+
+		for (unsigned i = 0; i < BATCH; i++) {
+			_batch_plaintext[i] = plaintext;
+			_batch_plaintext[i].values[0] = (char)i;
+		}
+
+		if (!batch_compare(key_schedule, key, block_number))
+			return;
+
+		unsigned const batch_rounds = test_rounds / BATCH;
+
+		t_start = Trace::timestamp();
+		for (unsigned i = 0; i < batch_rounds; i++) {
+			if (!key_schedule.encrypt(block_number, _batch_plaintext, _batch_ciphertext, BATCH)
+			 || !key_schedule.decrypt(block_number, _batch_ciphertext, _batch_decrypted, BATCH)) {
+				error("batched en-/decryption failed");
+				return;
+			}
+			block_number.value += BATCH;
+		}
+		t_end = Trace::timestamp();
+
+		if (batch_rounds)
+			log("batched rounds=", batch_rounds * BATCH, ", cycles=", t_end - t_start,
+			    " cycles/rounds=", (t_end - t_start)/(batch_rounds * BATCH));
+
 		log("Test succeeded");
 	}
 };
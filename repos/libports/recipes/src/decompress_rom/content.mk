@@ -0,0 +1,2 @@
+SRC_DIR = src/server/decompress_rom
+include $(GENODE_DIR)/repos/base/recipes/src/content.inc
@@ -97,10 +97,20 @@ namespace Libc {
 	/**
 	 * Malloc allocator
 	 */
-	void init_malloc(Genode::Allocator &);
+	void init_malloc(Genode::Allocator &, Genode::Xml_node const &config);
 	void init_malloc_cloned(Clone_connection &);
 	void reinit_malloc(Genode::Allocator &);
 
+	/**
+	 * Assign a per-thread malloc arena to a starting pthread
+	 */
+	void claim_malloc_arena(Thread const &);
+
+	/**
+	 * Release the per-thread malloc arena of an exiting pthread
+	 */
+	void release_malloc_arena(Thread const &);
+
 	using Rtc_path = String<Vfs::MAX_PATH_LEN>;
 
 	/**
@@ -195,6 +195,13 @@ struct Libc::Kernel final : Vfs::Read_ready_response_handler,
 			     : Xml_node("<pthread/>");
 		}
 
+		Xml_node _malloc_config()
+		{
+			return _libc_env.libc_config().has_sub_node("malloc")
+			     ? _libc_env.libc_config().sub_node("malloc")
+			     : Xml_node("<malloc/>");
+		}
+
 		using Config_attr = String<Vfs::MAX_PATH_LEN>;
 
 		Config_attr const _rtc_path = _libc_env.libc_config().attribute_value("rtc", Config_attr());
@@ -28,6 +28,7 @@
 
 /* libc-internal includes */
 #include <internal/types.h>
+#include <internal/init.h>
 #include <internal/monitor.h>
 #include <internal/timer.h>
 
@@ -220,6 +221,19 @@ struct Libc::Pthread : Noncopyable
 		 */
 		Pthread(Thread &existing_thread, void *stack_address);
 
+		~Pthread()
+		{
+			/*
+			 * A cancelled thread may be destroyed by 'pthread_join' without
+			 * passing 'exit'. Its arena is released after the thread is gone.
+			 */
+			if (_thread_object.constructed()) {
+				Thread const &thread = _thread;
+				_thread_object.destruct();
+				release_malloc_arena(thread);
+			}
+		}
+
 		static void init_tls_support();
 
 		void start() { _thread.start(); }
@@ -237,6 +251,7 @@ struct Libc::Pthread : Noncopyable
 		void exit(void *retval) __attribute__((noreturn))
 		{
 			while (cleanup_pop(1)) { }
+			release_malloc_arena(_thread);
 			_retval = retval;
 			cancel();
 
@@ -72,13 +72,16 @@ class Libc::Vfs_plugin final : public Plugin
 
 		struct Mmap_entry : Registry<Mmap_entry>::Element
 		{
-			void            * const start;
-			Vfs::Vfs_handle * const reference_handle;
+			void                 * const start;
+			Vfs::Vfs_handle      * const reference_handle;
+			Absolute_path          const path;
+			Dataspace_capability   const ds;
 
 			Mmap_entry(Registry<Mmap_entry> &registry, void *start,
-			           Vfs::Vfs_handle *reference_handle)
+			           Vfs::Vfs_handle *reference_handle,
+			           Absolute_path const &path, Dataspace_capability ds)
 			: Registry<Mmap_entry>::Element(registry, *this), start(start),
-			  reference_handle(reference_handle) { }
+			  reference_handle(reference_handle), path(path), ds(ds) { }
 		};
 
 		Genode::Allocator                &_alloc;
@@ -128,6 +131,15 @@ class Libc::Vfs_plugin final : public Plugin
 		 */
 		void _vfs_sync(Vfs::Vfs_handle&);
 
+		/**
+		 * Attach the dataspace of the file referred to by 'fd'
+		 *
+		 * \return  local address of the mapping, or nullptr with 'error'
+		 *          set to an errno value
+		 */
+		void *_mmap_dataspace(File_descriptor *fd, ::size_t length,
+		                      ::off_t offset, bool writeable, int &error);
+
 		/**
 		 * Update modification time
 		 */
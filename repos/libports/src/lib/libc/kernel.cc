@@ -496,7 +496,7 @@ Libc::Kernel::Kernel(Genode::Env &env, Genode::Allocator &heap)
 
 	} else {
 		_malloc_heap.construct(*_malloc_ram, _env.rm());
-		init_malloc(*_malloc_heap);
+		init_malloc(*_malloc_heap, _malloc_config());
 	}
 
 	init_fork(_env, _libc_env, _heap, *_malloc_heap, _pid, *this, _signal,
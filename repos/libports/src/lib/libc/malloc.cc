@@ -16,6 +16,7 @@
 #include <base/env.h>
 #include <base/log.h>
 #include <base/slab.h>
+#include <base/thread.h>
 #include <util/reconstructible.h>
 #include <util/string.h>
 #include <util/misc_math.h>
@@ -37,6 +38,7 @@ extern "C" {
 
 namespace Libc {
 	class Slab_alloc;
+	class Arenas;
 	class Malloc;
 }
 
@@ -47,17 +49,19 @@ class Libc::Slab_alloc : public Slab
 
 		size_t const _object_size;
 
-		size_t _calculate_block_size(size_t object_size)
+		size_t _calculate_block_size(size_t object_size, unsigned objects_per_block)
 		{
-			size_t block_size = 16*object_size;
+			size_t block_size = objects_per_block*object_size;
 			return align_addr(block_size, 12);
 		}
 
 	public:
 
-		Slab_alloc(size_t object_size, Allocator &backing_store)
+		Slab_alloc(size_t object_size, Allocator &backing_store,
+		           unsigned objects_per_block = 16)
 		:
-			Slab(object_size, _calculate_block_size(object_size), 0, &backing_store),
+			Slab(object_size, _calculate_block_size(object_size, objects_per_block),
+			     0, &backing_store),
 			_object_size(object_size)
 		{ }
 
@@ -72,6 +76,341 @@ class Libc::Slab_alloc : public Slab
 };
 
 
+/**
+ * Per-thread arenas of fine-grained slab size classes
+ *
+ * Each pthread claims an arena of its own when started and allocates from
+ * it without taking a lock. Blocks freed by a thread other than the owner are
+ * pushed onto a lock-free list of the owning arena, which the owner drains on
+ * its next allocation. All other threads, e.g., the main thread and
+ * entrypoints, as well as pthreads beyond 'MAX_ARENAS' share arena 0, which
+ * is protected by a mutex. Allocations larger than the biggest size class
+ * (one page plus metadata) are served by the backing store directly.
+ *
+ * When a pthread exits, its arena is released and taken over by the next
+ * pthread that claims an arena, including the blocks still allocated from it.
+ */
+class Libc::Arenas : Noncopyable
+{
+	private:
+
+		using size_t   = Genode::size_t;
+		using addr_t   = Genode::addr_t;
+		using uint16_t = Genode::uint16_t;
+		using uint32_t = Genode::uint32_t;
+
+		enum {
+			MAX_ARENAS        = 32,
+			NUM_FINE_CLASSES  = 8,   /* 16 to 128 bytes in steps of 16 */
+			NUM_COARSE_GROUPS = 5,   /* four classes per power of two */
+			PAGE_CLASS_SIZE   = 4096 + 32,  /* page plus metadata room */
+			NUM_CLASSES       = NUM_FINE_CLASSES + 4*NUM_COARSE_GROUPS + 1,
+			BACKING_STORE     = 0xffff,
+			OBJECTS_PER_BLOCK = 8,
+		};
+
+		/*
+		 * Metadata stored right before the pointer returned to the caller
+		 */
+		struct Metadata
+		{
+			size_t   size;       /* allocation size including metadata room */
+			uint32_t offset;     /* offset of pointer from allocation */
+			uint16_t arena;      /* index of owning arena */
+			uint16_t class_idx;  /* size class or 'BACKING_STORE' */
+		};
+
+		static_assert(sizeof(Metadata) == 16, "unexpected metadata size");
+
+		static constexpr size_t _room(size_t align) {
+			return sizeof(Metadata) + (align - 1); }
+
+		static size_t _class_size(unsigned idx)
+		{
+			if (idx < NUM_FINE_CLASSES)
+				return (idx + 1)*16;
+
+			if (idx == NUM_CLASSES - 1)
+				return PAGE_CLASS_SIZE;
+
+			unsigned const group = (idx - NUM_FINE_CLASSES) / 4;
+			unsigned const sub   = (idx - NUM_FINE_CLASSES) % 4;
+			return (128UL << group) + (sub + 1)*(32UL << group);
+		}
+
+		/**
+		 * Return smallest size class for 'size' or NUM_CLASSES if too big
+		 */
+		static unsigned _class_idx(size_t size)
+		{
+			if (size <= 128)
+				return (unsigned)((size + 15)/16) - 1;
+
+			unsigned const group = (unsigned)Genode::log2(size - 1) - 7;
+			if (group >= NUM_COARSE_GROUPS)
+				return (size <= PAGE_CLASS_SIZE) ? NUM_CLASSES - 1 : NUM_CLASSES;
+
+			size_t const base = 128UL << group;
+			size_t const step =  32UL << group;
+			return NUM_FINE_CLASSES + group*4
+			     + (unsigned)((size - base + step - 1)/step) - 1;
+		}
+
+		/*
+		 * Block freed by a remote thread, stored at the caller-visible
+		 * pointer of the block
+		 */
+		struct Remote_block { Remote_block *next; };
+
+		struct Arena : Noncopyable
+		{
+			Thread const *owner;  /* accessed atomically */
+
+			Allocator &backing_store;
+
+			Remote_block *remote { nullptr };  /* accessed atomically */
+
+			Constructible<Slab_alloc> slabs[NUM_CLASSES] { };
+
+			Arena(Thread const *owner, Allocator &backing_store)
+			: owner(owner), backing_store(backing_store) { }
+
+			bool owned_by(Thread const *thread) const {
+				return __atomic_load_n(&owner, __ATOMIC_ACQUIRE) == thread; }
+
+			void *alloc(unsigned idx)
+			{
+				if (!slabs[idx].constructed())
+					slabs[idx].construct(_class_size(idx), backing_store,
+					                     OBJECTS_PER_BLOCK);
+				return slabs[idx]->alloc();
+			}
+
+			void free(unsigned idx, void *addr) { slabs[idx]->free(addr); }
+
+			void push_remote(void *ptr)
+			{
+				Remote_block &block = *(Remote_block *)ptr;
+				Remote_block *head = __atomic_load_n(&remote, __ATOMIC_RELAXED);
+				do {
+					block.next = head;
+				} while (!__atomic_compare_exchange_n(&remote, &head, &block, true,
+				                                      __ATOMIC_RELEASE,
+				                                      __ATOMIC_RELAXED));
+			}
+
+			void drain_remote()
+			{
+				if (!__atomic_load_n(&remote, __ATOMIC_RELAXED))
+					return;
+
+				Remote_block *block = __atomic_exchange_n(&remote, nullptr,
+				                                          __ATOMIC_ACQUIRE);
+				while (block) {
+					Remote_block * const next = block->next;
+					Metadata const &md = *((Metadata *)block - 1);
+					free(md.class_idx, (void *)((addr_t)block - md.offset));
+					block = next;
+				}
+			}
+		};
+
+		Allocator &_backing_store;
+
+		Mutex _claim_mutex  { };
+		Mutex _shared_mutex { };  /* serializes the use of arena 0 */
+
+		Arena *_arenas[MAX_ARENAS] { };  /* accessed atomically */
+
+		Arena _shared_arena { nullptr, _backing_store };
+
+		Arena *_arena(unsigned idx) const {
+			return __atomic_load_n(&_arenas[idx], __ATOMIC_ACQUIRE); }
+
+		bool _exhausted = false;  /* arena limit reached, guarded by '_claim_mutex' */
+
+		/**
+		 * Return arena index of the calling thread, 0 for the shared arena
+		 */
+		unsigned _my_arena_idx() const
+		{
+			Thread const * const myself = Thread::myself();
+			if (!myself)
+				return 0;
+
+			for (unsigned i = 1; i < MAX_ARENAS; i++) {
+				Arena const * const arena = _arena(i);
+				if (!arena)
+					break;
+				if (arena->owned_by(myself))
+					return i;
+			}
+			return 0;
+		}
+
+		static void *_alloc_at_arena(Arena &arena, unsigned class_idx)
+		{
+			arena.drain_remote();
+			return arena.alloc(class_idx);
+		}
+
+	public:
+
+		enum { DEFAULT_ALIGN = 16 };
+
+		Arenas(Allocator &backing_store) : _backing_store(backing_store)
+		{
+			_arenas[0] = &_shared_arena;
+		}
+
+		void *alloc(size_t size, size_t align = DEFAULT_ALIGN)
+		{
+			/* reserve room for the remote-free link within the block */
+			size_t   const real_size = Genode::max(size, sizeof(Remote_block))
+			                         + _room(align);
+			unsigned const class_idx = _class_idx(real_size);
+
+			void    *alloc_addr = nullptr;
+			unsigned arena_idx  = 0;
+
+			if (class_idx >= NUM_CLASSES) {
+				_backing_store.try_alloc(real_size).with_result(
+					[&] (void *ptr) { alloc_addr = ptr; },
+					[&] (Allocator::Alloc_error) { });
+
+			} else {
+				arena_idx = _my_arena_idx();
+				Arena &arena = *_arena(arena_idx);
+				if (arena_idx == 0) {
+					Mutex::Guard guard(_shared_mutex);
+					alloc_addr = _alloc_at_arena(arena, class_idx);
+				} else {
+					alloc_addr = _alloc_at_arena(arena, class_idx);
+				}
+			}
+
+			if (!alloc_addr) return nullptr;
+
+			/* correctly align the allocation address */
+			Metadata * const aligned_addr =
+				(Metadata *)(((addr_t)alloc_addr + _room(align)) & ~(align - 1));
+
+			*(aligned_addr - 1) = Metadata {
+				.size      = real_size,
+				.offset    = (uint32_t)((addr_t)aligned_addr - (addr_t)alloc_addr),
+				.arena     = (uint16_t)arena_idx,
+				.class_idx = (uint16_t)(class_idx < NUM_CLASSES ? class_idx
+				                                                : (unsigned)BACKING_STORE) };
+			return aligned_addr;
+		}
+
+		/**
+		 * Return size usable by the caller without reallocation
+		 */
+		static size_t size(void *ptr)
+		{
+			Metadata const &md = *((Metadata *)ptr - 1);
+			return md.size - md.offset;
+		}
+
+		void free(void *ptr)
+		{
+			Metadata const &md = *((Metadata *)ptr - 1);
+
+			void * const alloc_addr = (void *)((addr_t)ptr - md.offset);
+
+			if (md.class_idx == BACKING_STORE) {
+				_backing_store.free(alloc_addr, md.size);
+				return;
+			}
+
+			Arena &arena = *_arena(md.arena);
+
+			if (md.arena == 0) {
+				Mutex::Guard guard(_shared_mutex);
+				arena.free(md.class_idx, alloc_addr);
+				return;
+			}
+
+			/*
+			 * A released arena has no owner. Its blocks must not be freed
+			 * directly by threads without a 'Thread' object, e.g., the main
+			 * thread, because a pthread may claim the arena at any time.
+			 */
+			Thread const * const myself = Thread::myself();
+			if (myself && arena.owned_by(myself)) {
+				arena.free(md.class_idx, alloc_addr);
+				return;
+			}
+
+			arena.push_remote(ptr);
+		}
+
+		/**
+		 * Assign an arena to 'thread', either a released one or a new one
+		 *
+		 * If all arenas are in use, 'thread' keeps using the shared arena.
+		 */
+		void claim_arena(Thread const &thread)
+		{
+			Mutex::Guard guard(_claim_mutex);
+
+			for (unsigned i = 1; i < MAX_ARENAS; i++) {
+				Arena * const arena = _arena(i);
+				if (arena && arena->owned_by(&thread))
+					return;
+			}
+
+			for (unsigned i = 1; i < MAX_ARENAS; i++) {
+				Arena * const arena = _arena(i);
+				if (arena && arena->owned_by(nullptr)) {
+					__atomic_store_n(&arena->owner, &thread, __ATOMIC_RELEASE);
+					return;
+				}
+			}
+
+			for (unsigned i = 1; i < MAX_ARENAS; i++) {
+				if (_arena(i))
+					continue;
+
+				_backing_store.try_alloc(sizeof(Arena)).with_result(
+					[&] (void *ptr) {
+						Arena * const new_arena =
+							construct_at<Arena>(ptr, &thread, _backing_store);
+						__atomic_store_n(&_arenas[i], new_arena, __ATOMIC_RELEASE); },
+					[&] (Allocator::Alloc_error) { });
+				return;
+			}
+
+			if (!_exhausted)
+				warning("all ", (unsigned)MAX_ARENAS - 1, " malloc arenas in use, "
+				        "thread '", thread.name(), "' and further ones use the "
+				        "shared arena");
+			_exhausted = true;
+		}
+
+		/**
+		 * Release the arena of 'thread' for the use by others
+		 *
+		 * Blocks freed later by 'thread' are handed to the next owner via
+		 * the remote-free list.
+		 */
+		void release_arena(Thread const &thread)
+		{
+			Mutex::Guard guard(_claim_mutex);
+
+			for (unsigned i = 1; i < MAX_ARENAS; i++) {
+				Arena * const arena = _arena(i);
+				if (arena && arena->owned_by(&thread)) {
+					arena->drain_remote();
+					__atomic_store_n(&arena->owner, nullptr, __ATOMIC_RELEASE);
+					return;
+				}
+			}
+		}
+};
+
+
 /**
  * Allocator that uses slabs for small objects sizes
  */
@@ -128,6 +467,8 @@ class Libc::Malloc
 
 		Mutex _mutex;
 
+		Constructible<Arenas> _arenas { };
+
 		unsigned _slab_log2(size_t size) const
 		{
 			unsigned msb = Genode::log2(size);
@@ -145,12 +486,39 @@ class Libc::Malloc
 
 	public:
 
-		Malloc(Allocator &backing_store) : _backing_store(backing_store)
+		/**
+		 * Constructor
+		 *
+		 * \param per_thread_arenas  use 'Arenas' instead of the slabs shared
+		 *                           by all threads
+		 */
+		Malloc(Allocator &backing_store, bool per_thread_arenas)
+		:
+			_backing_store(backing_store)
 		{
+			if (per_thread_arenas) {
+				_arenas.construct(backing_store);
+				return;
+			}
+
 			for (unsigned i = SLAB_START; i <= SLAB_STOP; i++)
 				_slabs[i - SLAB_START].construct(1U << i, backing_store);
 		}
 
+		bool per_thread_arenas() const { return _arenas.constructed(); }
+
+		void claim_arena(Thread const &thread)
+		{
+			if (_arenas.constructed())
+				_arenas->claim_arena(thread);
+		}
+
+		void release_arena(Thread const &thread)
+		{
+			if (_arenas.constructed())
+				_arenas->release_arena(thread);
+		}
+
 		~Malloc() { warning(__func__, " unexpectedly called"); }
 
 		/**
@@ -159,6 +527,9 @@ class Libc::Malloc
 
 		void * alloc(size_t size, size_t align = DEFAULT_ALIGN)
 		{
+			if (_arenas.constructed())
+				return _arenas->alloc(size, align);
+
 			Mutex::Guard guard(_mutex);
 
 			size_t   const real_size = size + _room(align);
@@ -189,6 +560,19 @@ class Libc::Malloc
 
 		void *realloc(void *ptr, size_t size)
 		{
+			if (_arenas.constructed()) {
+				size_t const old_size = Arenas::size(ptr);
+				if (size <= old_size)
+					return ptr;
+
+				void * const new_addr = _arenas->alloc(size);
+				if (new_addr) {
+					::memcpy(new_addr, ptr, old_size);
+					_arenas->free(ptr);
+				}
+				return new_addr;
+			}
+
 			size_t const real_size     = size + _room(DEFAULT_ALIGN);
 			size_t const old_real_size = ((Metadata *)ptr - 1)->size;
 
@@ -212,6 +596,11 @@ class Libc::Malloc
 
 		void free(void *ptr)
 		{
+			if (_arenas.constructed()) {
+				_arenas->free(ptr);
+				return;
+			}
+
 			Mutex::Guard lock_guard(_mutex);
 
 			Metadata *md = (Metadata *)ptr - 1;
@@ -285,18 +674,38 @@ int posix_memalign(void **memptr, size_t alignment, size_t size)
 }
 
 
+void Libc::claim_malloc_arena(Thread const &thread)
+{
+	if (mallocator)
+		mallocator->claim_arena(thread);
+}
+
+
+void Libc::release_malloc_arena(Thread const &thread)
+{
+	if (mallocator)
+		mallocator->release_arena(thread);
+}
+
+
 static Genode::Constructible<Malloc> &constructible_malloc()
 {
 	return *unmanaged_singleton<Genode::Constructible<Malloc> >();
 }
 
 
-void Libc::init_malloc(Genode::Allocator &heap)
+void Libc::init_malloc(Genode::Allocator &heap, Xml_node const &config)
 {
+	using Mode = String<16>;
+
+	Mode const mode = config.attribute_value("mode", Mode("global"));
+
+	if (mode != "global" && mode != "per_thread")
+		warning("unknown malloc mode '", mode, "', using 'global'");
 
 	Constructible<Malloc> &_malloc = constructible_malloc();
 
-	_malloc.construct(heap);
+	_malloc.construct(heap, mode == "per_thread");
 
 	mallocator = _malloc.operator->();
 }
@@ -314,5 +723,7 @@ void Libc::reinit_malloc(Genode::Allocator &heap)
 {
 	Malloc &malloc = *constructible_malloc();
 
-	construct_at<Malloc>(&malloc, heap);
+	bool const per_thread_arenas = malloc.per_thread_arenas();
+
+	construct_at<Malloc>(&malloc, heap, per_thread_arenas);
 }
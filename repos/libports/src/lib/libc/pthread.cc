@@ -88,6 +88,8 @@ void Libc::Pthread::Thread_object::entry()
 
 	_tls_pointer(&info, _pthread);
 
+	claim_malloc_arena(*this);
+
 	pthread_exit(_start_routine(_arg));
 }
 
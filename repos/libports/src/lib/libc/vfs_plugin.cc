@@ -2355,12 +2355,19 @@ void *Libc::Vfs_plugin::mmap(void *addr_in, ::size_t length, int prot, int flags
 
 	void *addr = nullptr;
 
-	if (flags & MAP_PRIVATE) {
+	/*
+	 * A read-only private mapping cannot be told apart from a shared one.
+	 * Hence, map the file's dataspace if the VFS provides one and fall back
+	 * to copying the file content otherwise.
+	 */
+	if ((flags & MAP_PRIVATE) && (prot == PROT_READ)) {
+		int ignored_errno = 0;
+		addr = _mmap_dataspace(fd, length, offset, false, ignored_errno);
+		if (addr)
+			return addr;
+	}
 
-		/*
-		 * XXX attempt to obtain memory mapping via
-		 *     'Vfs::Directory_service::dataspace'.
-		 */
+	if (flags & MAP_PRIVATE) {
 
 		addr = mem_alloc()->alloc(length, PAGE_SHIFT);
 		if (addr == (void *)-1) {
@@ -2390,64 +2397,92 @@ void *Libc::Vfs_plugin::mmap(void *addr_in, ::size_t length, int prot, int flags
 
 	} else if (flags & MAP_SHARED) {
 
-		/* create another VFS handle to keep the file open as long as the mapping exists */
+		int result_errno = 0;
+		addr = _mmap_dataspace(fd, length, offset, true, result_errno);
 
-		Vfs::Vfs_handle *reference_handle = nullptr;
-		using Result = Vfs::Directory_service::Open_result;
-		Result vfs_open_result;
-		monitor().monitor([&] {
-			vfs_open_result = _root_fs.open(fd->fd_path, fd->flags,
-			                                &reference_handle, _alloc);
-			return Fn::COMPLETE;
-		});
+		if (!addr) {
+			if (result_errno == ENFILE)
+				error("mmap could not create reference VFS handle");
+			if (result_errno == ENODEV)
+				error("mmap got invalid dataspace capability");
 
-		if (vfs_open_result != Result::OPEN_OK) {
-			error("mmap could not create reference VFS handle");
-			errno = ENFILE;
+			errno = result_errno;
 			return MAP_FAILED;
 		}
+	}
+
+	return addr;
+}
 
-		Genode::Dataspace_capability ds_cap;
 
+void *Libc::Vfs_plugin::_mmap_dataspace(File_descriptor *fd, ::size_t length,
+                                        ::off_t offset, bool writeable,
+                                        int &result_errno)
+{
+	/* create another VFS handle to keep the file open as long as the mapping exists */
+
+	Vfs::Vfs_handle *reference_handle = nullptr;
+	using Result = Vfs::Directory_service::Open_result;
+	Result vfs_open_result;
+	monitor().monitor([&] {
+		vfs_open_result = _root_fs.open(fd->fd_path, fd->flags,
+		                                &reference_handle, _alloc);
+		return Fn::COMPLETE;
+	});
+
+	if (vfs_open_result != Result::OPEN_OK) {
+		result_errno = ENFILE;
+		return nullptr;
+	}
+
+	auto close_reference_handle = [&] {
 		monitor().monitor([&] {
-			ds_cap = _root_fs.dataspace(fd->fd_path);
+			reference_handle->close();
 			return Fn::COMPLETE;
 		});
+	};
 
-		if (!ds_cap.valid()) {
-			Genode::error("mmap got invalid dataspace capability");
-			monitor().monitor([&] {
-				reference_handle->close();
-				return Fn::COMPLETE;
-			});
-			errno = ENODEV;
-			return MAP_FAILED;
-		}
+	Absolute_path const path(fd->fd_path);
 
-		region_map().attach(ds_cap, {
-			.size       = length,
-			.offset     = addr_t(offset),
-			.use_at     = { },
-			.at         = { },
-			.executable = { },
-			.writeable  = true
-		}).with_result(
-			[&] (Region_map::Range range)  { addr = (void *)range.start; },
-			[&] (Region_map::Attach_error) { addr = nullptr; }
-		);
+	Genode::Dataspace_capability ds_cap;
 
-		if (!addr) {
-			monitor().monitor([&] {
-				reference_handle->close();
-				return Fn::COMPLETE;
-			});
-			errno = ENOMEM;
-			return MAP_FAILED;
-		}
+	monitor().monitor([&] {
+		ds_cap = _root_fs.dataspace(path.base());
+		return Fn::COMPLETE;
+	});
 
-		new (_alloc) Mmap_entry(_mmap_registry, addr, reference_handle);
+	if (!ds_cap.valid()) {
+		close_reference_handle();
+		result_errno = ENODEV;
+		return nullptr;
 	}
 
+	void *addr = nullptr;
+
+	region_map().attach(ds_cap, {
+		.size       = length,
+		.offset     = addr_t(offset),
+		.use_at     = { },
+		.at         = { },
+		.executable = { },
+		.writeable  = writeable
+	}).with_result(
+		[&] (Region_map::Range range)  { addr = (void *)range.start; },
+		[&] (Region_map::Attach_error) { addr = nullptr; }
+	);
+
+	if (!addr) {
+		monitor().monitor([&] {
+			_root_fs.release(path.base(), ds_cap);
+			return Fn::COMPLETE;
+		});
+		close_reference_handle();
+		result_errno = ENOMEM;
+		return nullptr;
+	}
+
+	new (_alloc) Mmap_entry(_mmap_registry, addr, reference_handle, path, ds_cap);
+
 	return addr;
 }
 
@@ -2471,15 +2506,20 @@ int Libc::Vfs_plugin::munmap(void *addr, ::size_t)
 	if (size_at_result == Size_at_error::MISMATCHING_ADDR)
 		return Errno(EINVAL);
 
-	/* shared mapping */
+	/* mapping of a file dataspace */
 
 	Vfs::Vfs_handle *reference_handle = nullptr;
 
 	_mmap_registry.for_each([&] (Mmap_entry &entry) {
 		if (entry.start == addr) {
 			reference_handle = entry.reference_handle;
-			destroy(_alloc, &entry);
 			region_map().detach(addr_t(addr));
+
+			monitor().monitor([&] {
+				_root_fs.release(entry.path.base(), entry.ds);
+				return Fn::COMPLETE;
+			});
+			destroy(_alloc, &entry);
 		}
 	});
 
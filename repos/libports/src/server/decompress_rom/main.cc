@@ -0,0 +1,286 @@
+/*
+ * \brief  Service that provides decompressed ROM modules
+ * \author agent
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <libc/component.h>
+#include <base/attached_rom_dataspace.h>
+#include <base/attached_ram_dataspace.h>
+#include <base/heap.h>
+#include <base/session_label.h>
+#include <root/component.h>
+#include <util/list.h>
+
+/* libc includes */
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wconversion"
+#include <sys/types.h>
+
+/* libarchive includes */
+#include <archive.h>
+#include <archive_entry.h>
+
+#pragma GCC diagnostic pop  /* restore -Wconversion warnings */
+
+namespace Decompress_rom {
+
+	using namespace Genode;
+
+	using Name = String<64>;
+
+	struct Module;
+	class  Rom_session_component;
+	class  Rom_root;
+	struct Main;
+}
+
+
+/**
+ * Decompressed content of a ROM module
+ *
+ * The content is decompressed at the first request of the module and kept
+ * for the lifetime of the service, which lets all sessions share the same
+ * dataspace.
+ */
+struct Decompress_rom::Module : List<Module>::Element
+{
+	/*
+	 * Noncopyable
+	 */
+	Module(Module const &);
+	Module &operator = (Module const &);
+
+	enum { MIN_CAPACITY = 64*1024 };
+
+	Env       &_env;
+	Allocator &_alloc;
+
+	Name const name;
+
+	Attached_ram_dataspace *_ds = nullptr;
+
+	size_t _size = 0;
+
+	/**
+	 * Replace backing store by a dataspace of 'capacity' bytes
+	 */
+	void _resize(size_t capacity)
+	{
+		Attached_ram_dataspace &ds = *new (_alloc)
+			Attached_ram_dataspace(_env.ram(), _env.rm(), capacity);
+
+		if (_ds) {
+			memcpy(ds.local_addr<char>(), _ds->local_addr<char const>(), _size);
+			destroy(_alloc, _ds);
+		}
+		_ds = &ds;
+	}
+
+	bool _decompress(Attached_rom_dataspace const &src)
+	{
+		archive * const ar = archive_read_new();
+
+		archive_read_support_filter_all(ar);
+		archive_read_support_format_raw(ar);
+
+		bool success = false;
+
+		struct archive_entry *entry = nullptr;
+
+		if (archive_read_open_memory(ar, src.local_addr<void const>(), src.size()) != ARCHIVE_OK
+		 || archive_read_next_header(ar, &entry) != ARCHIVE_OK) {
+
+			error("unable to read '", name, "': ", archive_error_string(ar));
+			archive_read_free(ar);
+			return false;
+		}
+
+		_resize(max(4*src.size(), (size_t)MIN_CAPACITY));
+
+		for (;;) {
+
+			if (_size == _ds->size())
+				_resize(2*_ds->size());
+
+			la_ssize_t const n = archive_read_data(ar, _ds->local_addr<char>() + _size,
+			                                       _ds->size() - _size);
+			if (n == 0) {
+				success = true;
+				break;
+			}
+
+			if (n < 0) {
+				error("unable to decompress '", name, "': ", archive_error_string(ar));
+				break;
+			}
+
+			_size += size_t(n);
+		}
+
+		archive_read_free(ar);
+
+		/*
+		 * Release the unused part of the estimated backing store. An empty
+		 * module keeps a minimal dataspace because RAM dataspaces cannot be
+		 * empty.
+		 */
+		if (success && _ds->size() - _size >= 4096)
+			_resize(max(_size, (size_t)1));
+
+		return success;
+	}
+
+	Module(Env &env, Allocator &alloc, Name const &name, Name const &from)
+	:
+		_env(env), _alloc(alloc), name(name)
+	{
+		Attached_rom_dataspace const src { _env, from.string() };
+
+		bool success = false;
+		Libc::with_libc([&] () { success = _decompress(src); });
+
+		if (!success && _ds) {
+			destroy(_alloc, _ds);
+			_ds = nullptr;
+		}
+		if (success)
+			log("decompressed '", from, "' to '", name, "' with size ", _size);
+	}
+
+	~Module()
+	{
+		if (_ds)
+			destroy(_alloc, _ds);
+	}
+
+	bool valid() const { return _ds != nullptr; }
+
+	Dataspace_capability ds_cap() const {
+		return _ds ? Dataspace_capability(_ds->cap()) : Dataspace_capability(); }
+};
+
+
+class Decompress_rom::Rom_session_component : public Rpc_object<Rom_session>
+{
+	private:
+
+		Dataspace_capability const _ds_cap;
+
+	public:
+
+		Rom_session_component(Module const &module) : _ds_cap(module.ds_cap()) { }
+
+		Rom_dataspace_capability dataspace() override
+		{
+			return static_cap_cast<Rom_dataspace>(_ds_cap);
+		}
+
+		void sigh(Signal_context_capability) override { }
+};
+
+
+class Decompress_rom::Rom_root : public Root_component<Rom_session_component>
+{
+	private:
+
+		Env       &_env;
+		Allocator &_alloc;
+		Xml_node   _config;
+
+		List<Module> _modules { };
+
+		/*
+		 * Noncopyable
+		 */
+		Rom_root(Rom_root const &);
+		Rom_root &operator = (Rom_root const &);
+
+		/**
+		 * Return name of the compressed ROM module for module 'name'
+		 */
+		Name _from(Name const &name) const
+		{
+			Name from = name;
+			_config.for_each_sub_node("rom", [&] (Xml_node const &rom) {
+				if (rom.attribute_value("name", Name()) == name)
+					from = rom.attribute_value("from", name); });
+			return from;
+		}
+
+		Module &_module(Name const &name)
+		{
+			for (Module *module = _modules.first(); module; module = module->next())
+				if (module->name == name)
+					return *module;
+
+			Module &module = *new (_alloc) Module(_env, _alloc, name, _from(name));
+			_modules.insert(&module);
+			return module;
+		}
+
+		Rom_session_component *_create_session(const char *args) override
+		{
+			Name const name = label_from_args(args).last_element();
+
+			try {
+				Module &module = _module(name);
+				if (!module.valid())
+					throw Service_denied();
+
+				return new (md_alloc()) Rom_session_component(module);
+			}
+			catch (Rom_connection::Rom_connection_failed) {
+				error("compressed ROM module for '", name, "' unavailable");
+				throw Service_denied();
+			}
+		}
+
+	public:
+
+		Rom_root(Env &env, Allocator &alloc, Xml_node config)
+		:
+			Root_component<Rom_session_component>(env.ep(), alloc),
+			_env(env), _alloc(alloc), _config(config)
+		{ }
+};
+
+
+struct Decompress_rom::Main
+{
+	Env &_env;
+
+	Attached_rom_dataspace _config { _env, "config" };
+
+	Heap _heap { _env.ram(), _env.rm() };
+
+	Rom_root _root { _env, _heap, _config.xml() };
+
+	Main(Env &env) : _env(env)
+	{
+		env.parent().announce(env.ep().manage(_root));
+	}
+};
+
+
+void Libc::Component::construct(Libc::Env &env)
+{
+	static Decompress_rom::Main main(env);
+}
+
+
+/**
+ * Dummy to discharge the dependency from a timer session
+ *
+ * Libarchive requests the current time regardless of whether an archive is
+ * created or read.
+ */
+extern "C" time_t time(time_t *) { return 0; }
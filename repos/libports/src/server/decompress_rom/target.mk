@@ -0,0 +1,3 @@
+TARGET = decompress_rom
+SRC_CC = main.cc
+LIBS   = base libc libarchive
@@ -0,0 +1,208 @@
+/*
+ * \brief  Benchmark for the throughput and memory use of the libc malloc
+ * \author agent
+ * \date   2026-10-18
+ *
+ * Each of the configured threads repeatedly allocates a window of blocks of
+ * pseudo-random sizes and frees them again. In the second phase, the blocks
+ * are handed over to the neighbouring thread, which frees them, to exercise
+ * the remote-free path. The benchmark reports the allocation throughput and
+ * the RAM consumed by the component.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/attached_rom_dataspace.h>
+#include <base/log.h>
+#include <libc/component.h>
+
+/* libc includes */
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+namespace Test {
+
+	using namespace Genode;
+
+	struct Worker;
+	struct Main;
+
+	enum { MAX_THREADS = 16, WINDOW = 256 };
+}
+
+
+struct Test::Worker
+{
+	unsigned const id;
+	unsigned const rounds;
+	size_t   const max_size;
+
+	pthread_barrier_t &barrier;
+
+	Worker *neighbour { nullptr };
+
+	void *blocks[WINDOW] { };
+
+	/* blocks handed over by the other worker for remote freeing */
+	void *remote[WINDOW] { };
+
+	pthread_t thread { };
+
+	unsigned long ops { 0 };
+
+	unsigned _seed;
+
+	Worker(unsigned id, unsigned rounds, size_t max_size,
+	       pthread_barrier_t &barrier)
+	:
+		id(id), rounds(rounds), max_size(max_size), barrier(barrier),
+		_seed(id*7919 + 1)
+	{ }
+
+	Worker(Worker const &) = delete;
+	Worker &operator = (Worker const &) = delete;
+
+	size_t _random_size()
+	{
+		/* linear congruential generator, biased towards small sizes */
+		_seed = _seed*1103515245 + 12345;
+		size_t const r = (_seed >> 8) & 0xffff;
+		return 1 + ((r*r) >> 16) % max_size;
+	}
+
+	void _alloc_window()
+	{
+		for (void *&block : blocks) {
+			size_t const size = _random_size();
+			block = malloc(size);
+			if (!block) {
+				error("worker ", id, ": allocation of ", size, " bytes failed");
+				exit(-1);
+			}
+			::memset(block, (int)id, size < 64 ? size : 64);
+			ops++;
+		}
+	}
+
+	void _free_window(void *(&window)[WINDOW])
+	{
+		for (void *&block : window) {
+			free(block);
+			block = nullptr;
+			ops++;
+		}
+	}
+
+	void run()
+	{
+		/* local allocation and free */
+		for (unsigned i = 0; i < rounds; i++) {
+			_alloc_window();
+			_free_window(blocks);
+		}
+
+		pthread_barrier_wait(&barrier);
+
+		/* free blocks allocated by the neighbouring worker */
+		for (unsigned i = 0; i < rounds; i++) {
+			_alloc_window();
+			::memcpy(neighbour->remote, blocks, sizeof(blocks));
+			pthread_barrier_wait(&barrier);
+			_free_window(remote);
+			pthread_barrier_wait(&barrier);
+		}
+	}
+
+	static void *entry(void *arg)
+	{
+		((Worker *)arg)->run();
+		return nullptr;
+	}
+};
+
+
+struct Test::Main
+{
+	Libc::Env &_env;
+
+	Attached_rom_dataspace _config { _env, "config" };
+
+	unsigned const _threads  = min(_config.xml().attribute_value("threads", 4U),
+	                               (unsigned)MAX_THREADS);
+	unsigned const _rounds   = _config.xml().attribute_value("rounds", 1000U);
+	size_t   const _max_size = _config.xml().attribute_value("max_size", (size_t)4096);
+
+	static uint64_t _now_us()
+	{
+		struct timespec ts { };
+		clock_gettime(CLOCK_MONOTONIC, &ts);
+		return (uint64_t)ts.tv_sec*1000*1000 + (uint64_t)ts.tv_nsec/1000;
+	}
+
+	void _run()
+	{
+		if (!_threads) {
+			error("at least one thread must be configured");
+			exit(-1);
+		}
+
+		size_t const ram_before = _env.pd().used_ram().value;
+
+		pthread_barrier_t barrier;
+		pthread_barrier_init(&barrier, nullptr, _threads);
+
+		Worker *workers[MAX_THREADS] { };
+		for (unsigned i = 0; i < _threads; i++)
+			workers[i] = new Worker(i, _rounds, _max_size, barrier);
+
+		for (unsigned i = 0; i < _threads; i++)
+			workers[i]->neighbour = workers[(i + 1) % _threads];
+
+		uint64_t const start_us = _now_us();
+
+		for (unsigned i = 0; i < _threads; i++)
+			if (pthread_create(&workers[i]->thread, nullptr,
+			                   Worker::entry, workers[i])) {
+				error("could not create worker thread ", i);
+				exit(-1);
+			}
+
+		unsigned long ops = 0;
+		for (unsigned i = 0; i < _threads; i++) {
+			pthread_join(workers[i]->thread, nullptr);
+			ops += workers[i]->ops;
+		}
+
+		uint64_t const duration_us = max(_now_us() - start_us, (uint64_t)1);
+
+		size_t const ram_after = _env.pd().used_ram().value;
+
+		for (unsigned i = 0; i < _threads; i++)
+			delete workers[i];
+
+		pthread_barrier_destroy(&barrier);
+
+		log("threads=", _threads, " rounds=", _rounds, " max_size=", _max_size);
+		log("operations: ", ops, " in ", duration_us/1000, " ms");
+		log("throughput: ", (ops*1000*1000)/duration_us, " ops/s");
+		log("RAM used: ", Number_of_bytes(ram_after - ram_before));
+
+		exit(0);
+	}
+
+	Main(Libc::Env &env) : _env(env)
+	{
+		Libc::with_libc([&] () { _run(); });
+	}
+};
+
+
+void Libc::Component::construct(Libc::Env &env) { static Test::Main main(env); }
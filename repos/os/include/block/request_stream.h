@@ -26,8 +26,9 @@ class Block::Request_stream : Genode::Noncopyable
 {
 	public:
 
-		struct Block_size { Genode::size_t value; };
-		struct Align_log2 { Genode::size_t value; };
+		struct Block_size   { Genode::size_t value; };
+		struct Align_log2   { Genode::size_t value; };
+		struct Max_transfer { Genode::size_t value; };
 
 		/**
 		 * Interface for accessing the content of a 'Request'
@@ -113,8 +114,236 @@ class Block::Request_stream : Genode::Noncopyable
 
 		using Tx_sink = Genode::Packet_stream_sink<Block::Session::Tx_policy>;
 
+		/* number of acknowledgements handed over to the ack queue at once */
+		enum { ACK_BATCH_SIZE = 32 };
+
 		Payload const _payload;
 
+		/*
+		 * Request merging
+		 *
+		 * When enabled via 'merge_requests', READ and WRITE packets that
+		 * follow each other in the request queue are combined into one
+		 * request if they are contiguous on the device as well as in the
+		 * packet-stream buffer. Since only adjacent packets are merged,
+		 * the order of requests is preserved, in particular with respect
+		 * to SYNC and TRIM requests, which are never merged. The
+		 * acknowledgement of a merged request is split into the
+		 * acknowledgements of the original packets.
+		 */
+
+		/* maximum number of packets combined into one request */
+		enum { MAX_MERGED_PACKETS = 16 };
+
+		/* maximum number of merged requests in flight */
+		enum { MAX_MERGED_REQUESTS = 16 };
+
+		struct Part
+		{
+			block_count_t count;
+			Request::Tag  tag;
+		};
+
+		struct Merged
+		{
+			Request  request;
+			unsigned num_parts;
+			Part     parts[MAX_MERGED_PACKETS];
+		};
+
+		Genode::size_t _max_transfer = 0;
+
+		/* request taken from the request queue but not yet accepted */
+		Merged _pending { };
+
+		Merged _in_flight[MAX_MERGED_REQUESTS] { };
+
+		static Request _request(Block::Packet_descriptor const &packet)
+		{
+			Operation operation { .type         = packet.operation_type(),
+			                      .block_number = packet.block_number(),
+			                      .count        = packet.block_count() };
+
+			return Request { .operation = operation,
+			                 .success   = false,
+			                 .offset    = packet.offset(),
+			                 .tag       = packet.tag() };
+		}
+
+		bool _packet_valid(Block::Packet_descriptor const &packet)
+		{
+			return _tx.sink()->packet_valid(packet) && (packet.offset() >= 0);
+		}
+
+		bool _in_flight_slot_free() const
+		{
+			for (Merged const &merged : _in_flight)
+				if (!merged.num_parts)
+					return true;
+			return false;
+		}
+
+		/**
+		 * Return true if 'packet' can be appended to the pending request
+		 */
+		bool _mergeable(Block::Packet_descriptor const &packet)
+		{
+			Request const &pending = _pending.request;
+
+			if (_pending.num_parts == MAX_MERGED_PACKETS)
+				return false;
+
+			if (!Operation::has_payload(pending.operation.type)
+			 || packet.operation_type() != pending.operation.type)
+				return false;
+
+			/* the tag of a merged request can be tracked only if one is free */
+			if (_pending.num_parts == 1 && !_in_flight_slot_free())
+				return false;
+
+			if (!_packet_valid(packet))
+				return false;
+
+			Genode::size_t const block_size = _info.block_size;
+			Genode::size_t const bytes      = pending.operation.count*block_size;
+
+			return packet.block_number() == pending.operation.block_number
+			                              + pending.operation.count
+			    && packet.offset() == pending.offset + (Block::off_t)bytes
+			    && bytes + packet.block_count()*block_size <= _max_transfer;
+		}
+
+		/**
+		 * Fill pending request from the request queue
+		 *
+		 * \return  true if a request is pending
+		 */
+		bool _collect_pending()
+		{
+			Tx_sink &tx_sink = *_tx.sink();
+
+			while (!_pending.num_parts) {
+
+				if (!tx_sink.packet_avail())
+					return false;
+
+				Block::Packet_descriptor const packet = tx_sink.peek_packet();
+
+				if (!_packet_valid(packet)) {
+
+					/* keep the packet in the queue if it cannot be rejected yet */
+					if (!tx_sink.ack_slots_free())
+						return false;
+
+					(void)tx_sink.try_get_packet();
+					tx_sink.try_ack_packet(packet);
+					continue;
+				}
+
+				(void)tx_sink.try_get_packet();
+				_pending.request   = _request(packet);
+				_pending.parts[0]  = { packet.block_count(), packet.tag() };
+				_pending.num_parts = 1;
+			}
+
+			/* extend pending request by the packets submitted meanwhile */
+			while (tx_sink.packet_avail()) {
+
+				Block::Packet_descriptor const packet = tx_sink.peek_packet();
+
+				if (!_mergeable(packet))
+					break;
+
+				(void)tx_sink.try_get_packet();
+				_pending.parts[_pending.num_parts++] = { packet.block_count(),
+				                                         packet.tag() };
+				_pending.request.operation.count += packet.block_count();
+			}
+			return true;
+		}
+
+		/**
+		 * Call 'fn' with the packet descriptor of each part of 'merged'
+		 */
+		void _for_each_part(Merged const &merged, bool success, auto const &fn) const
+		{
+			Request request = merged.request;
+
+			for (unsigned i = 0; i < merged.num_parts; i++) {
+
+				block_count_t const count = merged.parts[i].count;
+				Genode::size_t const bytes = count*_info.block_size;
+
+				request.operation.count = count;
+
+				Block::Packet_descriptor packet(request.operation,
+				                                { .offset = request.offset,
+				                                  .bytes  = bytes },
+				                                merged.parts[i].tag);
+				packet.succeeded(success);
+				fn(packet);
+
+				request.operation.block_number += count;
+				request.offset                 += (Block::off_t)bytes;
+			}
+		}
+
+		void _with_requests_merged(auto const &fn)
+		{
+			Tx_sink &tx_sink = *_tx.sink();
+
+			while (_collect_pending()) {
+
+				unsigned const num_parts = _pending.num_parts;
+
+				/* merged requests carry the tag of the first packet */
+				Response const response = fn(_pending.request);
+
+				if (response == Response::RETRY)
+					break;
+
+				if (response == Response::REJECTED) {
+
+					/* retry later if the rejections do not fit into the ack queue */
+					if (tx_sink.ack_slots_free() < num_parts)
+						break;
+
+					_for_each_part(_pending, false, [&] (Block::Packet_descriptor const &p) {
+						tx_sink.try_ack_packet(p); });
+				}
+
+				if (response == Response::ACCEPTED && num_parts > 1) {
+					for (Merged &merged : _in_flight) {
+						if (merged.num_parts)
+							continue;
+
+						merged = _pending;
+						break;
+					}
+				}
+
+				_pending.num_parts = 0;
+			}
+		}
+
+		/**
+		 * Find in-flight merged request matching the acknowledged 'request'
+		 */
+		Merged *_merged(Request const &request)
+		{
+			if (!_max_transfer)
+				return nullptr;
+
+			for (Merged &merged : _in_flight)
+				if (merged.num_parts
+				 && merged.request.offset                 == request.offset
+				 && merged.request.operation.block_number == request.operation.block_number
+				 && merged.request.operation.type         == request.operation.type)
+					return &merged;
+
+			return nullptr;
+		}
+
 	public:
 
 		Request_stream(Genode::Region_map               &rm,
@@ -163,6 +392,20 @@ class Block::Request_stream : Genode::Noncopyable
 
 		enum class Response { ACCEPTED, REJECTED, RETRY };
 
+		/**
+		 * Enable merging of contiguous READ and WRITE requests
+		 *
+		 * \param max  maximum size of a merged request in bytes, as
+		 *             supported by the driver, 0 disables merging
+		 *
+		 * Merging should be configured before the first request is
+		 * processed.
+		 */
+		void merge_requests(Max_transfer max)
+		{
+			_max_transfer = max.value;
+		}
+
 		/**
 		 * Call functor 'fn' for each pending request, with its packet as argument
 		 *
@@ -170,9 +413,18 @@ class Block::Request_stream : Genode::Noncopyable
 		 * was accepted or not. If it was accepted, the request is removed from the
 		 * packet stream. If the request could not be accepted, the iteration
 		 * aborts and the request packet stays in the packet stream.
+		 *
+		 * If request merging is enabled, a request may stand for several
+		 * packets. A request that could not be accepted is presented again,
+		 * possibly extended by packets submitted meanwhile.
 		 */
 		void with_requests(auto const &fn)
 		{
+			if (_max_transfer) {
+				_with_requests_merged(fn);
+				return;
+			}
+
 			Tx_sink &tx_sink = *_tx.sink();
 
 			using namespace Genode;
@@ -186,19 +438,9 @@ class Block::Request_stream : Genode::Noncopyable
 
 				Packet_descriptor const packet = tx_sink.peek_packet();
 
-				bool const packet_valid = tx_sink.packet_valid(packet)
-				                       && (packet.offset() >= 0);
-
-				Operation operation { .type         = packet.operation_type(),
-				                      .block_number = packet.block_number(),
-				                      .count        = packet.block_count() };
+				Request const request = _request(packet);
 
-				Request request { .operation = operation,
-				                  .success   = false,
-				                  .offset    = packet.offset(),
-				                  .tag       = packet.tag() };
-
-				Response const response = packet_valid
+				Response const response = _packet_valid(packet)
 				                        ? fn(request)
 				                        : Response::REJECTED;
 				bool progress = false;
@@ -243,14 +485,11 @@ class Block::Request_stream : Genode::Noncopyable
 
 				friend class Request_stream;
 
-				Tx_sink &_tx_sink;
+				Block::Request _request { };
 
 				bool _submitted = false;
 
-				Genode::size_t const _block_size;
-
-				Ack(Tx_sink &tx_sink, Genode::size_t block_size)
-				: _tx_sink(tx_sink), _block_size(block_size) { }
+				Ack() { }
 
 			public:
 
@@ -261,16 +500,7 @@ class Block::Request_stream : Genode::Noncopyable
 						return;
 					}
 
-					using Packet_descriptor = Block::Packet_descriptor;
-					Packet_descriptor::Payload
-						payload { .offset = request.offset,
-						          .bytes  = request.operation.count * _block_size };
-
-					Packet_descriptor packet(request.operation, payload, request.tag);
-
-					packet.succeeded(request.success);
-
-					_tx_sink.try_ack_packet(packet);
+					_request   = request;
 					_submitted = true;
 				}
 		};
@@ -282,18 +512,64 @@ class Block::Request_stream : Genode::Noncopyable
 		 * which provides an interface to 'submit' one acknowledgement. The
 		 * iteration stops when the acknowledgement queue is fully populated or if
 		 * the functor does not call 'Ack::submit'.
+		 *
+		 * Acknowledgements are collected in batches of up to 'ACK_BATCH_SIZE'
+		 * and enter the acknowledgement queue once per batch. The
+		 * acknowledgement of a merged request is split into the
+		 * acknowledgements of its packets.
 		 */
 		void try_acknowledge(auto const &fn)
 		{
 			Tx_sink &tx_sink = *_tx.sink();
 
-			while (tx_sink.ack_slots_free()) {
+			Block::Packet_descriptor packets[ACK_BATCH_SIZE];
+
+			/* number of packets a single acknowledgement may stand for */
+			unsigned const parts_max = _max_transfer ? MAX_MERGED_PACKETS : 1;
+
+			for (;;) {
+
+				unsigned const max = Genode::min((unsigned)ACK_BATCH_SIZE,
+				                                 tx_sink.ack_slots_free());
+				unsigned count    = 0;
+				bool     complete = false;
 
-				Ack ack(tx_sink, _payload._info.block_size);
+				while (count + parts_max <= max) {
+
+					Ack ack { };
+
+					fn(ack);
+
+					if (!ack._submitted) {
+						complete = true;
+						break;
+					}
+
+					Request const &request = ack._request;
+
+					if (Merged *merged = _merged(request)) {
+						_for_each_part(*merged, request.success,
+						               [&] (Block::Packet_descriptor const &p) {
+							packets[count++] = p; });
+						merged->num_parts = 0;
+						continue;
+					}
+
+					using Packet_descriptor = Block::Packet_descriptor;
+					Packet_descriptor::Payload
+						payload { .offset = request.offset,
+						          .bytes  = request.operation.count * _info.block_size };
+
+					Packet_descriptor packet(request.operation, payload, request.tag);
+
+					packet.succeeded(request.success);
+
+					packets[count++] = packet;
+				}
 
-				fn(ack);
+				tx_sink.try_ack_packets(packets, count);
 
-				if (!ack._submitted)
+				if (complete || max < parts_max)
 					break;
 			}
 		}
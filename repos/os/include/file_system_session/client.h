@@ -117,6 +117,11 @@ class File_system::Session_client : public Genode::Rpc_client<Session>
 		{
 			return call<Rpc_num_entries>(dir);
 		}
+
+		Genode::Dataspace_capability dataspace(File_handle file) override
+		{
+			return call<Rpc_dataspace>(file);
+		}
 };
 
 #endif /* _INCLUDE__FILE_SYSTEM_SESSION__CLIENT_H_ */
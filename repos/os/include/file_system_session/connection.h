@@ -61,7 +61,10 @@ struct File_system::Connection : Genode::Connection<Session>, Session_client
 	 * \param label            session label
 	 * \param root             root directory of session
 	 * \param writeable        session is writeable
-	 * \param tx_buf_size      size of transmission buffer in bytes
+	 * \param tx_buf_size      size of the bulk buffer in bytes
+	 *
+	 * The session quota covers the packet-descriptor queues in addition to
+	 * the bulk buffer of 'tx_buf_size' bytes.
 	 */
 	Connection(Genode::Env             &env,
 	           Genode::Range_allocator &tx_block_alloc,
@@ -71,10 +74,12 @@ struct File_system::Connection : Genode::Connection<Session>, Session_client
 	           size_t                   tx_buf_size = DEFAULT_TX_BUF_SIZE)
 	:
 		Genode::Connection<Session>(env, label,
-		                            Ram_quota { 8*1024*sizeof(long) + tx_buf_size },
+		                            Ram_quota { 8*1024*sizeof(long) + tx_buf_size
+		                                      + Session::tx_queues_size() },
 		                            Args("root=\"",      root, "\", "
 		                                 "writeable=",   writeable, ", "
-		                                 "tx_buf_size=", tx_buf_size)),
+		                                 "tx_buf_size=", tx_buf_size
+		                                               + Session::tx_queues_size())),
 		Session_client(cap(), tx_block_alloc, env.rm())
 	{ }
 
@@ -316,12 +316,30 @@ struct File_system::Directory_entry
 
 struct File_system::Session : public Genode::Session
 {
-	enum { TX_QUEUE_SIZE = 32 };
+	/*
+	 * Maximum number of packets in flight
+	 *
+	 * The packet-descriptor queues reside at the start of the transmission
+	 * buffer. Hence, the memory for the queues is paid by the client as part
+	 * of the 'tx_buf_size' session argument. Clients that use only a few
+	 * packets at a time merely leave queue entries unused.
+	 */
+	enum { TX_QUEUE_SIZE = 256 };
 
 	using Tx_policy = Genode::Packet_stream_policy<File_system::Packet_descriptor,
 	                                               TX_QUEUE_SIZE, TX_QUEUE_SIZE,
 	                                               char>;
 
+	/**
+	 * Return space occupied by the packet-descriptor queues within the
+	 * transmission buffer
+	 */
+	static constexpr Genode::size_t tx_queues_size()
+	{
+		return Genode::align_addr(sizeof(Tx_policy::Submit_queue)
+		                        + sizeof(Tx_policy::Ack_queue), 6);
+	}
+
 	using Tx = Packet_stream_tx::Channel<Tx_policy>;
 
 	/**
@@ -480,6 +498,22 @@ struct File_system::Session : public Genode::Session
 	 */
 	virtual unsigned num_entries(Dir_handle) = 0;
 
+	/**
+	 * Request dataspace with the content of a file
+	 *
+	 * The dataspace starts at file offset 0 and covers the file size as
+	 * reported by 'status'. It is meant to be mapped read-only and remains
+	 * valid until the file handle is closed. Modifications of the file
+	 * after the request are not reflected by the dataspace.
+	 *
+	 * An invalid capability is returned if the server cannot provide the
+	 * file content as dataspace or the session policy does not permit it.
+	 * In this case, the client must read the file via the packet stream.
+	 *
+	 * \throw Invalid_handle  file handle is invalid
+	 */
+	virtual Genode::Dataspace_capability dataspace(File_handle) = 0;
+
 
 	/*******************
 	 ** RPC interface **
@@ -534,11 +568,15 @@ struct File_system::Session : public Genode::Session
 	GENODE_RPC_THROW(Rpc_num_entries, unsigned, num_entries,
 	                 GENODE_TYPE_LIST(Invalid_handle),
 	                 Dir_handle);
+	GENODE_RPC_THROW(Rpc_dataspace, Genode::Dataspace_capability, dataspace,
+	                 GENODE_TYPE_LIST(Invalid_handle),
+	                 File_handle);
 
 	GENODE_RPC_INTERFACE(Rpc_tx_cap,
 	                     Rpc_file, Rpc_symlink, Rpc_dir, Rpc_node, Rpc_watch,
 	                     Rpc_close, Rpc_status, Rpc_control, Rpc_unlink,
-	                     Rpc_truncate, Rpc_move, Rpc_num_entries);
+	                     Rpc_truncate, Rpc_move, Rpc_num_entries,
+	                     Rpc_dataspace);
 };
 
 #endif /* _INCLUDE__FILE_SYSTEM_SESSION__FILE_SYSTEM_SESSION_H_ */
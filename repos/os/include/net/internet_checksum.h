@@ -42,6 +42,14 @@ namespace Net {
 
 	} __attribute__((packed));
 
+	/**
+	 * Return name of the accumulation variant used on this machine
+	 *
+	 * The 16-bit words of the checksum'd data are added up in a word-wide
+	 * fashion or via SIMD instructions, depending on the CPU.
+	 */
+	char const *internet_checksum_variant();
+
 	Genode::uint16_t internet_checksum(Packed_uint16 const *data_ptr,
 	                                   Genode::size_t       data_sz);
 
@@ -0,0 +1,99 @@
+/*
+ * \brief  Detection of compressed archives
+ * \author agent
+ * \date   2026-10-18
+ *
+ * Components that interpret TAR archives use this check to point out that
+ * a compressed archive must be decompressed first.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__OS__COMPRESSED_ARCHIVE_H_
+#define _INCLUDE__OS__COMPRESSED_ARCHIVE_H_
+
+#include <util/string.h>
+#include <base/output.h>
+
+namespace Genode { struct Compressed_archive; }
+
+
+/**
+ * Compression format of archive data, detected by its signature
+ */
+struct Genode::Compressed_archive
+{
+	enum class Format { NONE, GZIP, XZ, BZIP2, ZSTD };
+
+	static Format _format(char const *base, size_t size)
+	{
+		auto matches = [&] (size_t offset, char const *magic, size_t len) {
+			return size >= offset + len && memcmp(base + offset, magic, len) == 0; };
+
+		/*
+		 * Data with a valid ustar header is never regarded as compressed, as
+		 * the name of its first member may start with any signature.
+		 */
+		if (matches(257, "ustar", 5))
+			return Format::NONE;
+
+		/* the bzip2 header is followed by the magic of a block or the stream end */
+		auto bzip2 = [&] {
+			return matches(0, "BZh", 3) && size > 3 && base[3] >= '1' && base[3] <= '9'
+			    && (matches(4, "\x31\x41\x59\x26\x53\x59", 6)
+			     || matches(4, "\x17\x72\x45\x38\x50\x90", 6)); };
+
+		if (matches(0, "\x1f\x8b\x08",     3)) return Format::GZIP; /* deflate */
+		if (matches(0, "\xfd" "7zXZ\0",    6)) return Format::XZ;
+		if (matches(0, "\x28\xb5\x2f\xfd", 4)) return Format::ZSTD;
+		if (bzip2())                           return Format::BZIP2;
+
+		return Format::NONE;
+	}
+
+	Format const format;
+
+	Compressed_archive(char const *base, size_t size)
+	: format(_format(base, size)) { }
+
+	bool compressed() const { return format != Format::NONE; }
+
+	/**
+	 * Return true if the decompress_rom service can decompress the archive
+	 *
+	 * The libarchive of decompress_rom comes with the gzip and xz codecs
+	 * only.
+	 */
+	bool decompress_rom_supported() const {
+		return format == Format::GZIP || format == Format::XZ; }
+
+	/**
+	 * Print hint on how to access the compressed archive
+	 */
+	void print(Output &out) const
+	{
+		auto name = [&] {
+			switch (format) {
+			case Format::GZIP:  return "gzip";
+			case Format::XZ:    return "xz";
+			case Format::BZIP2: return "bzip2";
+			case Format::ZSTD:  return "zstd";
+			case Format::NONE:  break;
+			}
+			return "uncompressed";
+		};
+
+		Genode::print(out, "is a ", name(), "-compressed archive, ");
+		if (decompress_rom_supported())
+			Genode::print(out, "use the decompress_rom service to access it");
+		else
+			Genode::print(out, "decompress it before use");
+	}
+};
+
+#endif /* _INCLUDE__OS__COMPRESSED_ARCHIVE_H_ */
@@ -220,6 +220,46 @@ class Genode::Packet_descriptor_queue
 			return packet;
 		}
 
+		/**
+		 * Place up to 'count' packet descriptors into queue
+		 *
+		 * The head index is published only once after all descriptors of
+		 * the batch are stored.
+		 *
+		 * \return number of descriptors added
+		 */
+		unsigned add(PACKET_DESCRIPTOR const *packets, unsigned count)
+		{
+			unsigned const n    = Genode::min(count, slots_free());
+			unsigned const head = _head;
+
+			for (unsigned i = 0; i < n; i++)
+				_queue[(head + i)%QUEUE_SIZE] = packets[i];
+
+			_head = (head + n)%QUEUE_SIZE;
+			return n;
+		}
+
+		/**
+		 * Take up to 'max' packet descriptors from queue
+		 *
+		 * The tail index is published only once after all descriptors of
+		 * the batch are fetched.
+		 *
+		 * \return number of descriptors taken
+		 */
+		unsigned get(PACKET_DESCRIPTOR *packets, unsigned max)
+		{
+			unsigned const tail = _tail;
+			unsigned const n    = Genode::min(max, slots_used());
+
+			for (unsigned i = 0; i < n; i++)
+				packets[i] = _queue[(tail + i)%QUEUE_SIZE];
+
+			_tail = (tail + n)%QUEUE_SIZE;
+			return n;
+		}
+
 		/**
 		 * Return current packet descriptor
 		 */
@@ -255,6 +295,12 @@ class Genode::Packet_descriptor_queue
 		unsigned slots_free() {
 			return ((_tail > _head) ? _tail - _head
 			                        : QUEUE_SIZE - _head + _tail) - 1; }
+
+		/**
+		 * Return number of packet descriptors stored in the queue
+		 */
+		unsigned slots_used() {
+			return (QUEUE_SIZE - 1) - slots_free(); }
 };
 
 
@@ -340,6 +386,29 @@ class Genode::Packet_descriptor_transmitter
 			return true;
 		}
 
+		/**
+		 * Put a batch of packets into the tx queue
+		 *
+		 * Like the single-packet 'try_tx', the signal to the receiver is
+		 * deferred to 'tx_wakeup'. A wakeup is needed only if the queue was
+		 * empty before the batch was added.
+		 *
+		 * \return number of packets put into the queue
+		 */
+		unsigned try_tx(typename TX_QUEUE::Packet_descriptor const *packets,
+		                unsigned count)
+		{
+			Genode::Mutex::Guard mutex_guard(_tx_queue_mutex);
+
+			bool     const was_empty = _tx_queue->empty();
+			unsigned const n         = _tx_queue->add(packets, count);
+
+			if (n && was_empty)
+				_tx_wakeup_needed = true;
+
+			return n;
+		}
+
 		bool tx_wakeup()
 		{
 			Genode::Mutex::Guard mutex_guard(_tx_queue_mutex);
@@ -444,6 +513,29 @@ class Genode::Packet_descriptor_receiver
 			return packet;
 		}
 
+		/**
+		 * Take a batch of packets from the rx queue
+		 *
+		 * Like the single-packet 'try_rx', the signal to the transmitter is
+		 * deferred to 'rx_wakeup'. A wakeup is needed only if the queue was
+		 * full before the batch was taken.
+		 *
+		 * \return number of packets taken from the queue
+		 */
+		unsigned try_rx(typename RX_QUEUE::Packet_descriptor *packets,
+		                unsigned max)
+		{
+			Genode::Mutex::Guard mutex_guard(_rx_queue_mutex);
+
+			bool     const was_full = _rx_queue->full();
+			unsigned const n        = _rx_queue->get(packets, max);
+
+			if (n && was_full)
+				_rx_wakeup_needed = true;
+
+			return n;
+		}
+
 		bool rx_wakeup(bool omit_signal)
 		{
 			Genode::Mutex::Guard mutex_guard(_rx_queue_mutex);
@@ -771,6 +863,22 @@ class Genode::Packet_stream_source : private Packet_stream_base
 			return _submit_transmitter.try_tx(packet);
 		}
 
+		/**
+		 * Submit a batch of packets to the server if possible
+		 *
+		 * The submit queue is updated once for the whole batch. The sink is
+		 * not signalled before the next call of 'wakeup'.
+		 *
+		 * \return number of submitted packets, which is less than 'count'
+		 *         if the submit queue is congested
+		 *
+		 * This method never blocks.
+		 */
+		unsigned try_submit_packets(Packet_descriptor const *packets, unsigned count)
+		{
+			return _submit_transmitter.try_tx(packets, count);
+		}
+
 		/**
 		 * Wake up the packet sink if needed
 		 *
@@ -814,6 +922,21 @@ class Genode::Packet_stream_source : private Packet_stream_base
 			return _ack_receiver.try_rx();
 		}
 
+		/**
+		 * Fetch up to 'max' acknowledgements from sink
+		 *
+		 * The ack queue is updated once for the whole batch. The sink is
+		 * not signalled before the next call of 'wakeup'.
+		 *
+		 * \return number of packets stored at 'packets'
+		 *
+		 * This method never blocks.
+		 */
+		unsigned try_get_acked_packets(Packet_descriptor *packets, unsigned max)
+		{
+			return _ack_receiver.try_rx(packets, max);
+		}
+
 		/**
 		 * Release bulk-buffer space consumed by the packet
 		 */
@@ -930,6 +1053,21 @@ class Genode::Packet_stream_sink : private Packet_stream_base
 			return _submit_receiver.try_rx();
 		}
 
+		/**
+		 * Fetch up to 'max' packets from source
+		 *
+		 * The submit queue is updated once for the whole batch. The source
+		 * is not signalled before the next call of 'wakeup'.
+		 *
+		 * \return number of packets stored at 'packets'
+		 *
+		 * This method never blocks.
+		 */
+		unsigned try_get_packets(Packet_descriptor *packets, unsigned max)
+		{
+			return _submit_receiver.try_rx(packets, max);
+		}
+
 		/**
 		 * Wake up the packet source if needed
 		 *
@@ -1000,6 +1138,22 @@ class Genode::Packet_stream_sink : private Packet_stream_base
 			return _ack_transmitter.try_tx(packet);
 		}
 
+		/**
+		 * Acknowledge a batch of packets to the source if possible
+		 *
+		 * The ack queue is updated once for the whole batch. The source is
+		 * not signalled before the next call of 'wakeup'.
+		 *
+		 * \return number of acknowledged packets, which is less than
+		 *         'count' if the acknowledgement queue is congested
+		 *
+		 * This method never blocks.
+		 */
+		unsigned try_ack_packets(Packet_descriptor const *packets, unsigned count)
+		{
+			return _ack_transmitter.try_tx(packets, count);
+		}
+
 		void debug_print_buffers() {
 			Packet_stream_base::_debug_print_buffers(); }
 
@@ -0,0 +1,136 @@
+/*
+ * \brief  Moderation of the wakeup signals of a packet-stream session
+ * \author agent
+ * \date   2026-10-18
+ *
+ * A server that uses the non-blocking 'try_*' variants of the packet-stream
+ * API wakes up its peer by calling 'wakeup' on the packet-stream source and
+ * sink. Under high load, this results in one signal per small burst of
+ * packets. The moderator defers these wakeups until either a number of
+ * packets were handed over to the peer or a maximum delay has passed,
+ * similar to the interrupt coalescing of network adapters.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__OS__PACKET_STREAM_SIGNAL_MODERATOR_H_
+#define _INCLUDE__OS__PACKET_STREAM_SIGNAL_MODERATOR_H_
+
+/* Genode includes */
+#include <timer_session/connection.h>
+#include <util/reconstructible.h>
+#include <util/xml_node.h>
+
+namespace Genode { template <typename> class Packet_stream_signal_moderator; }
+
+
+template <typename OWNER>
+class Genode::Packet_stream_signal_moderator : Noncopyable
+{
+	public:
+
+		/**
+		 * Moderation policy
+		 *
+		 * Moderation is enabled only if 'max_delay' is non-zero because the
+		 * delay is what bounds the latency of packets that are deferred
+		 * while the packet threshold is not reached. A zero 'max_packets'
+		 * value moderates by time only.
+		 */
+		struct Policy
+		{
+			unsigned     max_packets;
+			Microseconds max_delay;
+
+			bool enabled() const { return max_delay.value > 0; }
+
+			static Policy from_xml(Xml_node const &node)
+			{
+				return {
+					.max_packets = node.attribute_value("signal_max_packets", 0U),
+					.max_delay   = Microseconds {
+						node.attribute_value("signal_max_delay_us", (uint64_t)0) } };
+			}
+		};
+
+	private:
+
+		using Wakeup_method = void (OWNER::*)();
+		using Timeout       = Timer::One_shot_timeout<Packet_stream_signal_moderator>;
+
+		OWNER               &_owner;
+		Wakeup_method const  _wakeup;
+		Policy               _policy   { 0, Microseconds { 0 } };
+		unsigned             _deferred { 0 };
+		Constructible<Timeout> _timeout { };
+
+		void _flush()
+		{
+			_deferred = 0;
+			(_owner.*_wakeup)();
+		}
+
+		void _handle_timeout(Duration) { _flush(); }
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param wakeup  method of 'owner' that calls 'wakeup' on the
+		 *                packet-stream source and sink
+		 *
+		 * Moderation is disabled until 'enable' is called.
+		 */
+		Packet_stream_signal_moderator(OWNER &owner, Wakeup_method wakeup)
+		:
+			_owner(owner), _wakeup(wakeup)
+		{ }
+
+		/**
+		 * Apply moderation policy
+		 *
+		 * The timer is used only if the policy enables moderation.
+		 */
+		void enable(Timer::Connection &timer, Policy const &policy)
+		{
+			_policy = policy;
+			if (_policy.enabled())
+				_timeout.construct(timer, *this,
+				                   &Packet_stream_signal_moderator::_handle_timeout);
+			else
+				_timeout.destruct();
+		}
+
+		bool enabled() const { return _timeout.constructed(); }
+
+		/**
+		 * Account packets or acknowledgements handed over to the peer
+		 */
+		void submitted(unsigned count = 1) { _deferred += count; }
+
+		/**
+		 * Wake up the peer, possibly deferred according to the policy
+		 */
+		void wakeup()
+		{
+			if (!_timeout.constructed() || !_deferred) {
+				(_owner.*_wakeup)();
+				return;
+			}
+			if (_policy.max_packets && _deferred >= _policy.max_packets) {
+				_timeout->discard();
+				_flush();
+				return;
+			}
+			if (!_timeout->scheduled())
+				_timeout->schedule(_policy.max_delay);
+		}
+};
+
+#endif /* _INCLUDE__OS__PACKET_STREAM_SIGNAL_MODERATOR_H_ */
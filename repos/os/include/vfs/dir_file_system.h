@@ -159,6 +159,211 @@ class Vfs::Dir_file_system : public File_system
 		using Name = String<MAX_NAME_LEN>;
 		Name const _name;
 
+		/**
+		 * Sub file systems that may serve a path, keyed by its first element
+		 *
+		 * A path can only be served by the sub directories named after its
+		 * first element and by the sub file systems that are no directories.
+		 * For each name of a sub directory, the table holds these candidates
+		 * in the order of the configuration. Path operations thereby skip
+		 * the sub directories of other names, which makes the resolution of
+		 * a path proportional to its depth rather than to the size of the
+		 * VFS configuration.
+		 */
+		class Mount_table
+		{
+			public:
+
+				struct Candidates
+				{
+					File_system * const *first;
+					unsigned             count;
+
+					File_system * const *begin() const { return first; }
+					File_system * const *end()   const { return first + count; }
+				};
+
+			private:
+
+				Genode::Allocator &_alloc;
+
+				struct Route
+				{
+					char const   *name;   /* name of sub directories */
+					Candidates    candidates;
+				};
+
+				Route      *_routes     = nullptr;  /* sorted by name */
+				unsigned    _num_routes = 0;
+				unsigned    _max_routes = 0;
+
+				Candidates  _all    { nullptr, 0 };  /* all sub file systems */
+				Candidates  _others { nullptr, 0 };  /* candidates of other names */
+
+				/*
+				 * Noncopyable
+				 */
+				Mount_table(Mount_table const &);
+				Mount_table &operator = (Mount_table const &);
+
+				/**
+				 * Return name of sub directory 'fs' used as key, or nullptr
+				 *
+				 * Sub directories with an empty name or with a name that
+				 * spans multiple path elements are treated like other file
+				 * systems, i.e., they are candidates for any path.
+				 */
+				static char const *_key(File_system &fs)
+				{
+					if (strcmp(fs.type(), "dir") != 0)
+						return nullptr;
+
+					char const *name = static_cast<Dir_file_system &>(fs)._name.string();
+
+					for (char const *c = name; *c; c++)
+						if (*c == '/')
+							return nullptr;
+
+					return *name ? name : nullptr;
+				}
+
+				/**
+				 * Compare 'name' with path element of 'len' characters
+				 */
+				static int _compare(char const *name, char const *element, size_t len)
+				{
+					int const res = strcmp(name, element, len);
+					return res ? res : (name[len] ? 1 : 0);
+				}
+
+				File_system **_alloc_array(unsigned count)
+				{
+					return (File_system **)_alloc.alloc(sizeof(File_system *)*Genode::max(count, 1U));
+				}
+
+				void _free_array(Candidates const &candidates)
+				{
+					if (candidates.first)
+						_alloc.free((void *)candidates.first,
+						            sizeof(File_system *)*Genode::max(candidates.count, 1U));
+				}
+
+				void _release()
+				{
+					for (unsigned i = 0; i < _num_routes; i++)
+						_free_array(_routes[i].candidates);
+
+					if (_routes)
+						_alloc.free(_routes, sizeof(Route)*Genode::max(_max_routes, 1U));
+
+					_free_array(_all);
+					_free_array(_others);
+
+					_routes = nullptr; _num_routes = 0; _max_routes = 0;
+					_all = { nullptr, 0 }; _others = { nullptr, 0 };
+				}
+
+			public:
+
+				Mount_table(Genode::Allocator &alloc) : _alloc(alloc) { }
+
+				~Mount_table() { _release(); }
+
+				/**
+				 * Build table for the list of sub file systems at 'first'
+				 */
+				void update(File_system *first)
+				{
+					_release();
+
+					unsigned num_fs = 0, num_others = 0;
+					for (File_system *fs = first; fs; fs = fs->next, num_fs++)
+						if (!_key(*fs))
+							num_others++;
+
+					File_system **all    = _alloc_array(num_fs);
+					File_system **others = _alloc_array(num_others);
+					_max_routes = num_fs - num_others;
+					_routes     = (Route *)_alloc.alloc(sizeof(Route)*Genode::max(_max_routes, 1U));
+
+					unsigned i = 0, j = 0;
+					for (File_system *fs = first; fs; fs = fs->next) {
+						all[i++] = fs;
+						if (!_key(*fs))
+							others[j++] = fs;
+					}
+					_all    = { all,    num_fs };
+					_others = { others, num_others };
+
+					/* insert a route per distinct name in sorted order */
+					for (File_system *fs = first; fs; fs = fs->next) {
+
+						char const * const name = _key(*fs);
+						if (!name)
+							continue;
+
+						unsigned pos = 0;
+						for (; pos < _num_routes; pos++)
+							if (strcmp(_routes[pos].name, name) >= 0)
+								break;
+
+						if (pos < _num_routes && strcmp(_routes[pos].name, name) == 0)
+							continue;
+
+						for (unsigned k = _num_routes; k > pos; k--)
+							_routes[k] = _routes[k - 1];
+
+						/* candidates are other file systems and directories named 'name' */
+						unsigned count = 0;
+						for (File_system *c = first; c; c = c->next)
+							if (!_key(*c) || strcmp(_key(*c), name) == 0)
+								count++;
+
+						File_system **candidates = _alloc_array(count);
+						unsigned n = 0;
+						for (File_system *c = first; c; c = c->next)
+							if (!_key(*c) || strcmp(_key(*c), name) == 0)
+								candidates[n++] = c;
+
+						_routes[pos] = { name, { candidates, count } };
+						_num_routes++;
+					}
+				}
+
+				/**
+				 * Return sub file systems that may serve 'path'
+				 */
+				Candidates candidates(char const *path) const
+				{
+					if (path[0] == '/')
+						path++;
+
+					size_t len = 0;
+					while (path[len] && path[len] != '/')
+						len++;
+
+					/* the directory itself involves all sub file systems */
+					if (len == 0)
+						return _all;
+
+					unsigned lo = 0, hi = _num_routes;
+					while (lo < hi) {
+						unsigned const mid = (lo + hi)/2;
+						int const res = _compare(_routes[mid].name, path, len);
+						if (res == 0)
+							return _routes[mid].candidates;
+						if (res < 0)
+							lo = mid + 1;
+						else
+							hi = mid;
+					}
+					return _others;
+				}
+		} _mount_table { _env.alloc() };
+
+		Mount_table::Candidates _candidates(char const *path) const {
+			return _mount_table.candidates(path); }
+
 		/**
 		 * Returns if path corresponds to top directory of file system
 		 */
@@ -209,7 +414,7 @@ class Vfs::Dir_file_system : public File_system
 			 * Propagate the request into all of our file systems. If at least
 			 * one operation succeeds, we return success.
 			 */
-			for (File_system *fs = _first_file_system; fs; fs = fs->next) {
+			for (File_system *fs : _candidates(path)) {
 
 				RES const err = fn(*fs, path);
 
@@ -268,7 +473,7 @@ class Vfs::Dir_file_system : public File_system
 		file_size _sum_dirents_of_file_systems(char const *path)
 		{
 			file_size cnt = 0;
-			for (File_system *fs = _first_file_system; fs; fs = fs->next) {
+			for (File_system *fs : _candidates(path)) {
 				cnt += fs->num_dirent(path);
 			}
 			return cnt;
@@ -396,6 +601,8 @@ class Vfs::Dir_file_system : public File_system
 
 				Genode::error("failed to create VFS node: ", sub_node);
 			}
+
+			_mount_table.update(_first_file_system);
 		}
 
 		/*********************************
@@ -412,8 +619,7 @@ class Vfs::Dir_file_system : public File_system
 			 * Query sub file systems for dataspace using the path local to
 			 * the respective file system
 			 */
-			File_system *fs = _first_file_system;
-			for (; fs; fs = fs->next) {
+			for (File_system *fs : _candidates(path)) {
 				Dataspace_capability ds = fs->dataspace(path);
 				if (ds.valid())
 					return ds;
@@ -428,7 +634,7 @@ class Vfs::Dir_file_system : public File_system
 			if (!path)
 				return;
 
-			for (File_system *fs = _first_file_system; fs; fs = fs->next)
+			for (File_system *fs : _candidates(path))
 				fs->release(path, ds_cap);
 		}
 
@@ -460,7 +666,7 @@ class Vfs::Dir_file_system : public File_system
 			 * The given path refers to one of our sub directories.
 			 * Propagate the request into our file systems.
 			 */
-			for (File_system *fs = _first_file_system; fs; fs = fs->next) {
+			for (File_system *fs : _candidates(path)) {
 
 				Stat_result const err = fs->stat(path, out);
 
@@ -517,7 +723,7 @@ class Vfs::Dir_file_system : public File_system
 			if (strlen(path) == 0)
 				return true;
 
-			for (File_system *fs = _first_file_system; fs; fs = fs->next)
+			for (File_system *fs : _candidates(path))
 				if (fs->directory(path))
 					return true;
 
@@ -533,7 +739,7 @@ class Vfs::Dir_file_system : public File_system
 			if (strlen(path) == 0)
 				return path;
 
-			for (File_system *fs = _first_file_system; fs; fs = fs->next) {
+			for (File_system *fs : _candidates(path)) {
 				char const *leaf_path = fs->leaf_path(path);
 				if (leaf_path)
 					return leaf_path;
@@ -584,7 +790,7 @@ class Vfs::Dir_file_system : public File_system
 			}
 
 			/* path refers to any of our sub file systems */
-			for (File_system *fs = _first_file_system; fs; fs = fs->next) {
+			for (File_system *fs : _candidates(path)) {
 
 				Open_result const err = fs->open(path, mode, out_handle, alloc);
 				switch (err) {
@@ -632,7 +838,7 @@ class Vfs::Dir_file_system : public File_system
 				res = OPENDIR_OK;
 			}
 			try {
-				for (File_system *fs = _first_file_system; fs; fs = fs->next) {
+				for (File_system *fs : _candidates(sub_path)) {
 					Vfs_handle *sub_dir_handle = nullptr;
 
 					Opendir_result r = fs->opendir(
@@ -785,7 +991,7 @@ class Vfs::Dir_file_system : public File_system
 			char const *sub_path = _sub_path(path);
 			if (!sub_path) return res;
 
-			for (File_system *fs = _first_file_system; fs; fs = fs->next) {
+			for (File_system *fs : _candidates(sub_path)) {
 				Vfs_watch_handle *sub_handle;
 
 				if (fs->watch(sub_path, &sub_handle, alloc) == WATCH_OK) {
@@ -846,7 +1052,7 @@ class Vfs::Dir_file_system : public File_system
 				return RENAME_ERR_CROSS_FS;
 
 			Rename_result final = RENAME_ERR_NO_ENTRY;
-			for (File_system *fs = _first_file_system; fs; fs = fs->next) {
+			for (File_system *fs : _candidates(from_path)) {
 				switch (fs->rename(from_path, to_path)) {
 				case RENAME_OK:           return RENAME_OK;
 				case RENAME_ERR_NO_ENTRY: continue;
@@ -881,6 +1087,8 @@ class Vfs::Dir_file_system : public File_system
 
 				curr->apply_config(node.sub_node(i));
 			}
+
+			_mount_table.update(_first_file_system);
 		}
 
 
@@ -0,0 +1,4 @@
+REQUIRES = arm_64
+INC_DIR += $(REP_DIR)/src/lib/net/spec/arm_64
+
+include $(REP_DIR)/lib/mk/net.mk
@@ -0,0 +1,4 @@
+REQUIRES = x86 64bit
+INC_DIR += $(REP_DIR)/src/lib/net/spec/x86_64
+
+include $(REP_DIR)/lib/mk/net.mk
@@ -1,4 +1,7 @@
-MIRROR_FROM_REP_DIR := lib/mk/net.mk include/net src/lib/net
+MIRROR_FROM_REP_DIR := lib/mk/net.mk \
+                       lib/mk/spec/x86_64/net.mk \
+                       lib/mk/spec/arm_64/net.mk \
+                       include/net src/lib/net
 
 content: $(MIRROR_FROM_REP_DIR)
 
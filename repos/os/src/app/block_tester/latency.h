@@ -0,0 +1,161 @@
+/*
+ * \brief  Block session testing - request latency histogram
+ * \author agent
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _LATENCY_H_
+#define _LATENCY_H_
+
+/* Genode includes */
+#include <util/misc_math.h>
+
+namespace Test {
+
+	using namespace Genode;
+
+	struct Latency;
+	struct Latency_histogram;
+}
+
+
+/*
+ * Summary of the request latencies in microseconds
+ */
+struct Test::Latency
+{
+	uint64_t count { 0 };
+	uint64_t min   { 0 };
+	uint64_t max   { 0 };
+	uint64_t avg   { 0 };
+	uint64_t p50   { 0 };
+	uint64_t p99   { 0 };
+	uint64_t p999  { 0 };
+
+	void print(Genode::Output &out) const
+	{
+		Genode::print(out, "lat_min:",  min,  " ",
+		                   "lat_avg:",  avg,  " ",
+		                   "lat_p50:",  p50,  " ",
+		                   "lat_p99:",  p99,  " ",
+		                   "lat_p999:", p999, " ",
+		                   "lat_max:",  max);
+	}
+};
+
+
+/*
+ * Histogram of request latencies in microseconds
+ *
+ * Values below 'SUB_BUCKETS' are counted exactly. Above, each power of two
+ * is divided into 'SUB_BUCKETS' linear buckets, which limits the error of
+ * the reported percentiles to 1/SUB_BUCKETS of the value while covering
+ * the whole 64-bit range with a few hundred counters.
+ */
+struct Test::Latency_histogram
+{
+	enum {
+		SUB_BUCKETS_LOG2 = 3,
+		SUB_BUCKETS      = 1u << SUB_BUCKETS_LOG2,
+		NUM_BUCKETS      = (64 - SUB_BUCKETS_LOG2 + 1) * SUB_BUCKETS,
+	};
+
+	uint64_t _buckets[NUM_BUCKETS] { };
+
+	uint64_t _count { 0 };
+	uint64_t _sum   { 0 };
+	uint64_t _min   { ~0ull };
+	uint64_t _max   { 0 };
+
+	static unsigned _index(uint64_t value)
+	{
+		if (value < SUB_BUCKETS)
+			return (unsigned)value;
+
+		unsigned const e = (unsigned)Genode::log2(value);
+		unsigned const m = (unsigned)(value >> (e - SUB_BUCKETS_LOG2));
+
+		return (e - SUB_BUCKETS_LOG2 + 1) * SUB_BUCKETS + (m - SUB_BUCKETS);
+	}
+
+	/**
+	 * Return largest value counted in bucket 'index'
+	 */
+	static uint64_t _upper_bound(unsigned index)
+	{
+		if (index < SUB_BUCKETS)
+			return index;
+
+		unsigned const shift = index / SUB_BUCKETS - 1;
+		uint64_t const m     = SUB_BUCKETS + index % SUB_BUCKETS;
+
+		return ((m + 1) << shift) - 1;
+	}
+
+	void add(uint64_t value)
+	{
+		_buckets[_index(value)]++;
+
+		_count++;
+		_sum += value;
+		_min  = Genode::min(_min, value);
+		_max  = Genode::max(_max, value);
+	}
+
+	void reset() { *this = Latency_histogram { }; }
+
+	uint64_t count() const { return _count; }
+
+	/**
+	 * Return value below or at which 'ppm' parts per million of all
+	 * values are located
+	 */
+	uint64_t percentile(uint64_t ppm) const
+	{
+		if (!_count)
+			return 0;
+
+		uint64_t const target = (_count * ppm + 999'999) / 1'000'000;
+
+		uint64_t sum = 0;
+		for (unsigned i = 0; i < NUM_BUCKETS; i++) {
+			sum += _buckets[i];
+			if (sum >= Genode::max(target, 1ull))
+				return Genode::min(_upper_bound(i), _max);
+		}
+		return _max;
+	}
+
+	Latency summary() const
+	{
+		if (!_count)
+			return Latency { };
+
+		return Latency { .count = _count,
+		                 .min   = _min,
+		                 .max   = _max,
+		                 .avg   = _sum / _count,
+		                 .p50   = percentile(500'000),
+		                 .p99   = percentile(990'000),
+		                 .p999  = percentile(999'000) };
+	}
+
+	/**
+	 * Call 'fn(uint64_t upper_bound, uint64_t count)' for each used bucket
+	 */
+	void for_each_bucket(auto const &fn) const
+	{
+		for (unsigned i = 0; i < NUM_BUCKETS; i++)
+			if (_buckets[i])
+				fn(_upper_bound(i), _buckets[i]);
+	}
+};
+
+#endif /* _LATENCY_H_ */
@@ -21,6 +21,8 @@
 #include <os/reporter.h>
 #include <timer_session/connection.h>
 
+/* local includes */
+#include <latency.h>
 
 namespace Test {
 
@@ -67,6 +69,8 @@ struct Test::Result
 	uint64_t block_size   { 0 };
 	size_t   triggered    { 0 };
 	bool     success      { false };
+	size_t   batch        { 0 };
+	Latency  latency      { };
 
 	bool   calculate { false };
 	double mibs      { 0.0f };
@@ -101,6 +105,7 @@ struct Test::Result
 			Genode::print(out, "mibs:", mibs, " iops:", iops);
 		}
 
+		Genode::print(out, " batch:", batch, " ", latency);
 		Genode::print(out, " triggered:", triggered);
 		Genode::print(out, " result:", success ? "ok" : "failed");
 	}
@@ -131,6 +136,34 @@ struct Test::Test_base : private Genode::Fifo<Test_base>::Element
 
 		Constructible<Timer::Periodic_timeout<Test_base>> _progress_timeout { };
 
+		Reporter &_progress_reporter;
+
+		/* latencies of all requests and of the current progress interval */
+		Latency_histogram _latency          { };
+		Latency_histogram _interval_latency { };
+
+		/*
+		 * Throughput and latency of one progress interval
+		 */
+		struct Sample
+		{
+			uint64_t time;   /* end of interval in ms since start */
+			uint64_t bytes;
+			uint64_t ops;
+			Latency  latency;
+		};
+
+		enum { MAX_SAMPLES = 64 };
+
+		Sample   _samples[MAX_SAMPLES] { };
+		unsigned _num_samples  { 0 };
+		unsigned _next_sample  { 0 };
+		uint64_t _sample_time  { 0 };
+		size_t   _sample_bytes { 0 };
+		unsigned _sample_ops   { 0 };
+
+		uint64_t _now_us() { return _timer->curr_time().trunc_to_plain_us().value; }
+
 		Allocator_avl _block_alloc { &_alloc };
 
 		struct Job;
@@ -141,13 +174,25 @@ struct Test::Test_base : private Genode::Fifo<Test_base>::Element
 		struct Job : Block_connection::Job
 		{
 			unsigned const id;
+			uint64_t const submit_us;
 
-			Job(Block_connection &connection, Block::Operation operation, unsigned id)
+			Job(Block_connection &connection, Block::Operation operation,
+			    unsigned id, uint64_t submit_us)
 			:
-				Block_connection::Job(connection, operation), id(id)
+				Block_connection::Job(connection, operation), id(id),
+				submit_us(submit_us)
 			{ }
 		};
 
+		/*
+		 * Create job for 'operation', the latency is measured from here on
+		 */
+		void _submit_job(Block::Operation const &operation)
+		{
+			_job_cnt++;
+			new (_alloc) Job(*_block, operation, _job_cnt, _now_us());
+		}
+
 		/*
 		 * Must be called by every test when it has finished
 		 */
@@ -157,6 +202,8 @@ struct Test::Test_base : private Genode::Fifo<Test_base>::Element
 		{
 			_end_time = _timer->elapsed_ms();
 
+			_progress_timeout.destruct();
+
 			_finished = true;
 			if (_finished_sig.valid()) {
 				Genode::Signal_transmitter(_finished_sig).submit();
@@ -241,6 +288,10 @@ struct Test::Test_base : private Genode::Fifo<Test_base>::Element
 			if (!success)
 				error("processing ", job.operation(), " failed");
 
+			uint64_t const latency = _now_us() - job.submit_us;
+			_latency.add(latency);
+			_interval_latency.add(latency);
+
 			destroy(_alloc, &job);
 
 			if (!success && _stop_on_error)
@@ -259,9 +310,63 @@ struct Test::Test_base : private Genode::Fifo<Test_base>::Element
 
 	protected:
 
+		void _generate_progress_report()
+		{
+			if (!_progress_reporter.enabled())
+				return;
+
+			try {
+				Reporter::Xml_generator xml(_progress_reporter, [&] () {
+					xml.attribute("test",  name());
+					xml.attribute("batch", _batch);
+
+					unsigned const first = (_next_sample + MAX_SAMPLES - _num_samples)
+					                     % MAX_SAMPLES;
+					for (unsigned i = 0; i < _num_samples; i++) {
+						Sample const &s = _samples[(first + i) % MAX_SAMPLES];
+						xml.node("sample", [&] () {
+							xml.attribute("time",     s.time);
+							xml.attribute("bytes",    s.bytes);
+							xml.attribute("ops",      s.ops);
+							xml.attribute("lat_p50",  s.latency.p50);
+							xml.attribute("lat_p99",  s.latency.p99);
+							xml.attribute("lat_p999", s.latency.p999);
+							xml.attribute("lat_max",  s.latency.max);
+						});
+					}
+				});
+			} catch (...) { warning("could not generate progress report"); }
+		}
+
 		void _handle_progress_timeout(Duration)
 		{
-			log("progress: rx:", _rx, " tx:", _tx);
+			uint64_t const now = _timer->elapsed_ms();
+
+			Sample const sample {
+				.time    = now - _start_time,
+				.bytes   = _bytes - _sample_bytes,
+				.ops     = _completed - _sample_ops,
+				.latency = _interval_latency.summary() };
+
+			uint64_t const interval = max(now - _sample_time, 1ull);
+			double   const mibs = ((double)sample.bytes / ((double)interval/1000))
+			                    / (1024 * 1024);
+			double   const iops = (double)sample.ops / ((double)interval/1000);
+
+			log("progress: rx:", _rx, " tx:", _tx, " mibs:", mibs, " iops:", iops,
+			    " lat_p50:", sample.latency.p50, " lat_p99:", sample.latency.p99,
+			    " lat_p999:", sample.latency.p999);
+
+			_samples[_next_sample] = sample;
+			_next_sample = (_next_sample + 1) % MAX_SAMPLES;
+			_num_samples = min(_num_samples + 1, (unsigned)MAX_SAMPLES);
+
+			_sample_time  = now;
+			_sample_bytes = _bytes;
+			_sample_ops   = _completed;
+			_interval_latency.reset();
+
+			_generate_progress_report();
 		}
 
 		void _handle_block_io()
@@ -279,7 +384,8 @@ struct Test::Test_base : private Genode::Fifo<Test_base>::Element
 
 		Test_base(Env &env, Allocator &alloc, Xml_node node,
 		          Signal_context_capability finished_sig,
-		          Scratch_buffer &scratch_buffer)
+		          Scratch_buffer &scratch_buffer,
+		          Reporter &progress_reporter, size_t batch)
 		:
 			_env(env), _alloc(alloc), _node(node),
 			_verbose(node.attribute_value("verbose", false)),
@@ -287,15 +393,11 @@ struct Test::Test_base : private Genode::Fifo<Test_base>::Element
 			                                 Number_of_bytes(4*1024*1024))),
 			_progress_interval(_node.attribute_value("progress", (uint64_t)0)),
 			_copy(_node.attribute_value("copy", true)),
-			_batch(_node.attribute_value("batch", 1u)),
+			_batch(batch),
+			_progress_reporter(progress_reporter),
 			_finished_sig(finished_sig),
 			_scratch_buffer(scratch_buffer)
-		{
-			if (_progress_interval)
-				_progress_timeout.construct(*_timer, *this,
-				                            &Test_base::_handle_progress_timeout,
-				                            Microseconds(_progress_interval*1000));
-		}
+		{ }
 
 		virtual ~Test_base() { };
 
@@ -303,6 +405,9 @@ struct Test::Test_base : private Genode::Fifo<Test_base>::Element
 		{
 			_stop_on_error = stop_on_error;
 
+			/* needed for time-stamping the initial jobs */
+			_timer.construct(_env);
+
 			_block.construct(_env, &_block_alloc, _io_buffer);
 			_block->sigh(_block_io_sigh);
 			_info = _block->info();
@@ -312,8 +417,13 @@ struct Test::Test_base : private Genode::Fifo<Test_base>::Element
 			for (unsigned i = 0; i < _batch; i++)
 				_spawn_job();
 
-			_timer.construct(_env);
-			_start_time = _timer->elapsed_ms();
+			_start_time  = _timer->elapsed_ms();
+			_sample_time = _start_time;
+
+			if (_progress_interval)
+				_progress_timeout.construct(*_timer, *this,
+				                            &Test_base::_handle_progress_timeout,
+				                            Microseconds(_progress_interval*1000));
 
 			_handle_block_io();
 		}
@@ -322,6 +432,10 @@ struct Test::Test_base : private Genode::Fifo<Test_base>::Element
 		 ** Test interface **
 		 ********************/
 
+		size_t batch() const { return _batch; }
+
+		Latency_histogram const &latency() const { return _latency; }
+
 		virtual void _init() = 0;
 		virtual void _spawn_job() = 0;
 		virtual Result result() = 0;
@@ -353,6 +467,12 @@ struct Test::Main
 	bool const _report {
 		_config_rom.xml().attribute_value("report", false) };
 
+	bool const _report_histogram {
+		_config_rom.xml().attribute_value("histogram", false) };
+
+	bool const _report_progress {
+		_config_rom.xml().attribute_value("progress_report", false) };
+
 	bool const _calculate {
 		_config_rom.xml().attribute_value("calculate", true) };
 
@@ -369,12 +489,14 @@ struct Test::Main
 	{
 		Genode::String<32> name { };
 		Test::Result result { };
+		Latency_histogram histogram { };
 
 		Test_result(char const *name) : name(name) { };
 	};
 	Genode::Fifo<Test_result> _results { };
 
-	Genode::Reporter _result_reporter { _env, "results" };
+	Genode::Reporter _result_reporter   { _env, "results" };
+	Genode::Reporter _progress_reporter { _env, "progress" };
 
 	void _generate_report()
 	{
@@ -389,6 +511,13 @@ struct Test::Main
 						xml.attribute("size",     tr.result.request_size);
 						xml.attribute("bsize",    tr.result.block_size);
 						xml.attribute("duration", tr.result.duration);
+						xml.attribute("batch",    tr.result.batch);
+						xml.attribute("lat_min",  tr.result.latency.min);
+						xml.attribute("lat_avg",  tr.result.latency.avg);
+						xml.attribute("lat_p50",  tr.result.latency.p50);
+						xml.attribute("lat_p99",  tr.result.latency.p99);
+						xml.attribute("lat_p999", tr.result.latency.p999);
+						xml.attribute("lat_max",  tr.result.latency.max);
 
 						if (_calculate) {
 							/* XXX */
@@ -397,6 +526,16 @@ struct Test::Main
 						}
 
 						xml.attribute("result", tr.result.success ? 0 : 1);
+
+						if (_report_histogram)
+							xml.node("latency", [&] () {
+								tr.histogram.for_each_bucket([&] (uint64_t upper, uint64_t count) {
+									xml.node("bucket", [&] () {
+										xml.attribute("max",   upper);
+										xml.attribute("count", count);
+									});
+								});
+							});
 					});
 				});
 			});
@@ -416,6 +555,8 @@ struct Test::Main
 			if (!r.success) { _success = false; }
 
 			r.calculate = _calculate;
+			r.batch     = _current->batch();
+			r.latency   = _current->latency().summary();
 
 			if (_log) {
 				Genode::log("finished ", _current->name(), " ", r);
@@ -424,6 +565,8 @@ struct Test::Main
 			if (_report) {
 				Test_result *tr = new (&_heap) Test_result(_current->name());
 				tr->result = r;
+				if (_report_histogram)
+					tr->histogram = _current->latency();
 				_results.enqueue(*tr);
 
 				_generate_report();
@@ -466,28 +609,59 @@ struct Test::Main
 			Genode::Xml_node tests = config.sub_node("tests");
 			tests.for_each_sub_node([&] (Genode::Xml_node node) {
 
-				if (node.has_type("ping_pong")) {
-					Test_base *t = new (&_heap)
-						Ping_pong(_env, _heap, node, _finished_sigh, _scratch_buffer);
-					_tests.enqueue(*t);
-				} else
-
-				if (node.has_type("random")) {
-					Test_base *t = new (&_heap)
-						Random(_env, _heap, node, _finished_sigh, _scratch_buffer);
-					_tests.enqueue(*t);
-				} else
-
-				if (node.has_type("replay")) {
-					Test_base *t = new (&_heap)
-						Replay(_env, _heap, node, _finished_sigh, _scratch_buffer);
-					_tests.enqueue(*t);
-				} else
-
-				if (node.has_type("sequential")) {
-					Test_base *t = new (&_heap)
-						Sequential(_env, _heap, node, _finished_sigh, _scratch_buffer);
-					_tests.enqueue(*t);
+				auto construct = [&] (size_t batch)
+				{
+					if (node.has_type("ping_pong")) {
+						Test_base *t = new (&_heap)
+							Ping_pong(_env, _heap, node, _finished_sigh, _scratch_buffer,
+							          _progress_reporter, batch);
+						_tests.enqueue(*t);
+					} else
+
+					if (node.has_type("random")) {
+						Test_base *t = new (&_heap)
+							Random(_env, _heap, node, _finished_sigh, _scratch_buffer,
+							       _progress_reporter, batch);
+						_tests.enqueue(*t);
+					} else
+
+					if (node.has_type("replay")) {
+						Test_base *t = new (&_heap)
+							Replay(_env, _heap, node, _finished_sigh, _scratch_buffer,
+							       _progress_reporter, batch);
+						_tests.enqueue(*t);
+					} else
+
+					if (node.has_type("sequential")) {
+						Test_base *t = new (&_heap)
+							Sequential(_env, _heap, node, _finished_sigh, _scratch_buffer,
+							           _progress_reporter, batch);
+						_tests.enqueue(*t);
+					}
+				};
+
+				/*
+				 * A 'queue_depths' list, e.g., "1,4,16", executes the test
+				 * once for each number of jobs in flight
+				 */
+				using Depths = Genode::String<128>;
+				Depths const depths = node.attribute_value("queue_depths", Depths());
+
+				if (!depths.valid()) {
+					construct(node.attribute_value("batch", 1u));
+					return;
+				}
+
+				for (char const *p = depths.string(); *p; ) {
+					unsigned long depth = 0;
+					size_t const n = Genode::ascii_to(p, depth);
+					if (!n) {
+						p++;
+						continue;
+					}
+					if (depth)
+						construct(depth);
+					p += n;
 				}
 			});
 		} catch (...) { Genode::error("invalid tests"); }
@@ -499,6 +673,7 @@ struct Test::Main
 	Main(Genode::Env &env) : _env(env)
 	{
 		_result_reporter.enabled(_report);
+		_progress_reporter.enabled(_report_progress);
 
 		try {
 			_construct_tests(_config_rom.xml());
@@ -42,8 +42,6 @@ struct Test::Ping_pong : Test_base
 		if (_bytes >= _length)
 			return;
 
-		_job_cnt++;
-
 		block_number_t const lba = _ping ? _start : _end - _start;
 		_ping = !_ping;
 
@@ -51,7 +49,7 @@ struct Test::Ping_pong : Test_base
 		                                   .block_number = lba,
 		                                   .count        = _size_in_blocks };
 
-		new (_alloc) Job(*_block, operation, _job_cnt);
+		_submit_job(operation);
 
 		_start += _size_in_blocks;
 	}
@@ -141,8 +141,6 @@ struct Test::Random : Test_base
 		if (_bytes >= _length)
 			return;
 
-		_job_cnt++;
-
 		block_number_t const lba = _next_block();
 
 		Block::Operation::Type const op_type =
@@ -154,7 +152,7 @@ struct Test::Random : Test_base
 		                                   .block_number = lba,
 		                                   .count        = _size_in_blocks };
 
-		new (_alloc) Job(*_block, operation, _job_cnt);
+		_submit_job(operation);
 	}
 
 	Result result() override
@@ -54,8 +54,7 @@ struct Test::Replay : Test_base
 					.count        = request.attribute_value("count", 0UL)
 				};
 
-				_job_cnt++;
-				new (&_alloc) Job(*_block, operation, _job_cnt);
+				_submit_job(operation);
 			});
 		} catch (...) {
 			error("could not read request list");
@@ -63,13 +63,11 @@ struct Test::Sequential : Test_base
 		if (_bytes >= _length || _start >= _end)
 			return;
 
-		_job_cnt++;
-
 		Block::Operation const operation { .type         = _op_type,
 		                                   .block_number = _start,
 		                                   .count        = _size_in_blocks };
 
-		new (_alloc) Job(*_block, operation, _job_cnt);
+		_submit_job(operation);
 
 		_start += _size_in_blocks;
 	}
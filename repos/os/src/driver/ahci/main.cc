@@ -320,11 +320,19 @@ struct Ahci::Block_session_component : Rpc_object<Block::Session>,
                                        Block_session_handler,
                                        Block::Request_stream
 {
+	/*
+	 * Adjacent requests of the client are merged into one command of at
+	 * most this size, which is well below the limits of the ATA and ATAPI
+	 * block counts and the PRDT size
+	 */
+	enum { MAX_TRANSFER = 128 * 1024 };
+
 	Block_session_component(Env &env, Port &port, size_t buffer_size)
 	:
 	  Block_session_handler(env, port, buffer_size),
 	  Request_stream(env.rm(), ds, env.ep(), request_handler, port.info())
 	{
+		merge_requests({ MAX_TRANSFER });
 		env.ep().manage(*this);
 	}
 
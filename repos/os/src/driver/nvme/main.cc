@@ -63,12 +63,14 @@ namespace Nvme {
 	struct Sqe_header;
 	struct Sqe_create_cq;
 	struct Sqe_create_sq;
+	struct Sqe_delete_q;
 	struct Sqe_identify;
 	struct Sqe_get_feature;
 	template <size_t> struct Sqe_set_feature;
 	struct Sqe_io;
 
 	struct Set_hmb;
+	struct Set_num_queues;
 
 	struct Queue;
 	struct Sq;
@@ -81,7 +83,13 @@ namespace Nvme {
 		CQE_LEN                = 1u << CQE_LEN_LOG2,
 		SQE_LEN_LOG2           = 6u,
 		SQE_LEN                = 1u << SQE_LEN_LOG2,
-		MAX_IO_QUEUES          = 1,
+
+		/*
+		 * Every Block session gets an I/O queue pair of its own. The
+		 * number is further limited to the amount of queues the
+		 * controller allocates for us.
+		 */
+		MAX_IO_QUEUES          = 4,
 
 		/*
 		 * Limit max number of I/O slots. By now most controllers
@@ -118,16 +126,21 @@ namespace Nvme {
 		 */
 		MAX_IO_LEN  = 2u << 20,
 		PRP_DS_SIZE = MAX_IO_ENTRIES * MPS,
+
+		/* driver RAM used by the queue pair and PRP list of one session */
+		IO_QUEUE_RAM = PRP_DS_SIZE + MAX_IO_ENTRIES * (SQE_LEN + CQE_LEN),
 	};
 
 	enum {
 		/*
-		 * Limit namespace handling to the first namespace. Most
+		 * Limit namespace handling to the first few namespaces. Most
 		 * if not all consumer NVMe devices only have one.
 		 */
-		IO_NSID    = 1u,
-		MAX_NS     = 1u,
-		NUM_QUEUES = 1 + MAX_NS,
+		MAX_NS     = 8u,
+		NUM_QUEUES = 1 + MAX_IO_QUEUES,
+
+		/* cover the doorbells of all queues */
+		MMIO_SIZE  = 0x1000 + NUM_QUEUES * 8,
 	};
 
 	enum Opcode {
@@ -147,7 +160,8 @@ namespace Nvme {
 	};
 
 	enum Feature_fid {
-		 HMB  = 0x0d,
+		 NUMBER_OF_QUEUES = 0x07,
+		 HMB              = 0x0d,
 	};
 
 	enum Feature_sel {
@@ -457,6 +471,32 @@ struct Nvme::Set_hmb : Nvme::Sqe_set_feature<0x40>
 };
 
 
+struct Nvme::Set_num_queues : Nvme::Sqe_set_feature<0x30>
+{
+	struct Cdw11 : Register<0x2c, 32>
+	{
+		struct Nsqr : Bitfield< 0, 16> { }; /* number of I/O submission queues requested 0-based */
+		struct Ncqr : Bitfield<16, 16> { }; /* number of I/O completion queues requested 0-based */
+	};
+
+	/* result as returned in Dw0 of the completion queue entry */
+	struct Result : Genode::Register<32>
+	{
+		struct Nsqa : Bitfield< 0, 16> { }; /* number of I/O submission queues allocated 0-based */
+		struct Ncqa : Bitfield<16, 16> { }; /* number of I/O completion queues allocated 0-based */
+	};
+
+	Set_num_queues(Byte_range_ptr const &range, uint16_t const num)
+	:
+		Sqe_set_feature(range)
+	{
+		write<Sqe_set_feature::Cdw10::Fid>(Feature_fid::NUMBER_OF_QUEUES);
+		write<Cdw11::Nsqr>(uint16_t(num - 1));
+		write<Cdw11::Ncqr>(uint16_t(num - 1));
+	}
+};
+
+
 /*
  *  Create completion queue command
  */
@@ -501,6 +541,20 @@ struct Nvme::Sqe_create_sq : Nvme::Sqe<0x30>
 };
 
 
+/*
+ * Delete submission or completion queue command
+ */
+struct Nvme::Sqe_delete_q : Nvme::Sqe<0x2c>
+{
+	struct Cdw10 : Register<0x28, 32>
+	{
+		struct Qid : Bitfield< 0, 16> { }; /* queue identifier */
+	};
+
+	Sqe_delete_q(Byte_range_ptr const &range) : Sqe(range) { }
+};
+
+
 /*
  * I/O command
  */
@@ -586,7 +640,7 @@ struct Nvme::Cq : Nvme::Queue
  * Controller
  */
 class Nvme::Controller : Platform::Device,
-                         Platform::Device::Mmio<0x1010>,
+                         Platform::Device::Mmio<Nvme::MMIO_SIZE>,
                          Platform::Device::Irq
 {
 	using Mmio = Genode::Mmio<SIZE>;
@@ -767,20 +821,13 @@ class Nvme::Controller : Platform::Device,
 	};
 
 	/*
-	 * I/O submission doorbell
-	 */
-	struct Io_sdb : Register<0x1008, 32>
-	{
-		struct Sqt : Bitfield< 0, 16> { }; /* submission queue tail */
-	};
-
-	/*
-	 * I/O completion doorbell
+	 * I/O queue doorbells
+	 *
+	 * The submission doorbell of queue 'y' is located at index '2y' and
+	 * the completion doorbell at index '2y + 1'. The doorbell stride is
+	 * expected to be 0.
 	 */
-	struct Io_cdb : Register<0x100C, 32>
-	{
-		struct Cqh : Bitfield< 0, 16> { }; /* completion queue tail */
-	};
+	struct Io_db : Register_array<0x1000, 32, 2 * NUM_QUEUES, 32> { };
 
 	struct Initialization_failed : Genode::Exception { };
 
@@ -798,6 +845,7 @@ class Nvme::Controller : Platform::Device,
 
 	struct Nsinfo
 	{
+		uint32_t id    { 0 };
 		uint64_t count { 0 };
 		size_t   size  { 0 };
 		uint64_t max_request_count { 0 };
@@ -816,7 +864,7 @@ class Nvme::Controller : Platform::Device,
 
 	/*
 	 * There is a completion and submission queue for
-	 * every namespace and one pair for the admin queues.
+	 * every I/O queue pair and one pair for the admin queues.
 	 */
 	Constructible<Nvme::Cq> _cq[NUM_QUEUES] { };
 	Constructible<Nvme::Sq> _sq[NUM_QUEUES] { };
@@ -836,6 +884,8 @@ class Nvme::Controller : Platform::Device,
 	uint16_t _max_io_entries      { MAX_IO_ENTRIES };
 	uint16_t _max_io_entries_mask { uint16_t(_max_io_entries - 1) };
 
+	uint16_t _max_io_queues { 1 };
+
 	enum Cns {
 		IDENTIFY_NS = 0x00,
 		IDENTIFY    = 0x01,
@@ -850,10 +900,13 @@ class Nvme::Controller : Platform::Device,
 		QUERYNS_CID,
 		CREATE_IO_CQ_CID,
 		CREATE_IO_SQ_CID,
+		DELETE_IO_CQ_CID,
+		DELETE_IO_SQ_CID,
 		SET_HMB_CID,
+		SET_NUM_QUEUES_CID,
 	};
 
-	Constructible<Util::Dma_buffer> _nvme_query_ns[MAX_NS] { };
+	Util::Dma_buffer _nvme_query_ns { _platform, IDENTIFY_LEN };
 
 	struct Hmb_chunk
 	{
@@ -891,8 +944,8 @@ class Nvme::Controller : Platform::Device,
 
 	Info _info { };
 
-	/* create larger array to use namespace id to as index */
-	Nsinfo _nsinfo[MAX_NS+1] { };
+	Nsinfo   _nsinfo[MAX_NS] { };
+	uint32_t _nsinfo_count   { 0 };
 
 	/**
 	 * Wait for ready bit to change
@@ -1109,34 +1162,34 @@ class Nvme::Controller : Platform::Device,
 			throw Initialization_failed();
 		}
 
-		if (max > 1) { warning("only the first name space is used"); }
+		if (_nvme_nslist_count > max) {
+			warning("only the first ", max, " name spaces are used"); }
 
 		uint32_t const *ns = _nvme_nslist.local_addr<uint32_t>();
-		uint16_t const  id = 0;
 
-		if (!_nvme_query_ns[id].constructed())
-			_nvme_query_ns[id].construct(_platform, IDENTIFY_LEN);
+		for (uint32_t i = 0; i < max; i++) {
 
-		Sqe_identify b(_admin_command(Opcode::IDENTIFY, ns[id], QUERYNS_CID));
-		b.write<Nvme::Sqe_identify::Prp1>(_nvme_query_ns[id]->dma_addr());
-		b.write<Nvme::Sqe_identify::Cdw10::Cns>(Cns::IDENTIFY_NS);
+			Sqe_identify b(_admin_command(Opcode::IDENTIFY, ns[i], QUERYNS_CID));
+			b.write<Nvme::Sqe_identify::Prp1>(_nvme_query_ns.dma_addr());
+			b.write<Nvme::Sqe_identify::Cdw10::Cns>(Cns::IDENTIFY_NS);
 
-		write<Admin_sdb::Sqt>(_admin_sq->tail);
+			write<Admin_sdb::Sqt>(_admin_sq->tail);
 
-		if (!_wait_for_admin_cq(10, QUERYNS_CID)) {
-			error("identify name space failed");
-			throw Initialization_failed();
-		}
+			if (!_wait_for_admin_cq(10, QUERYNS_CID)) {
+				error("identify name space ", ns[i], " failed");
+				throw Initialization_failed();
+			}
 
-		Identify_ns_data nsdata({_nvme_query_ns[id]->local_addr<char>(), _nvme_query_ns[id]->size()});
-		uint32_t const flbas = nsdata.read<Nvme::Identify_ns_data::Flbas::Formats>();
+			Identify_ns_data nsdata({_nvme_query_ns.local_addr<char>(), _nvme_query_ns.size()});
+			uint32_t const flbas = nsdata.read<Nvme::Identify_ns_data::Flbas::Formats>();
 
-		/* use array subscription, omit first entry */
-		uint16_t const ns_id = id + 1;
+			Nsinfo &info = _nsinfo[_nsinfo_count++];
 
-		_nsinfo[ns_id].count = nsdata.read<Nvme::Identify_ns_data::Nsze>();
-		_nsinfo[ns_id].size  = 1u << nsdata.read<Nvme::Identify_ns_data::Lbaf::Lbads>(flbas);
-		_nsinfo[ns_id].max_request_count = _mdts_bytes / _nsinfo[ns_id].size;
+			info.id    = ns[i];
+			info.count = nsdata.read<Nvme::Identify_ns_data::Nsze>();
+			info.size  = 1u << nsdata.read<Nvme::Identify_ns_data::Lbaf::Lbads>(flbas);
+			info.max_request_count = _mdts_bytes / info.size;
+		}
 	}
 
 	/**
@@ -1292,8 +1345,8 @@ class Nvme::Controller : Platform::Device,
 	 */
 	void _setup_io_cq(uint16_t id)
 	{
-		if (!_cq[id].constructed())
-			_cq[id].construct(_platform, _max_io_entries, CQE_LEN);
+		/* always start with a pristine queue */
+		_cq[id].construct(_platform, _max_io_entries, CQE_LEN);
 
 		Nvme::Cq &cq = *_cq[id];
 
@@ -1322,8 +1375,7 @@ class Nvme::Controller : Platform::Device,
 	 */
 	void _setup_io_sq(uint16_t id, uint16_t cqid)
 	{
-		if (!_sq[id].constructed())
-			_sq[id].construct(_platform, _max_io_entries, SQE_LEN);
+		_sq[id].construct(_platform, _max_io_entries, SQE_LEN);
 
 		Nvme::Sq &sq = *_sq[id];
 
@@ -1343,6 +1395,62 @@ class Nvme::Controller : Platform::Device,
 		}
 	}
 
+	/**
+	 * Delete I/O submission or completion queue
+	 *
+	 * \param opc  'DELETE_IO_SQ' or 'DELETE_IO_CQ'
+	 * \param id   identifier of the queue
+	 * \param cid  command identifier
+	 *
+	 * \return  true if the queue was deleted
+	 */
+	bool _delete_io_q(Opcode opc, uint16_t id, uint16_t cid)
+	{
+		Sqe_delete_q b(_admin_command(opc, 0, cid));
+		b.write<Nvme::Sqe_delete_q::Cdw10::Qid>(id);
+
+		write<Admin_sdb::Sqt>(_admin_sq->tail);
+
+		return _wait_for_admin_cq(10, cid);
+	}
+
+	/**
+	 * Request I/O queues from the controller
+	 *
+	 * The controller may allocate fewer queues than requested, which
+	 * limits the number of queue pairs we are able to use.
+	 */
+	void _setup_num_queues()
+	{
+		Set_num_queues b(_admin_command(Opcode::SET_FEATURES, 0, SET_NUM_QUEUES_CID),
+		                 (uint16_t)MAX_IO_QUEUES);
+
+		write<Admin_sdb::Sqt>(_admin_sq->tail);
+
+		uint32_t result = 0;
+		bool     success = false;
+		_wait_for_admin_cq(10, SET_NUM_QUEUES_CID,
+			[&] (Cqe const &e) {
+				success = Cqe::succeeded(e);
+				result  = e.read<Cqe::Dw0>();
+			},
+			[&] () { /* already false */ }
+		);
+
+		if (!success) {
+			warning("could not set number of queues, use only one I/O queue");
+			_max_io_queues = 1;
+			return;
+		}
+
+		using Result = Set_num_queues::Result;
+		uint16_t const nsqa = uint16_t(Result::Nsqa::get(result) + 1);
+		uint16_t const ncqa = uint16_t(Result::Ncqa::get(result) + 1);
+
+		_max_io_queues = Genode::min((uint16_t)MAX_IO_QUEUES,
+		                             Genode::min(nsqa, ncqa));
+	}
+
 	public:
 
 	/**
@@ -1407,6 +1515,7 @@ class Nvme::Controller : Platform::Device,
 		_identify();
 		_query_nslist();
 		_query_ns();
+		_setup_num_queues();
 	}
 
 	/**
@@ -1418,24 +1527,52 @@ class Nvme::Controller : Platform::Device,
 	}
 
 	/**
-	 * Setup I/O queue
+	 * Setup I/O queue pair
+	 *
+	 * \param qid  identifier of the queue pair
+	 *
+	 * \throw Initialization_failed() in case the queues could not be created
 	 */
-	void setup_io(uint16_t cid, uint16_t sid)
+	void setup_io(uint16_t qid)
 	{
-		_setup_io_cq(cid);
-		_setup_io_sq(sid, cid);
+		_setup_io_cq(qid);
+		_setup_io_sq(qid, qid);
+	}
+
+	/**
+	 * Delete I/O queue pair
+	 *
+	 * Commands still pending in the submission queue are aborted
+	 * by the controller.
+	 *
+	 * \param qid  identifier of the queue pair
+	 */
+	void release_io(uint16_t qid)
+	{
+		if (!_sq[qid].constructed() || !_cq[qid].constructed())
+			return;
+
+		if (!_delete_io_q(Opcode::DELETE_IO_SQ, qid, DELETE_IO_SQ_CID))
+			warning("delete I/O sq ", qid, " failed");
+		if (!_delete_io_q(Opcode::DELETE_IO_CQ, qid, DELETE_IO_CQ_CID))
+			warning("delete I/O cq ", qid, " failed");
+
+		_sq[qid].destruct();
+		_cq[qid].destruct();
 	}
 
 	/**
 	 * Get next free IO submission queue slot
 	 *
+	 * \param qid   queue identifier
 	 * \param nsid  namespace identifier
+	 * \param cid   command identifier
 	 *
 	 * \return  returns virtual address of the I/O command
 	 */
-	Byte_range_ptr io_command(uint16_t nsid, uint16_t cid)
+	Byte_range_ptr io_command(uint16_t qid, uint32_t nsid, uint16_t cid)
 	{
-		Nvme::Sq &sq = *_sq[nsid];
+		Nvme::Sq &sq = *_sq[qid];
 
 		Sqe_header e(sq.next());
 		e.write<Nvme::Sqe_header::Cdw0::Cid>(cid);
@@ -1446,41 +1583,41 @@ class Nvme::Controller : Platform::Device,
 	/**
 	 * Check if I/O queue is full
 	 *
-	 * \param nsid  namespace identifier
+	 * \param qid  queue identifier
 	 *
 	 * \return  true if full, otherwise false
 	 */
-	bool io_queue_full(uint16_t nsid) const
+	bool io_queue_full(uint16_t qid) const
 	{
-		Nvme::Sq const &sq = *_sq[nsid];
-		Nvme::Cq const &cq = *_cq[nsid];
+		Nvme::Sq const &sq = *_sq[qid];
+		Nvme::Cq const &cq = *_cq[qid];
 		return _queue_full(sq, cq);
 	}
 
 	/**
 	 * Write current I/O submission queue tail
 	 *
-	 * \param nsid  namespace identifier
+	 * \param qid  queue identifier
 	 */
-	void commit_io(uint16_t nsid)
+	void commit_io(uint16_t qid)
 	{
-		Nvme::Sq &sq = *_sq[nsid];
-		write<Io_sdb::Sqt>(sq.tail);
+		Nvme::Sq &sq = *_sq[qid];
+		write<Io_db>(sq.tail, 2 * qid);
 	}
 
 	/**
 	 * Process a pending I/O completion
 	 *
-	 * \param nsid  namespace identifier
+	 * \param qid   queue identifier
 	 * \param func  function that is called on each completion
 	 */
 	template <typename FUNC>
-	void handle_io_completion(uint16_t nsid, FUNC const &func)
+	void handle_io_completion(uint16_t qid, FUNC const &func)
 	{
-		if (!_cq[nsid].constructed())
+		if (!_cq[qid].constructed())
 			return;
 
-		Nvme::Cq &cq = *_cq[nsid];
+		Nvme::Cq &cq = *_cq[qid];
 
 		do {
 			Cqe e(cq.next());
@@ -1502,24 +1639,38 @@ class Nvme::Controller : Platform::Device,
 	/**
 	 * Acknowledge every pending I/O already handled
 	 *
-	 * \param nsid  namespace identifier
+	 * \param qid  queue identifier
 	 */
-	void ack_io_completions(uint16_t nsid)
+	void ack_io_completions(uint16_t qid)
 	{
-		Nvme::Cq &cq = *_cq[nsid];
-		write<Io_cdb::Cqh>(cq.head);
+		Nvme::Cq &cq = *_cq[qid];
+		write<Io_db>(cq.head, 2 * qid + 1);
 	}
 
 	/**
 	 * Get block metrics of namespace
 	 *
-	 * \param nsid  namespace identifier
+	 * \param nsid  namespace identifier, 0 selects the first namespace
 	 *
-	 * \return  returns information of the namespace
+	 * \return  returns information of the namespace, which is invalid
+	 *          if the namespace is unknown
+	 */
+	Nsinfo nsinfo(uint32_t nsid) const
+	{
+		for (uint32_t i = 0; i < _nsinfo_count; i++)
+			if (!nsid || _nsinfo[i].id == nsid)
+				return _nsinfo[i];
+
+		return Nsinfo { };
+	}
+
+	/**
+	 * Call 'fn' for the information of every used namespace
 	 */
-	Nsinfo nsinfo(uint16_t nsid)
+	void for_each_nsinfo(auto const &fn) const
 	{
-		return _nsinfo[nsid];
+		for (uint32_t i = 0; i < _nsinfo_count; i++)
+			fn(_nsinfo[i]);
 	}
 
 	/**
@@ -1530,27 +1681,18 @@ class Nvme::Controller : Platform::Device,
 	Info const &info() const { return _info; }
 
 	/**
-	 * Get supported maximum number of blocks per request for namespace
-	 *
-	 * \param nsid  namespace identifier
+	 * Get number of slots in the I/O queue
 	 *
-	 * \return  returns maximal count of blocks in one request
+	 * \return  returns maximal number of I/O requests
 	 */
-	Block::block_count_t max_count(uint16_t nsid) const
-	{
-		/*
-		 * Limit to block_count_t which differs between 32 and 64 bit
-		 * systems.
-		 */
-		return (Block::block_count_t)_nsinfo[nsid].max_request_count;
-	}
+	uint16_t max_io_entries() const { return _max_io_entries; }
 
 	/**
-	 * Get number of slots in the I/O queue
+	 * Get number of usable I/O queue pairs
 	 *
-	 * \return  returns maximal number of I/O requests
+	 * \return  returns number of queue pairs allocated by the controller
 	 */
-	uint16_t max_io_entries() const { return _max_io_entries; }
+	uint16_t max_io_queues() const { return _max_io_queues; }
 
 	/***********
 	 ** Debug **
@@ -1610,12 +1752,14 @@ struct Nvme::Block_session_component : Rpc_object<Block::Session>,
 
 	Block::Session::Info _info;
 
+	uint16_t const qid;
+
 	Block_session_component(Env &env, Dataspace_capability ds,
 	                        Signal_context_capability sigh,
-	                        Block::Session::Info info)
+	                        Block::Session::Info info, uint16_t qid)
 	:
 		Request_stream(env.rm(), ds, env.ep(), sigh, info), _env(env),
-		_info(info)
+		_info(info), qid(qid)
 	{
 		_env.ep().manage(*this);
 	}
@@ -1684,37 +1828,13 @@ class Nvme::Driver : Genode::Noncopyable
 				_system_rom->sigh(_system_rom_sigh);
 			} else
 				_system_rom.destruct();
+
+			_apply_report_config(config);
 		}
 
 		Genode::Signal_handler<Driver> _config_sigh {
 			_env.ep(), *this, &Driver::_handle_config_update };
 
-		/**************
-		 ** Reporter **
-		 **************/
-
-		Genode::Reporter _namespace_reporter { _env, "controller" };
-
-		void _report_namespaces(Nvme::Controller &ctrlr)
-		{
-			try {
-				Genode::Reporter::Xml_generator xml(_namespace_reporter, [&]() {
-					Nvme::Controller::Info const &info = ctrlr.info();
-
-					xml.attribute("serial", info.sn);
-					xml.attribute("model",  info.mn);
-
-					Nvme::Controller::Nsinfo ns = ctrlr.nsinfo(Nvme::IO_NSID);
-
-					xml.node("namespace", [&]() {
-						xml.attribute("id",          (uint16_t)Nvme::IO_NSID);
-						xml.attribute("block_size",  ns.size);
-						xml.attribute("block_count", ns.count);
-					});
-				});
-			} catch (...) { }
-		}
-
 		/**************
 		 ** Requests **
 		 **************/
@@ -1758,25 +1878,108 @@ class Nvme::Driver : Genode::Noncopyable
 			}
 		};
 
-		Command_id<Nvme::MAX_IO_ENTRIES> _command_id_allocator { };
-		Request                          _requests[Nvme::MAX_IO_ENTRIES] { };
+		/*
+		 * State of the I/O queue pair used by one Block session
+		 */
+		struct Io_queue : Genode::Noncopyable
+		{
+			uint16_t      const id;
+			Session_label const label;
+
+			uint32_t             const nsid;
+			Block::block_count_t const max_count;
+
+			Block::Session::Info info;
+
+			Constructible<Util::Dma_buffer> dma_buffer { };
 
+			/*
+			 * The PRP (Physical Region Pages) page is used to setup
+			 * large requests.
+			 */
+			Util::Dma_buffer prp_list_helper;
+
+			Command_id<Nvme::MAX_IO_ENTRIES> command_id_allocator { };
+			Request                          requests[Nvme::MAX_IO_ENTRIES] { };
+
+			uint64_t submits_in_flight { 0 };
+
+			bool submits_pending   { false };
+			bool completed_pending { false };
+
+			/* occupancy statistics for the report */
+			uint64_t max_in_flight { 0 };
+			uint64_t completed     { 0 };
+
+			Io_queue(Platform::Connection &platform, uint16_t id,
+			         Session_label const &label,
+			         Nvme::Controller::Nsinfo const &ns, bool writeable)
+			:
+				id(id), label(label), nsid(ns.id),
+				/*
+				 * Limit to block_count_t which differs between 32 and 64 bit
+				 * systems.
+				 */
+				max_count((Block::block_count_t)ns.max_request_count),
+				info({ .block_size  = ns.size,
+				       .block_count = ns.count,
+				       .align_log2  = Nvme::MPS_LOG2,
+				       .writeable   = writeable }),
+				prp_list_helper(platform, Nvme::PRP_DS_SIZE)
+			{ }
+		};
+
+		Constructible<Io_queue> _io_queues[Nvme::MAX_IO_QUEUES] { };
+
+		/*
+		 * The queue pair identifier is the array index + 1 as
+		 * identifier 0 denotes the admin queues.
+		 */
+		static unsigned _index(uint16_t qid) { return qid - 1u; }
+
+		Io_queue &_io_queue(uint16_t qid) { return *_io_queues[_index(qid)]; }
+
+		Io_queue const &_io_queue(uint16_t qid) const { return *_io_queues[_index(qid)]; }
+
+		void _for_each_io_queue(auto const &fn)
+		{
+			for (Constructible<Io_queue> &q : _io_queues)
+				if (q.constructed())
+					fn(*q);
+		}
+
+		void _for_each_io_queue(auto const &fn) const
+		{
+			for (Constructible<Io_queue> const &q : _io_queues)
+				if (q.constructed())
+					fn(*q);
+		}
+
+		/*
+		 * Check all requests targeting the same namespace, regardless
+		 * of the queue pair they were submitted to.
+		 */
 		template <typename FUNC>
-		bool _for_any_request(FUNC const &func, auto &ctrlr) const
+		bool _for_any_request(uint32_t nsid, FUNC const &func, auto &ctrlr) const
 		{
-			for (uint16_t i = 0; i < ctrlr.max_io_entries(); i++) {
-				if (_command_id_allocator.used(i) && func(_requests[i])) {
-					return true;
+			bool result = false;
+			_for_each_io_queue([&] (Io_queue const &q) {
+				if (result || q.nsid != nsid)
+					return;
+
+				for (uint16_t i = 0; i < ctrlr.max_io_entries(); i++) {
+					if (q.command_id_allocator.used(i) && func(q.requests[i])) {
+						result = true;
+						return;
+					}
 				}
-			}
-			return false;
+			});
+			return result;
 		}
 
 		uint64_t _submits_in_flight { };
 
-		bool _submits_pending   { false };
-		bool _completed_pending { false };
-		bool _stop_processing   { false };
+		bool _stop_processing { false };
 
 		/*********************
 		 ** MMIO Controller **
@@ -1813,23 +2016,99 @@ class Nvme::Driver : Genode::Noncopyable
 				fn_error();
 		}
 
-		/*********
-		 ** DMA **
-		 *********/
+		/**************
+		 ** Reporter **
+		 **************/
+
+		Genode::Reporter _namespace_reporter { _env, "controller" };
 
-		Constructible<Util::Dma_buffer> _dma_buffer { };
+		bool _report_namespaces { false };
+		bool _report_queues     { false };
 
 		/*
-		 * The PRP (Physical Region Pages) page is used to setup
-		 * large requests.
+		 * The queue occupancy changes with every request, therefore
+		 * it is reported periodically.
 		 */
-		Util::Dma_buffer _prp_list_helper { _platform, Nvme::PRP_DS_SIZE };
+		Constructible<Timer::Connection> _report_timer { };
+
+		Signal_handler<Driver> _report_timer_sigh {
+			_env.ep(), *this, &Driver::_handle_report_timer };
+
+		void _apply_report_config(Xml_node const &config)
+		{
+			_report_namespaces = false;
+			_report_queues     = false;
+
+			config.with_optional_sub_node("report", [&] (Xml_node const &report) {
+				_report_namespaces = report.attribute_value("namespaces", false);
+				_report_queues     = report.attribute_value("queues",     false);
+
+				uint64_t const interval_ms =
+					report.attribute_value("interval_ms", (uint64_t)1000);
+
+				if (_report_queues && interval_ms) {
+					if (!_report_timer.constructed()) {
+						_report_timer.construct(_env);
+						_report_timer->sigh(_report_timer_sigh);
+					}
+					_report_timer->trigger_periodic(interval_ms * 1000);
+				}
+			});
+
+			if (!_report_queues)
+				_report_timer.destruct();
 
-		/***********
-		 ** Block **
-		 ***********/
+			_namespace_reporter.enabled(_report_namespaces || _report_queues);
+		}
+
+		void _handle_report_timer()
+		{
+			with_nvme([&] (auto &ctrlr) { _report(ctrlr); }, [&] () { });
+		}
+
+		void _report(Nvme::Controller &ctrlr)
+		{
+			if (!_report_namespaces && !_report_queues)
+				return;
+
+			try {
+				Genode::Reporter::Xml_generator xml(_namespace_reporter, [&]() {
+					Nvme::Controller::Info const &info = ctrlr.info();
 
-		Block::Session::Info _info { };
+					xml.attribute("serial", info.sn);
+					xml.attribute("model",  info.mn);
+
+					if (_report_namespaces)
+						ctrlr.for_each_nsinfo([&] (Nvme::Controller::Nsinfo const &ns) {
+							xml.node("namespace", [&]() {
+								xml.attribute("id",          ns.id);
+								xml.attribute("block_size",  ns.size);
+								xml.attribute("block_count", ns.count);
+							});
+						});
+
+					if (!_report_queues)
+						return;
+
+					xml.attribute("io_queues", ctrlr.max_io_queues());
+
+					_for_each_io_queue([&] (Io_queue &q) {
+						xml.node("queue", [&]() {
+							xml.attribute("id",            q.id);
+							xml.attribute("label",         q.label);
+							xml.attribute("namespace",     q.nsid);
+							xml.attribute("entries",       ctrlr.max_io_entries());
+							xml.attribute("in_flight",     q.submits_in_flight);
+							xml.attribute("max_in_flight", q.max_in_flight);
+							xml.attribute("completed",     q.completed);
+						});
+
+						/* peak occupancy is reported per interval */
+						q.max_in_flight = q.submits_in_flight;
+					});
+				});
+			} catch (...) { }
+		}
 
 	public:
 
@@ -1874,35 +2153,15 @@ class Nvme::Driver : Genode::Noncopyable
 				ctrlr.setup_hmb(_hmb_size);
 
 			/*
-			 * Setup I/O
+			 * Setup I/O for sessions that survived a suspend/resume cycle,
+			 * the queue pairs of new sessions are created on demand
 			 */
-
-			if (_verbose_mem) {
-				addr_t virt_addr = (addr_t)_prp_list_helper.local_addr<void>();
-				addr_t phys_addr = _prp_list_helper.dma_addr();
-				log("DMA", " virt: [", Hex(virt_addr), ",",
-				           Hex(virt_addr + Nvme::PRP_DS_SIZE), "]",
-				           " phys: [", Hex(phys_addr), ",",
-				           Hex(phys_addr + Nvme::PRP_DS_SIZE), "]");
-			}
-
-			ctrlr.setup_io(Nvme::IO_NSID, Nvme::IO_NSID);
-
-			/*
-			 * Setup Block session
-			 */
-
-			/* set Block session properties */
-			Nvme::Controller::Nsinfo nsinfo = ctrlr.nsinfo(Nvme::IO_NSID);
-			if (!nsinfo.valid()) {
-				error("could not query namespace information");
-				throw Nvme::Controller::Initialization_failed();
-			}
-
-			_info = { .block_size  = nsinfo.size,
-			          .block_count = nsinfo.count,
-			          .align_log2  = Nvme::MPS_LOG2,
-			          .writeable   = false };
+			_for_each_io_queue([&] (Io_queue &q) {
+				if (q.id > ctrlr.max_io_queues())
+					error("I/O queue ", q.id, " no longer available");
+				else
+					ctrlr.setup_io(q.id);
+			});
 
 			Nvme::Controller::Info const &info = ctrlr.info();
 
@@ -1911,26 +2170,109 @@ class Nvme::Driver : Genode::Noncopyable
 			    "model:'",  info.mn.string(), "'", " "
 			    "frev:'",   info.fr.string(), "'");
 
-			log("Block", " "
-			    "size: ",  _info.block_size, " "
-			    "count: ", _info.block_count, " "
+			ctrlr.for_each_nsinfo([&] (Nvme::Controller::Nsinfo const &ns) {
+				log("Block", " "
+				    "namespace: ", ns.id, " "
+				    "size: ",  ns.size, " "
+				    "count: ", ns.count);
+			});
+
+			log("I/O queues: ", ctrlr.max_io_queues(), " "
 			    "I/O entries: ", ctrlr.max_io_entries());
 
-			/* generate Report if requested */
-			try {
-				Genode::Xml_node report = _config_rom.xml().sub_node("report");
-				if (report.attribute_value("namespaces", false)) {
-					_namespace_reporter.enabled(true);
-					_report_namespaces(ctrlr);
-				}
-			} catch (...) { }
+			_report(ctrlr);
 		}
 
 		~Driver() { /* free resources */ }
 
-		Block::Session::Info info() const { return _info; }
+		/**
+		 * Setup I/O queue pair for a Block session
+		 *
+		 * \param nsid  namespace identifier, 0 selects the first namespace
+		 *
+		 * \return  identifier of the queue pair, 0 if there is no queue
+		 *          pair left or the namespace is unknown
+		 */
+		uint16_t alloc_io_queue(Session_label const &label,
+		                        uint32_t nsid, bool writeable)
+		{
+			uint16_t qid = 0;
+
+			with_nvme([&] (auto &ctrlr) {
+
+				Nvme::Controller::Nsinfo const ns = ctrlr.nsinfo(nsid);
+				if (!ns.valid()) {
+					error("name space ", nsid, " not available");
+					return;
+				}
+
+				for (uint16_t id = 1; id <= ctrlr.max_io_queues(); id++) {
+					if (_io_queues[_index(id)].constructed())
+						continue;
+
+					_io_queues[_index(id)].construct(_platform, id, label,
+					                                 ns, writeable);
+					try {
+						ctrlr.setup_io(id);
+					} catch (Nvme::Controller::Initialization_failed) {
+						_io_queues[_index(id)].destruct();
+						return;
+					}
+
+					qid = id;
+					break;
+				}
+
+				if (!qid)
+					return;
+
+				if (_verbose_mem) {
+					Util::Dma_buffer const &prp = _io_queue(qid).prp_list_helper;
+
+					addr_t virt_addr = (addr_t)prp.local_addr<void>();
+					addr_t phys_addr = prp.dma_addr();
+					log("DMA", " virt: [", Hex(virt_addr), ",",
+					           Hex(virt_addr + Nvme::PRP_DS_SIZE), "]",
+					           " phys: [", Hex(phys_addr), ",",
+					           Hex(phys_addr + Nvme::PRP_DS_SIZE), "]");
+				}
+
+				_report(ctrlr);
+			}, [&] () { error("unexpected NVME controller state - alloc_io_queue"); });
+
+			return qid;
+		}
+
+		/**
+		 * Delete I/O queue pair of a closed Block session
+		 *
+		 * Requests still in flight are aborted by the controller.
+		 */
+		void free_io_queue(uint16_t qid)
+		{
+			Io_queue &q = _io_queue(qid);
+
+			with_nvme([&] (auto &ctrlr) {
+				ctrlr.release_io(qid);
+			}, [&] () { /* hw is off, queues are gone already */ });
+
+			_submits_in_flight -= min(_submits_in_flight, q.submits_in_flight);
 
-		void writeable(bool writeable) { _info.writeable = writeable; }
+			_io_queues[_index(qid)].destruct();
+
+			with_nvme([&] (auto &ctrlr) { _report(ctrlr); }, [&] () { });
+		}
+
+		Block::Session::Info info(uint16_t qid) const { return _io_queue(qid).info; }
+
+		/**
+		 * Get maximum size of one request in bytes
+		 */
+		size_t max_transfer(uint16_t qid) const
+		{
+			Io_queue const &q = _io_queue(qid);
+			return q.max_count * q.info.block_size;
+		}
 
 		void device_release_if_stopped_and_idle()
 		{
@@ -1983,7 +2325,8 @@ class Nvme::Driver : Genode::Noncopyable
 		 ** Block request stream API **
 		 ******************************/
 
-		Response _check_acceptance(Block::Request          request,
+		Response _check_acceptance(Io_queue         const &q,
+		                           Block::Request          request,
 		                           Nvme::Controller const &ctrlr) const
 		{
 			/*
@@ -1991,7 +2334,7 @@ class Nvme::Driver : Genode::Noncopyable
 			 * MAX_IO_ENTRIES requests, so it is safe to only check the
 			 * I/O queue.
 			 */
-			if (ctrlr.io_queue_full(Nvme::IO_NSID)) {
+			if (ctrlr.io_queue_full(q.id)) {
 				return Response::RETRY;
 			}
 
@@ -2009,15 +2352,15 @@ class Nvme::Driver : Genode::Noncopyable
 			[[fallthrough]];
 
 			case Block::Operation::Type::WRITE:
-				if (!_info.writeable) {
+				if (!q.info.writeable) {
 					return Response::REJECTED;
 				}
 			[[fallthrough]];
 
 			case Block::Operation::Type::READ:
 				/* limit request to what we can handle, needed for overlap check */
-				if (request.operation.count > ctrlr.max_count(Nvme::IO_NSID)) {
-					request.operation.count = ctrlr.max_count(Nvme::IO_NSID);
+				if (request.operation.count > q.max_count) {
+					request.operation.count = q.max_count;
 				}
 			}
 
@@ -2043,48 +2386,57 @@ class Nvme::Driver : Genode::Noncopyable
 				}
 				return overlap;
 			};
-			if (_for_any_request(overlap_check, ctrlr)) { return Response::RETRY; }
+			if (_for_any_request(q.nsid, overlap_check, ctrlr)) { return Response::RETRY; }
 
 			return Response::ACCEPTED;
 		}
 
-		void _submit(Block::Request request, Nvme::Controller &ctrlr)
+		Request &_alloc_request(Io_queue &q, Block::Request const &request,
+		                        uint16_t &cid)
+		{
+			cid = q.command_id_allocator.alloc();
+
+			Request &r = q.requests[cid];
+			r = Request { .block_request = request,
+			              .id            = uint32_t(cid | (q.id<<16)) };
+			return r;
+		}
+
+		void _submit(Io_queue &q, Block::Request request, Nvme::Controller &ctrlr)
 		{
-			if (!_dma_buffer.constructed())
+			if (!q.dma_buffer.constructed())
 				return;
 
 			bool const write =
 				request.operation.type == Block::Operation::Type::WRITE;
 
 			/* limit request to what we can handle */
-			if (request.operation.count > ctrlr.max_count(Nvme::IO_NSID)) {
-				request.operation.count = ctrlr.max_count(Nvme::IO_NSID);
+			if (request.operation.count > q.max_count) {
+				request.operation.count = q.max_count;
 			}
 
 			uint32_t        const count = (uint32_t)request.operation.count;
 			Block::sector_t const lba   = request.operation.block_number;
 
-			size_t const len        = request.operation.count * _info.block_size;
+			size_t const len        = request.operation.count * q.info.block_size;
 			bool   const need_list  = len > 2 * Nvme::MPS;
-			addr_t const request_pa = _dma_buffer->dma_addr() + request.offset;
+			addr_t const request_pa = q.dma_buffer->dma_addr() + request.offset;
 
 			if (_verbose_io) {
 				log("Submit: ", write ? "WRITE" : "READ",
+				    " queue: ", q.id,
 				    " len: ", len, " mps: ", (unsigned)Nvme::MPS,
 				    " need_list: ", need_list,
 				    " block count: ", count,
 				    " lba: ", lba,
-				    " dma_base: ", Hex(_dma_buffer->dma_addr()),
+				    " dma_base: ", Hex(q.dma_buffer->dma_addr()),
 				    " offset: ", Hex(request.offset));
 			}
 
-			uint16_t const cid = _command_id_allocator.alloc();
-			uint32_t const id  = cid | (Nvme::IO_NSID<<16);
-			Request &r = _requests[cid];
-			r = Request { .block_request = request,
-			              .id            = id };
+			uint16_t cid = 0;
+			_alloc_request(q, request, cid);
 
-			Nvme::Sqe_io b(ctrlr.io_command(Nvme::IO_NSID, cid));
+			Nvme::Sqe_io b(ctrlr.io_command(q.id, q.nsid, cid));
 			Nvme::Opcode const op = write ? Nvme::Opcode::WRITE : Nvme::Opcode::READ;
 			b.write<Nvme::Sqe_io::Cdw0::Opc>(op);
 			b.write<Nvme::Sqe_io::Prp1>(request_pa);
@@ -2096,8 +2448,8 @@ class Nvme::Driver : Genode::Noncopyable
 
 				/* get page to store list of mps chunks */
 				addr_t const offset = cid * Nvme::MPS;
-				addr_t pa = _prp_list_helper.dma_addr() + offset;
-				addr_t va = (addr_t)_prp_list_helper.local_addr<void>()
+				addr_t pa = q.prp_list_helper.dma_addr() + offset;
+				addr_t va = (addr_t)q.prp_list_helper.local_addr<void>()
 				            + offset;
 
 				/* omit first page and write remaining pages to iob */
@@ -2127,32 +2479,28 @@ class Nvme::Driver : Genode::Noncopyable
 			b.write<Nvme::Sqe_io::Cdw12::Nlb>(count - 1); /* 0-base value */
 		}
 
-		void _submit_sync(Block::Request const &request,
+		void _submit_sync(Io_queue             &q,
+		                  Block::Request const &request,
 		                  Nvme::Controller     &ctrlr)
 		{
-			uint16_t const cid = _command_id_allocator.alloc();
-			uint32_t const id  = cid | (Nvme::IO_NSID<<16);
-			Request &r = _requests[cid];
-			r = Request { .block_request = request,
-			              .id            = id };
+			uint16_t cid = 0;
+			_alloc_request(q, request, cid);
 
-			Nvme::Sqe_io b(ctrlr.io_command(Nvme::IO_NSID, cid));
+			Nvme::Sqe_io b(ctrlr.io_command(q.id, q.nsid, cid));
 			b.write<Nvme::Sqe_io::Cdw0::Opc>(Nvme::Opcode::FLUSH);
 		}
 
-		void _submit_trim(Block::Request const &request,
+		void _submit_trim(Io_queue             &q,
+		                  Block::Request const &request,
 		                  Nvme::Controller     &ctrlr)
 		{
-			uint16_t const cid = _command_id_allocator.alloc();
-			uint32_t const id  = cid | (Nvme::IO_NSID<<16);
-			Request &r = _requests[cid];
-			r = Request { .block_request = request,
-			              .id            = id };
+			uint16_t cid = 0;
+			_alloc_request(q, request, cid);
 
 			uint32_t        const count = (uint32_t)request.operation.count;
 			Block::sector_t const lba   = request.operation.block_number;
 
-			Nvme::Sqe_io b(ctrlr.io_command(Nvme::IO_NSID, cid));
+			Nvme::Sqe_io b(ctrlr.io_command(q.id, q.nsid, cid));
 			b.write<Nvme::Sqe_io::Cdw0::Opc>(Nvme::Opcode::WRITE_ZEROS);
 			b.write<Nvme::Sqe_io::Slba_lower>(uint32_t(lba));
 			b.write<Nvme::Sqe_io::Slba_upper>(uint32_t(lba >> 32u));
@@ -2166,11 +2514,12 @@ class Nvme::Driver : Genode::Noncopyable
 			b.write<Nvme::Sqe_io::Cdw12::Nlb>(count - 1); /* 0-base value */
 		}
 
-		void _get_completed_request(Nvme::Controller &ctrlr,
+		void _get_completed_request(Io_queue         &q,
+		                            Nvme::Controller &ctrlr,
 		                            Block::Request   &out,
 		                            uint16_t         &out_cid)
 		{
-			ctrlr.handle_io_completion(Nvme::IO_NSID, [&] (Nvme::Cqe const &b) {
+			ctrlr.handle_io_completion(q.id, [&] (Nvme::Cqe const &b) {
 
 				if (_verbose_io) { Nvme::Cqe::dump(b); }
 
@@ -2179,7 +2528,7 @@ class Nvme::Driver : Genode::Noncopyable
 
 				uint32_t const id  = Nvme::Cqe::request_id(b);
 				uint16_t const cid = Nvme::Cqe::command_id(b);
-				Request &r = _requests[cid];
+				Request &r = q.requests[cid];
 				if (r.id != id) {
 					error("no pending request found for CQ entry: id: ",
 					      id, " != r.id: ", r.id);
@@ -2192,13 +2541,13 @@ class Nvme::Driver : Genode::Noncopyable
 				r.block_request.success = Nvme::Cqe::succeeded(b);
 				out = r.block_request;
 
-				_completed_pending = true;
+				q.completed_pending = true;
 			});
 		}
 
-		void _free_completed_request(uint16_t const cid)
+		void _free_completed_request(Io_queue &q, uint16_t const cid)
 		{
-			_command_id_allocator.free(cid);
+			q.command_id_allocator.free(cid);
 		}
 
 
@@ -2206,7 +2555,7 @@ class Nvme::Driver : Genode::Noncopyable
 		 ** driver interface **
 		 **********************/
 
-		Response acceptable(Block::Request const &request) const
+		Response acceptable(uint16_t qid, Block::Request const &request) const
 		{
 			Response result = Response::RETRY;
 
@@ -2214,7 +2563,7 @@ class Nvme::Driver : Genode::Noncopyable
 				return result;
 
 			with_nvme([&](auto &ctrlr) {
-				result = _check_acceptance(request, ctrlr);
+				result = _check_acceptance(_io_queue(qid), request, ctrlr);
 			}, [&]() {
 				/* retry later */
 				result = Response::RETRY;
@@ -2223,26 +2572,31 @@ class Nvme::Driver : Genode::Noncopyable
 			return result;
 		}
 
-		void submit(Block::Request const &request)
+		void submit(uint16_t qid, Block::Request const &request)
 		{
+			Io_queue &q = _io_queue(qid);
+
 			with_nvme([&](auto &ctrlr) {
 				switch (request.operation.type) {
 				case Block::Operation::Type::READ:
 				case Block::Operation::Type::WRITE:
-					_submit(request, ctrlr);
+					_submit(q, request, ctrlr);
 					break;
 				case Block::Operation::Type::SYNC:
-					_submit_sync(request, ctrlr);
+					_submit_sync(q, request, ctrlr);
 					break;
 				case Block::Operation::Type::TRIM:
-					_submit_trim(request, ctrlr);
+					_submit_trim(q, request, ctrlr);
 					break;
 				default:
 					return;
 				}
 
 				_submits_in_flight ++;
-				_submits_pending = true;
+				q.submits_in_flight ++;
+				q.submits_pending = true;
+
+				q.max_in_flight = max(q.max_in_flight, q.submits_in_flight);
 			}, [&]() {
 				error("unexpected NVME controller state - submit");
 			});
@@ -2259,58 +2613,68 @@ class Nvme::Driver : Genode::Noncopyable
 
 		bool execute()
 		{
-			if (!_submits_pending) { return false; }
-
 			bool success = false;
 
-			with_nvme([&](auto &ctrlr) {
-				ctrlr.commit_io(Nvme::IO_NSID);
-				_submits_pending = false;
-				success = true;
-			}, [&]() {
-				error("unexpected NVME controller state - execute");
+			_for_each_io_queue([&] (Io_queue &q) {
+				if (!q.submits_pending) { return; }
+
+				with_nvme([&](auto &ctrlr) {
+					ctrlr.commit_io(q.id);
+					q.submits_pending = false;
+					success = true;
+				}, [&]() {
+					error("unexpected NVME controller state - execute");
+				});
 			});
 
 			return success;
 		}
 
-		void with_any_completed_job(auto const &fn)
+		void with_any_completed_job(uint16_t qid, auto const &fn)
 		{
+			Io_queue &q = _io_queue(qid);
+
 			uint16_t       cid     { 0 };
 			Block::Request request { };
 
 			with_nvme([&](auto &ctrlr) {
-				_get_completed_request(ctrlr, request, cid);
+				_get_completed_request(q, ctrlr, request, cid);
 			}, [&]() { /* if hw is off, no requests are in flight */ });
 
 			if (request.operation.valid()) {
 				fn(request);
-				_free_completed_request(cid);
+				_free_completed_request(q, cid);
 
 				if (_submits_in_flight)
 					_submits_in_flight --;
+				if (q.submits_in_flight)
+					q.submits_in_flight --;
+
+				q.completed ++;
 			}
 		}
 
 		void acknowledge_if_completed()
 		{
-			if (!_completed_pending) { return; }
-
-			with_nvme([&](auto &ctrlr) {
-				ctrlr.ack_io_completions(Nvme::IO_NSID);
-				_completed_pending = false;
-			}, [&]() {
-				error("unexepected NVME controller state - ack_if");
+			_for_each_io_queue([&] (Io_queue &q) {
+				if (!q.completed_pending) { return; }
+
+				with_nvme([&](auto &ctrlr) {
+					ctrlr.ack_io_completions(q.id);
+					q.completed_pending = false;
+				}, [&]() {
+					error("unexepected NVME controller state - ack_if");
+				});
 			});
 		}
 
-		Dataspace_capability dma_buffer_construct(size_t size)
+		Dataspace_capability dma_buffer_construct(uint16_t qid, size_t size)
 		{
-			_dma_buffer.construct(_platform, size);
-			return _dma_buffer->cap();
-		}
+			Io_queue &q = _io_queue(qid);
 
-		void dma_buffer_destruct() { _dma_buffer.destruct(); }
+			q.dma_buffer.construct(_platform, size);
+			return q.dma_buffer->cap();
+		}
 };
 
 
@@ -2324,14 +2688,36 @@ struct Nvme::Main : Rpc_object<Typed_root<Block::Session>>
 
 	Genode::Attached_rom_dataspace _config_rom { _env, "config" };
 
-	Genode::Ram_dataspace_capability       _block_ds_cap  { };
-	Constructible<Block_session_component> _block_session { };
+	/* session slots are indexed by the identifier of their queue pair - 1 */
+	Constructible<Block_session_component> _block_sessions[Nvme::MAX_IO_QUEUES] { };
 
 	Signal_handler<Main> _request_handler { _env.ep(), *this, &Main::_handle_requests };
 	Signal_handler<Main> _irq_handler     { _env.ep(), *this, &Main::_handle_irq };
 
 	Nvme::Driver _driver { _env, _config_rom, _irq_handler, _request_handler };
 
+	/*
+	 * The queue pair of a session is backed by the RAM of the driver,
+	 * not by the session quota. Hence, the number of sessions is bounded
+	 * by the configuration the quota of the driver is dimensioned for.
+	 */
+	unsigned const _max_sessions = min((unsigned)Nvme::MAX_IO_QUEUES,
+		_config_rom.xml().attribute_value("max_sessions", 1u));
+
+	void _for_each_session(auto const &fn)
+	{
+		for (Constructible<Block_session_component> &s : _block_sessions)
+			if (s.constructed())
+				fn(*s);
+	}
+
+	unsigned _num_sessions()
+	{
+		unsigned result = 0;
+		_for_each_session([&] (Block_session_component &) { result++; });
+		return result;
+	}
+
 	void _handle_irq()
 	{
 		_handle_requests();
@@ -2340,44 +2726,48 @@ struct Nvme::Main : Rpc_object<Typed_root<Block::Session>>
 
 	void _handle_requests()
 	{
-		if (!_block_session.constructed())
-			return;
-
-		Block_session_component &block_session = *_block_session;
-
 		for (;;) {
 
 			bool progress = false;
 
 			/* import new requests */
-			block_session.with_requests([&] (Block::Request request) {
-
-				Response response = _driver.acceptable(request);
-
-				switch (response) {
-				case Response::ACCEPTED:
-					_driver.submit(request);
-				[[fallthrough]];
-				case Response::REJECTED:
-					progress = true;
-				[[fallthrough]];
-				case Response::RETRY:
-					break;
-				}
+			_for_each_session([&] (Block_session_component &block_session) {
+
+				uint16_t const qid = block_session.qid;
+
+				block_session.with_requests([&] (Block::Request request) {
+
+					Response response = _driver.acceptable(qid, request);
+
+					switch (response) {
+					case Response::ACCEPTED:
+						_driver.submit(qid, request);
+					[[fallthrough]];
+					case Response::REJECTED:
+						progress = true;
+					[[fallthrough]];
+					case Response::RETRY:
+						break;
+					}
 
-				return response;
+					return response;
+				});
 			});
 
 			/* process I/O */
 			progress |= _driver.execute();
 
 			/* acknowledge finished jobs */
-			block_session.try_acknowledge([&] (Block_session_component::Ack &ack) {
+			_for_each_session([&] (Block_session_component &block_session) {
+
+				block_session.try_acknowledge([&] (Block_session_component::Ack &ack) {
 
-				_driver.with_any_completed_job([&] (Block::Request request) {
+					_driver.with_any_completed_job(block_session.qid,
+					                               [&] (Block::Request request) {
 
-					ack.submit(request);
-					progress = true;
+						ack.submit(request);
+						progress = true;
+					});
 				});
 			});
 
@@ -2389,17 +2779,13 @@ struct Nvme::Main : Rpc_object<Typed_root<Block::Session>>
 			if (!progress) { break; }
 		}
 
-		block_session.wakeup_client_if_needed();
+		_for_each_session([&] (Block_session_component &block_session) {
+			block_session.wakeup_client_if_needed(); });
 	}
 
 	Capability<Session> session(Root::Session_args const &args,
 	                            Affinity const &) override
 	{
-		if (_block_session.constructed()) {
-			error("device is already in use");
-			throw Service_denied();
-		}
-
 		Session_label  const label  { label_from_args(args.string()) };
 		Session_policy const policy { label, _config_rom.xml() };
 
@@ -2416,24 +2802,61 @@ struct Nvme::Main : Rpc_object<Typed_root<Block::Session>>
 			throw Insufficient_ram_quota();
 		}
 
-		bool const writeable = policy.attribute_value("writeable", false);
-		_driver.writeable(writeable);
+		bool     const writeable = policy.attribute_value("writeable", false);
+		uint32_t const nsid      = policy.attribute_value("namespace", 0u);
 
-		_block_session.construct(_env, _driver.dma_buffer_construct(tx_buf_size),
-		                         _request_handler, _driver.info());
-		return _block_session->cap();
+		if (_num_sessions() >= _max_sessions) {
+			error("session limit of ", _max_sessions, " reached, denying '",
+			      label, "'");
+			throw Service_denied();
+		}
+
+		if (_env.pd().avail_ram().value < Nvme::IO_QUEUE_RAM) {
+			error("insufficient RAM for the I/O queue of '", label, "', need ",
+			      Number_of_bytes(Nvme::IO_QUEUE_RAM));
+			throw Service_denied();
+		}
+
+		uint16_t const qid = _driver.alloc_io_queue(label, nsid, writeable);
+		if (!qid) {
+			error("no I/O queue available for '", label, "'");
+			throw Service_denied();
+		}
+
+		Constructible<Block_session_component> &session =
+			_block_sessions[qid - 1];
+
+		try {
+			session.construct(_env, _driver.dma_buffer_construct(qid, tx_buf_size),
+			                  _request_handler, _driver.info(qid), qid);
+
+			/* issue adjacent requests of the client as one command */
+			session->merge_requests({ _driver.max_transfer(qid) });
+		} catch (...) {
+			_driver.free_io_queue(qid);
+			throw;
+		}
+		return session->cap();
 	}
 
 	void upgrade(Capability<Session>, Root::Upgrade_args const&) override { }
 
-	void close(Capability<Session>) override
+	void close(Capability<Session> cap) override
 	{
-		_block_session.destruct();
-		/*
-		 * XXX a malicious client could submit all its requests
-		 *     and close the session...
-		 */
-		_driver.dma_buffer_destruct();
+		for (Constructible<Block_session_component> &session : _block_sessions) {
+			if (!session.constructed() || !(session->cap() == cap))
+				continue;
+
+			uint16_t const qid = session->qid;
+			session.destruct();
+
+			/*
+			 * Deleting the queue pair aborts all requests the client
+			 * left in flight before the DMA buffer is released.
+			 */
+			_driver.free_io_queue(qid);
+			return;
+		}
 	}
 
 	Main(Genode::Env &env) : _env(env) {
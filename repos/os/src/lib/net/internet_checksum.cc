@@ -14,6 +14,9 @@
 /* Genode includes */
 #include <net/internet_checksum.h>
 
+/* local includes */
+#include <internet_checksum_helper.h>
+
 using namespace Net;
 using namespace Genode;
 
@@ -42,10 +45,11 @@ static uint16_t checksum_of_raw_data(Packed_uint16 const *data_ptr,
                                      signed long          sum)
 {
 	/* add up bytes in pairs */
-	for (; data_sz > 1; data_sz -= sizeof(Packed_uint16)) {
-		sum += data_ptr->value;
-		data_ptr++;
-	}
+	size_t const num_words = data_sz / sizeof(Packed_uint16);
+	sum += (signed long)sum_of_16bit_words(data_ptr, num_words);
+	data_ptr += num_words;
+	data_sz  -= num_words * sizeof(Packed_uint16);
+
 	/* add left-over byte, if any */
 	if (data_sz > 0) {
 		sum += ((Packed_uint8 const *)data_ptr)->value;
@@ -61,6 +65,12 @@ static uint16_t checksum_of_raw_data(Packed_uint16 const *data_ptr,
  ** Internet_checksum **
  ***********************/
 
+char const *Net::internet_checksum_variant()
+{
+	return sum_of_16bit_words_variant();
+}
+
+
 uint16_t Net::internet_checksum(Packed_uint16 const *data_ptr,
                                 size_t               data_sz)
 {
@@ -100,13 +110,19 @@ void Internet_checksum_diff::add_up_diff(Packed_uint16 const *new_data_ptr,
                                          Packed_uint16 const *old_data_ptr,
                                          size_t               data_sz)
 {
-	/* add up byte differences in pairs */
-	signed long diff { 0 };
-	for (; data_sz > 1; data_sz -= sizeof(Packed_uint16)) {
-		diff += old_data_ptr->value - new_data_ptr->value;
-		old_data_ptr++;
-		new_data_ptr++;
-	}
+	/*
+	 * Add up byte differences in pairs. As both sums are exact, the
+	 * difference of the sums equals the sum of the differences.
+	 */
+	size_t const num_words = data_sz / sizeof(Packed_uint16);
+	signed long diff {
+		(signed long)sum_of_16bit_words(old_data_ptr, num_words) -
+		(signed long)sum_of_16bit_words(new_data_ptr, num_words) };
+
+	old_data_ptr += num_words;
+	new_data_ptr += num_words;
+	data_sz      -= num_words * sizeof(Packed_uint16);
+
 	/* add difference of left-over byte, if any */
 	if (data_sz > 0) {
 		diff += *(uint8_t *)old_data_ptr - *(uint8_t *)new_data_ptr;
@@ -0,0 +1,80 @@
+/*
+ * \brief  SIMD accumulation of 16-bit words for the Internet Checksum
+ * \author agent
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _LIB__NET__INTERNET_CHECKSUM_VECTOR_H_
+#define _LIB__NET__INTERNET_CHECKSUM_VECTOR_H_
+
+/* local includes */
+#include <internet_checksum_word.h>
+
+namespace Net {
+
+	/*
+	 * Vector paths are not worth their setup for very small regions like
+	 * the address and port fields that are modified when routing packets.
+	 */
+	enum { MIN_VECTOR_WORDS = 32 };
+
+	/*
+	 * We use the GCC vector extensions instead of the intrinsics headers
+	 * as the latter depend on the C library. For 16-byte vectors, the
+	 * compiler emits SSE2 instructions on x86_64 and NEON instructions on
+	 * ARMv8-A, both being mandatory parts of the respective architecture.
+	 */
+	typedef Genode::uint32_t Vector_128 __attribute__((vector_size(16)));
+
+	/**
+	 * Return exact sum of 16-bit words using 128-bit loads
+	 *
+	 * Each 32-bit lane accumulates the lower and the upper 16-bit word of
+	 * the corresponding 32 bits of data.
+	 */
+	static inline Genode::uint64_t
+	sum_of_16bit_words_vector_128(Packed_uint16 const *data_ptr,
+	                              Genode::size_t       num_words)
+	{
+		using Genode::uint64_t;
+		using Genode::size_t;
+
+		enum { WORDS_PER_VECTOR = sizeof(Vector_128) / sizeof(Packed_uint16) };
+
+		Vector_128 const lane_mask = { 0xffff, 0xffff, 0xffff, 0xffff };
+
+		uint64_t    sum = 0;
+		size_t      num_iterations = num_words / WORDS_PER_VECTOR;
+		char const *vector_ptr = (char const *)data_ptr;
+
+		while (num_iterations) {
+
+			size_t const round =
+				Genode::min(num_iterations, (size_t)MAX_LANE_ITERATIONS);
+
+			Vector_128 lanes = { 0, 0, 0, 0 };
+			for (size_t i = 0; i < round; i++, vector_ptr += sizeof(Vector_128)) {
+
+				/* the data is not necessarily aligned */
+				Vector_128 v;
+				__builtin_memcpy(&v, vector_ptr, sizeof(v));
+
+				lanes += v & lane_mask;
+				lanes += v >> 16;
+			}
+			sum += (uint64_t)lanes[0] + lanes[1] + lanes[2] + lanes[3];
+			num_iterations -= round;
+		}
+		return sum + sum_of_16bit_words_word_wide((Packed_uint16 const *)vector_ptr,
+		                                          num_words % WORDS_PER_VECTOR);
+	}
+}
+
+#endif /* _LIB__NET__INTERNET_CHECKSUM_VECTOR_H_ */
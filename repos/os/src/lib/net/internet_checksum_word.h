@@ -0,0 +1,90 @@
+/*
+ * \brief  Word-wide accumulation of 16-bit words for the Internet Checksum
+ * \author agent
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _LIB__NET__INTERNET_CHECKSUM_WORD_H_
+#define _LIB__NET__INTERNET_CHECKSUM_WORD_H_
+
+/* Genode includes */
+#include <net/internet_checksum.h>
+
+namespace Net {
+
+	struct Packed_uint64
+	{
+		Genode::uint64_t value;
+
+	} __attribute__((packed));
+
+	/**
+	 * Maximum number of iterations that a 32-bit lane can absorb
+	 *
+	 * Each iteration of the accumulation loops adds at most two 16-bit words
+	 * to a 32-bit lane, hence, after 2^15 iterations, a lane must be folded
+	 * into the 64-bit result.
+	 */
+	enum { MAX_LANE_ITERATIONS = 1 << 15 };
+
+	/**
+	 * Return exact sum of 16-bit words using one load per 16-bit word
+	 */
+	static inline Genode::uint64_t
+	sum_of_16bit_words_scalar(Packed_uint16 const *data_ptr,
+	                          Genode::size_t       num_words)
+	{
+		Genode::uint64_t sum = 0;
+		for (; num_words; num_words--, data_ptr++)
+			sum += data_ptr->value;
+
+		return sum;
+	}
+
+	/**
+	 * Return exact sum of 16-bit words using 64-bit loads
+	 *
+	 * Each 64-bit load is split into two 32-bit lanes of which each
+	 * accumulates two of the four 16-bit words. As the result is the exact
+	 * (unfolded) sum, it is independent of the byte order.
+	 */
+	static inline Genode::uint64_t
+	sum_of_16bit_words_word_wide(Packed_uint16 const *data_ptr,
+	                             Genode::size_t       num_words)
+	{
+		using Genode::uint64_t;
+		using Genode::size_t;
+
+		static constexpr uint64_t LANE_MASK = 0x0000ffff0000ffffULL;
+
+		uint64_t sum = 0;
+		size_t   num_iterations = num_words / 4;
+		Packed_uint64 const *word_ptr = (Packed_uint64 const *)data_ptr;
+
+		while (num_iterations) {
+
+			size_t const round =
+				Genode::min(num_iterations, (size_t)MAX_LANE_ITERATIONS);
+
+			uint64_t lanes = 0;
+			for (size_t i = 0; i < round; i++, word_ptr++) {
+				uint64_t const word = word_ptr->value;
+				lanes += word & LANE_MASK;
+				lanes += (word >> 16) & LANE_MASK;
+			}
+			sum += (lanes & 0xffffffff) + (lanes >> 32);
+			num_iterations -= round;
+		}
+		return sum + sum_of_16bit_words_scalar((Packed_uint16 const *)word_ptr,
+		                                       num_words % 4);
+	}
+}
+
+#endif /* _LIB__NET__INTERNET_CHECKSUM_WORD_H_ */
@@ -0,0 +1,40 @@
+/*
+ * \brief  NEON accumulation of 16-bit words for the Internet Checksum
+ * \author agent
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _LIB__NET__SPEC__ARM_64__INTERNET_CHECKSUM_HELPER_H_
+#define _LIB__NET__SPEC__ARM_64__INTERNET_CHECKSUM_HELPER_H_
+
+/* local includes */
+#include <internet_checksum_vector.h>
+
+namespace Net {
+
+	static inline char const *sum_of_16bit_words_variant() { return "neon"; }
+
+	/**
+	 * Return exact (unfolded) sum of the given 16-bit words
+	 *
+	 * NEON is mandatory on ARMv8-A, so there is no need for runtime dispatch.
+	 */
+	static inline Genode::uint64_t
+	sum_of_16bit_words(Packed_uint16 const *data_ptr,
+	                   Genode::size_t       num_words)
+	{
+		if (num_words < MIN_VECTOR_WORDS)
+			return sum_of_16bit_words_word_wide(data_ptr, num_words);
+
+		return sum_of_16bit_words_vector_128(data_ptr, num_words);
+	}
+}
+
+#endif /* _LIB__NET__SPEC__ARM_64__INTERNET_CHECKSUM_HELPER_H_ */
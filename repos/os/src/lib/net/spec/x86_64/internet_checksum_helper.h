@@ -0,0 +1,128 @@
+/*
+ * \brief  SSE2/AVX2 accumulation of 16-bit words for the Internet Checksum
+ * \author agent
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _LIB__NET__SPEC__X86_64__INTERNET_CHECKSUM_HELPER_H_
+#define _LIB__NET__SPEC__X86_64__INTERNET_CHECKSUM_HELPER_H_
+
+/* local includes */
+#include <internet_checksum_vector.h>
+
+namespace Net {
+
+	/**
+	 * Return whether the CPU supports AVX2 and the kernel saves the YMM state
+	 */
+	static inline bool avx2_usable()
+	{
+		struct Cpuid { unsigned eax, ebx, ecx, edx; };
+
+		auto cpuid = [] (unsigned leaf)
+		{
+			Cpuid r { leaf, 0, 0, 0 };
+			asm volatile ("cpuid"
+			              : "+a" (r.eax), "=b" (r.ebx), "+c" (r.ecx), "=d" (r.edx));
+			return r;
+		};
+
+		if (cpuid(0).eax < 7)
+			return false;
+
+		/* CPUID.1:ECX.OSXSAVE[bit 27] and CPUID.1:ECX.AVX[bit 28] */
+		if ((cpuid(1).ecx & (3U << 27)) != (3U << 27))
+			return false;
+
+		/* XCR0 must have the SSE and AVX state components enabled */
+		unsigned xcr0_lo = 0, xcr0_hi = 0;
+		asm volatile ("xgetbv" : "=a" (xcr0_lo), "=d" (xcr0_hi) : "c" (0));
+		if ((xcr0_lo & 0x6) != 0x6)
+			return false;
+
+		/* CPUID.(EAX=7,ECX=0):EBX.AVX2[bit 5] */
+		return cpuid(7).ebx & (1U << 5);
+	}
+
+	typedef Genode::uint32_t Vector_256 __attribute__((vector_size(32)));
+
+	/**
+	 * Return exact sum of 16-bit words using 256-bit AVX2 loads
+	 */
+	__attribute__((target("avx2")))
+	static Genode::uint64_t
+	sum_of_16bit_words_avx2(Packed_uint16 const *data_ptr,
+	                        Genode::size_t       num_words)
+	{
+		using Genode::uint64_t;
+		using Genode::size_t;
+
+		enum { WORDS_PER_VECTOR = sizeof(Vector_256) / sizeof(Packed_uint16) };
+
+		Vector_256 const lane_mask = { 0xffff, 0xffff, 0xffff, 0xffff,
+		                               0xffff, 0xffff, 0xffff, 0xffff };
+
+		uint64_t    sum = 0;
+		size_t      num_iterations = num_words / WORDS_PER_VECTOR;
+		char const *vector_ptr = (char const *)data_ptr;
+
+		while (num_iterations) {
+
+			size_t const round =
+				Genode::min(num_iterations, (size_t)MAX_LANE_ITERATIONS);
+
+			Vector_256 lanes = { 0, 0, 0, 0, 0, 0, 0, 0 };
+			for (size_t i = 0; i < round; i++, vector_ptr += sizeof(Vector_256)) {
+
+				/* the data is not necessarily aligned */
+				Vector_256 v;
+				__builtin_memcpy(&v, vector_ptr, sizeof(v));
+
+				lanes += v & lane_mask;
+				lanes += v >> 16;
+			}
+			for (unsigned i = 0; i < 8; i++)
+				sum += lanes[i];
+
+			num_iterations -= round;
+		}
+		return sum + sum_of_16bit_words_vector_128((Packed_uint16 const *)vector_ptr,
+		                                           num_words % WORDS_PER_VECTOR);
+	}
+
+	static inline bool avx2_selected()
+	{
+		static bool const avx2 = avx2_usable();
+		return avx2;
+	}
+
+	static inline char const *sum_of_16bit_words_variant()
+	{
+		return avx2_selected() ? "avx2" : "sse2";
+	}
+
+	/**
+	 * Return exact (unfolded) sum of the given 16-bit words
+	 */
+	static inline Genode::uint64_t
+	sum_of_16bit_words(Packed_uint16 const *data_ptr,
+	                   Genode::size_t       num_words)
+	{
+		if (num_words < MIN_VECTOR_WORDS)
+			return sum_of_16bit_words_word_wide(data_ptr, num_words);
+
+		if (avx2_selected())
+			return sum_of_16bit_words_avx2(data_ptr, num_words);
+
+		return sum_of_16bit_words_vector_128(data_ptr, num_words);
+	}
+}
+
+#endif /* _LIB__NET__SPEC__X86_64__INTERNET_CHECKSUM_HELPER_H_ */
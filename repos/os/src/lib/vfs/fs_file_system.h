@@ -19,6 +19,7 @@
 /* Genode includes */
 #include <base/allocator_avl.h>
 #include <base/id_space.h>
+#include <base/registry.h>
 #include <file_system_session/connection.h>
 
 namespace Vfs { class Fs_file_system; }
@@ -28,6 +29,9 @@ class Vfs::Fs_file_system : public File_system, private Remote_io
 {
 	private:
 
+		/* maximum number of read-ahead packets per file handle */
+		enum { MAX_READ_AHEAD = 15 };
+
 		Vfs::Env              &_env;
 		Genode::Allocator_avl  _fs_packet_alloc { &_env.alloc() };
 
@@ -41,11 +45,43 @@ class Vfs::Fs_file_system : public File_system, private Remote_io
 
 		bool _write_would_block = false;
 
+		/* number of packets to read ahead of the current read, 0 disables */
+		unsigned const _read_ahead;
+
+		size_t _read_ahead_bytes = 0;
+
+		/*
+		 * Limit buffer space used for read-ahead data to leave room for the
+		 * requests of other handles
+		 */
+		bool _read_ahead_exhausted() {
+			return _read_ahead_bytes >= _fs.tx()->bulk_buffer_size() / 2; }
+
 		using Handle_space = Genode::Id_space<::File_system::Node>;
 
 		Handle_space _handle_space { };
 		Handle_space _watch_handle_space { };
 
+		/*
+		 * File handle kept open as long as the dataspace obtained for the
+		 * file is in use
+		 */
+		struct Mapped_file : Genode::Registry<Mapped_file>::Element
+		{
+			::File_system::File_handle const handle;
+			Dataspace_capability       const ds;
+
+			Mapped_file(Genode::Registry<Mapped_file> &registry,
+			            ::File_system::File_handle handle,
+			            Dataspace_capability ds)
+			:
+				Genode::Registry<Mapped_file>::Element(registry, *this),
+				handle(handle), ds(ds)
+			{ }
+		};
+
+		Genode::Registry<Mapped_file> _mapped_files { };
+
 		struct Handle_state
 		{
 			enum class Read_ready_state { IDLE, PENDING, READY };
@@ -89,6 +125,36 @@ class Vfs::Fs_file_system : public File_system, private Remote_io
 			_peer.schedule_wakeup();
 		}
 
+		/*
+		 * Allocate packet, reclaiming space held by read-ahead data if needed
+		 *
+		 * \throw Packet_alloc_failed
+		 */
+		::File_system::Packet_descriptor _alloc_packet(size_t size)
+		{
+			using Source = ::File_system::Session::Tx::Source;
+
+			try { return _fs.tx()->alloc_packet(size); }
+			catch (Source::Packet_alloc_failed) {
+				if (!_discard_read_ahead())
+					throw;
+			}
+			return _fs.tx()->alloc_packet(size);
+		}
+
+		/*
+		 * Discard the read-ahead data of all handles
+		 *
+		 * \return true if buffer space was freed
+		 */
+		bool _discard_read_ahead()
+		{
+			bool freed = false;
+			_handle_space.for_each<Fs_vfs_handle>([&] (Fs_vfs_handle &handle) {
+				freed |= handle.discard_read_ahead(); });
+			return freed;
+		}
+
 		/**
 		 * Convert 'File_system::Node_type' to 'Dirent_type'
 		 */
@@ -165,7 +231,7 @@ class Vfs::Fs_file_system : public File_system, private Remote_io
 
 				::File_system::Packet_descriptor p;
 				try {
-					p = source.alloc_packet((size_t)clipped_count);
+					p = _vfs_fs._alloc_packet((size_t)clipped_count);
 				} catch (::File_system::Session::Tx::Source::Packet_alloc_failed) {
 					return false;
 				}
@@ -239,6 +305,22 @@ class Vfs::Fs_file_system : public File_system, private Remote_io
 				return READ_ERR_INVALID;
 			}
 
+			/**
+			 * Called on the acknowledgement of a read packet
+			 */
+			virtual void read_acked(::File_system::Packet_descriptor const &packet)
+			{
+				queued_read_packet = packet;
+				queued_read_state  = Handle_state::Queued_state::ACK;
+			}
+
+			/**
+			 * Drop data read ahead of the current read
+			 *
+			 * \return true if buffer space was freed
+			 */
+			virtual bool discard_read_ahead() { return false; }
+
 			bool queue_sync()
 			{
 				if (queued_sync_state != Handle_state::Queued_state::IDLE)
@@ -314,18 +396,189 @@ class Vfs::Fs_file_system : public File_system, private Remote_io
 			}
 		};
 
+		/*
+		 * File handle that optionally reads ahead of sequential reads
+		 *
+		 * With read-ahead enabled, each read is followed by up to
+		 * '_read_ahead' packets that request the subsequent chunks of the
+		 * file. Those packets are processed by the server while the client
+		 * consumes the current chunk. A read at another position, a write,
+		 * or a short read discards the data read ahead.
+		 */
 		struct Fs_vfs_file_handle : Fs_vfs_handle
 		{
+			using Queued_state = Fs_file_system::Handle_state::Queued_state;
+
+			struct Read_ahead_slot
+			{
+				::File_system::Packet_descriptor packet;
+				size_t                           length;  /* requested bytes */
+				bool                             acked;
+			};
+
+			/* slots in the order of file position, the first one is the current read */
+			Read_ahead_slot _slots[MAX_READ_AHEAD + 1] { };
+			unsigned        _first = 0;
+			unsigned        _count = 0;
+
+			Read_ahead_slot &_slot(unsigned i) {
+				return _slots[(_first + i) % (MAX_READ_AHEAD + 1)]; }
+
+			void _release(Read_ahead_slot const &slot)
+			{
+				if (slot.acked)
+					_vfs_fs._fs.tx()->release_packet(slot.packet);
+
+				_vfs_fs._read_ahead_bytes -= slot.length;
+			}
+
+			bool _submit_read(file_size position, size_t count, bool may_reclaim)
+			{
+				::File_system::Session::Tx::Source &source = *_vfs_fs._fs.tx();
+
+				if (_count > _vfs_fs._read_ahead || !source.ready_to_submit())
+					return false;
+
+				size_t const length = min(source.bulk_buffer_size() / 2, count);
+
+				::File_system::Packet_descriptor p;
+				try {
+					p = may_reclaim ? _vfs_fs._alloc_packet(length)
+					                : source.alloc_packet(length);
+				} catch (::File_system::Session::Tx::Source::Packet_alloc_failed) {
+					return false;
+				}
+
+				::File_system::Packet_descriptor const
+					packet(p, file_handle(),
+					       ::File_system::Packet_descriptor::READ,
+					       length, position);
+
+				_slot(_count++) = { .packet = packet, .length = length, .acked = false };
+				_vfs_fs._read_ahead_bytes += length;
+
+				_vfs_fs._submit_packet(packet);
+				return true;
+			}
+
+			void _fill_read_ahead(file_size position, size_t count)
+			{
+				while (!_vfs_fs._read_ahead_exhausted()) {
+
+					if (_count) {
+						Read_ahead_slot &last = _slot(_count - 1);
+						position = last.packet.position() + last.length;
+					}
+
+					if (!_submit_read(position, count, false))
+						return;
+				}
+			}
+
 			using Fs_vfs_handle::Fs_vfs_handle;
 
+			~Fs_vfs_file_handle()
+			{
+				queued_read_state = Queued_state::IDLE;
+				discard_read_ahead();
+			}
+
 			bool queue_read(size_t count) override
 			{
-				return _queue_read(count, seek());
+				if (!_vfs_fs._read_ahead)
+					return _queue_read(count, seek());
+
+				if (queued_read_state != Queued_state::IDLE)
+					return false;
+
+				if (_count && (_slot(0).packet.position() != seek()
+				            || _slot(0).length > count))
+					discard_read_ahead();
+
+				if (!_count && !_submit_read(seek(), count, true))
+					return false;
+
+				read_ready_state  = Fs_file_system::Handle_state::Read_ready_state::IDLE;
+				queued_read_state = Queued_state::QUEUED;
+
+				_fill_read_ahead(seek(), _slot(0).length);
+				return true;
 			}
 
 			Read_result complete_read(Byte_range_ptr const &dst, size_t &out_count) override
 			{
-				return _complete_read(dst, out_count);
+				if (!_vfs_fs._read_ahead)
+					return _complete_read(dst, out_count);
+
+				if (queued_read_state == Queued_state::IDLE || !_count)
+					return READ_ERR_INVALID;
+
+				Read_ahead_slot const slot = _slot(0);
+				if (!slot.acked)
+					return READ_QUEUED;
+
+				Read_result const result = slot.packet.succeeded() ? READ_OK : READ_ERR_IO;
+
+				size_t read_num_bytes = 0;
+				if (result == READ_OK) {
+					read_num_bytes = min(slot.packet.length(), dst.num_bytes);
+
+					memcpy(dst.start, _vfs_fs._fs.tx()->packet_content(slot.packet),
+					       read_num_bytes);
+
+					out_count = read_num_bytes;
+				}
+
+				_release(slot);
+				_first = (_first + 1) % (MAX_READ_AHEAD + 1);
+				_count--;
+
+				queued_read_state = Queued_state::IDLE;
+
+				/* a short read marks the end of the file */
+				if (result != READ_OK || read_num_bytes < slot.length)
+					discard_read_ahead();
+				else
+					_fill_read_ahead(slot.packet.position() + read_num_bytes,
+					                 slot.length);
+
+				return result;
+			}
+
+			void read_acked(::File_system::Packet_descriptor const &packet) override
+			{
+				if (!_vfs_fs._read_ahead) {
+					Fs_vfs_handle::read_acked(packet);
+					return;
+				}
+
+				for (unsigned i = 0; i < _count; i++) {
+					Read_ahead_slot &slot = _slot(i);
+					if (!slot.acked && slot.packet.offset() == packet.offset()) {
+						slot.packet = packet;
+						slot.acked  = true;
+						return;
+					}
+				}
+
+				/* packet was discarded while in flight */
+				_vfs_fs._fs.tx()->release_packet(packet);
+			}
+
+			bool discard_read_ahead() override
+			{
+				bool freed = false;
+
+				/* keep the slot of the current read */
+				unsigned const keep =
+					(queued_read_state != Queued_state::IDLE) ? 1 : 0;
+
+				while (_count > keep) {
+					Read_ahead_slot const &slot = _slot(--_count);
+					freed |= slot.acked;
+					_release(slot);
+				}
+				return freed;
 			}
 		};
 
@@ -464,7 +717,7 @@ class Vfs::Fs_file_system : public File_system, private Remote_io
 			}
 
 			try {
-				Packet_descriptor packet_in(source.alloc_packet(count),
+				Packet_descriptor packet_in(_alloc_packet(count),
 				                            handle.file_handle(),
 				                            Packet_descriptor::WRITE,
 				                            count,
@@ -513,8 +766,7 @@ class Vfs::Fs_file_system : public File_system, private Remote_io
 						break;
 
 					case Packet_descriptor::READ:
-						handle.queued_read_packet = packet;
-						handle.queued_read_state  = Handle_state::Queued_state::ACK;
+						handle.read_acked(packet);
 						break;
 
 					case Packet_descriptor::WRITE:
@@ -544,7 +796,13 @@ class Vfs::Fs_file_system : public File_system, private Remote_io
 					}
 				}
 				catch (Handle_space::Unknown_id) {
-					Genode::warning("ack for unknown File_system handle ", id); }
+
+					/* read data arriving after the handle was closed */
+					if (packet.operation() == Packet_descriptor::READ)
+						source.release_packet(packet);
+					else
+						Genode::warning("ack for unknown File_system handle ", id);
+				}
 
 				if (packet.succeeded())
 					any_ack_handled = true;
@@ -563,6 +821,12 @@ class Vfs::Fs_file_system : public File_system, private Remote_io
 			return config.attribute_value("buffer_size", fs_default);
 		}
 
+		static unsigned read_ahead(Genode::Xml_node const &config)
+		{
+			return Genode::min(config.attribute_value("read_ahead", 0U),
+			                   (unsigned)MAX_READ_AHEAD);
+		}
+
 	public:
 
 		Fs_file_system(Vfs::Env &env, Genode::Xml_node config)
@@ -573,7 +837,8 @@ class Vfs::Fs_file_system : public File_system, private Remote_io
 			_fs(_env.env(), _fs_packet_alloc,
 			    _label.string(), _root.string(),
 			    config.attribute_value("writeable", true),
-			    buffer_size(config))
+			    buffer_size(config)),
+			_read_ahead(read_ahead(config))
 		{
 			_fs.sigh(_signal_handler);
 		}
@@ -582,13 +847,50 @@ class Vfs::Fs_file_system : public File_system, private Remote_io
 		 ** Directory-service interface **
 		 *********************************/
 
-		Dataspace_capability dataspace(char const *) override
+		Dataspace_capability dataspace(char const *path) override
 		{
-			/* cannot be implemented without blocking */
+			Absolute_path dir_path(path);
+			dir_path.strip_last_element();
+
+			Absolute_path file_name(path);
+			file_name.keep_only_last_element();
+
+			try {
+				::File_system::Dir_handle dir = _fs.dir(dir_path.base(), false);
+				Fs_handle_guard dir_guard(*this, dir, _handle_space, *this);
+
+				::File_system::File_handle file =
+					_fs.file(dir, file_name.base() + 1,
+					         ::File_system::READ_ONLY, false);
+
+				/* the server may not support dataspaces for this file */
+				Dataspace_capability const ds = _fs.dataspace(file);
+				if (!ds.valid()) {
+					_fs.close(file);
+					return Dataspace_capability();
+				}
+
+				new (_env.alloc()) Mapped_file(_mapped_files, file, ds);
+				return ds;
+			}
+			catch (...) { }
+
 			return Dataspace_capability();
 		}
 
-		void release(char const *, Dataspace_capability) override { }
+		void release(char const *, Dataspace_capability ds) override
+		{
+			_mapped_files.for_each([&] (Mapped_file &mapped_file) {
+				if (!(mapped_file.ds == ds))
+					return;
+
+				try { _fs.close(mapped_file.handle); }
+				catch (::File_system::Invalid_handle) { }
+
+				destroy(_env.alloc(), &mapped_file);
+				ds = Dataspace_capability();
+			});
+		}
 
 		Stat_result stat(char const *path, Stat &out) override
 		{
@@ -892,6 +1194,8 @@ class Vfs::Fs_file_system : public File_system, private Remote_io
 		{
 			Fs_vfs_handle &handle = static_cast<Fs_vfs_handle &>(*vfs_handle);
 
+			handle.discard_read_ahead();
+
 			return _write(handle, handle.seek(), src, out_count);
 		}
 
@@ -955,7 +1259,9 @@ class Vfs::Fs_file_system : public File_system, private Remote_io
 
 		Ftruncate_result ftruncate(Vfs_handle *vfs_handle, file_size len) override
 		{
-			Fs_vfs_handle const *handle = static_cast<Fs_vfs_handle *>(vfs_handle);
+			Fs_vfs_handle *handle = static_cast<Fs_vfs_handle *>(vfs_handle);
+
+			handle->discard_read_ahead();
 
 			try {
 				_fs.truncate(handle->file_handle(), len);
@@ -990,4 +1296,5 @@ class Vfs::Fs_file_system : public File_system, private Remote_io
 		}
 };
 
+
 #endif /* _INCLUDE__VFS__FS_FILE_SYSTEM_H_ */
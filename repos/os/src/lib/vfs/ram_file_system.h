@@ -15,9 +15,11 @@
 #define _INCLUDE__VFS__RAM_FILE_SYSTEM_H_
 
 #include <ram_fs/chunk.h>
-#include <ram_fs/param.h>
 #include <vfs/file_system.h>
+#include <base/attached_ram_dataspace.h>
 #include <dataspace/client.h>
+#include <region_map/client.h>
+#include <rm_session/connection.h>
 #include <util/avl_tree.h>
 
 namespace Vfs { class Ram_file_system; }
@@ -26,14 +28,12 @@ namespace Vfs_ram {
 
 	using namespace Genode;
 	using namespace Vfs;
-	using namespace Ram_fs;
-	using ::File_system::Chunk;
-	using ::File_system::Chunk_index;
 
 	struct Io_handle;
 	struct Watch_handle;
 
 	class Node;
+	class Extent;
 	class File;
 	class Symlink;
 	class Directory;
@@ -251,56 +251,427 @@ class Vfs_ram::Node : private Genode::Avl_node<Node>
 };
 
 
+/**
+ * Backing store of file content
+ *
+ * Small extents are allocated from the heap whereas large extents are backed
+ * by a RAM dataspace of their own. Heap extents stay below the size for which
+ * the heap allocates a dedicated dataspace, so only dataspace-backed extents
+ * consume a capability. Extents are reference counted. An extent referenced
+ * by an exported dataspace is copied before the file modifies it (copy on
+ * write).
+ */
+class Vfs_ram::Extent
+{
+	private:
+
+		/*
+		 * Noncopyable
+		 */
+		Extent(Extent const &);
+		Extent &operator = (Extent const &);
+
+		Allocator &_alloc;
+
+		size_t const _size;
+
+		Constructible<Attached_ram_dataspace> _ds { };
+
+		char *_buf = nullptr;
+
+		unsigned _refs    = 1;
+		unsigned _exports = 0;
+
+	public:
+
+		enum {
+			PAGE_SIZE_LOG2 = 12,
+			PAGE_SIZE      = 1 << PAGE_SIZE_LOG2,
+			MIN_SIZE       = 64,
+			HEAP_MAX_SIZE  = 32*1024,
+			DS_MIN_SIZE    = 256*1024,
+			MAX_SIZE       = 16*1024*1024,
+		};
+
+		enum class Backing { HEAP, DATASPACE };
+
+		/**
+		 * Constructor
+		 *
+		 * \throw Out_of_memory
+		 */
+		Extent(Vfs::Env &env, size_t size, Backing backing)
+		:
+			_alloc(env.alloc()), _size(size)
+		{
+			if (backing == Backing::DATASPACE) {
+				try { _ds.construct(env.env().ram(), env.env().rm(), size); }
+				catch (Out_of_caps) { throw Out_of_memory(); }
+				return;
+			}
+
+			try { _buf = (char *)_alloc.alloc(size); }
+			catch (Out_of_caps) { throw Out_of_memory(); }
+
+			memset(_buf, 0, size);
+		}
+
+		~Extent() { if (_buf) _alloc.free(_buf, _size); }
+
+		size_t size() const { return _size; }
+
+		char *base() { return _ds.constructed() ? _ds->local_addr<char>() : _buf; }
+
+		bool dataspace() const { return _ds.constructed(); }
+
+		Dataspace_capability cap() const {
+			return _ds.constructed() ? Dataspace_capability(_ds->cap())
+			                         : Dataspace_capability(); }
+
+		void ref() { _refs++; }
+
+		bool shared() const { return _refs > 1; }
+
+		/**
+		 * Acquire reference on behalf of an exported dataspace
+		 */
+		void export_ref() { _refs++; _exports++; }
+
+		bool exported() const { return _exports > 0; }
+
+		/**
+		 * Drop reference to 'extent' and destroy it with the last one
+		 */
+		static void release(Extent &extent)
+		{
+			if (--extent._refs == 0)
+				destroy(extent._alloc, &extent);
+		}
+
+		/**
+		 * Drop reference acquired via 'export_ref'
+		 */
+		static void release_export(Extent &extent)
+		{
+			extent._exports--;
+			release(extent);
+		}
+};
+
+
 class Vfs_ram::File : public Vfs_ram::Node
 {
 	private:
 
-		using Chunk_level_3 = Chunk      <num_level_3_entries()>;
-		using Chunk_level_2 = Chunk_index<num_level_2_entries(), Chunk_level_3>;
-		using Chunk_level_1 = Chunk_index<num_level_1_entries(), Chunk_level_2>;
-		using Chunk_level_0 = Chunk_index<num_level_0_entries(), Chunk_level_1>;
+		/*
+		 * Noncopyable
+		 */
+		File(File const &);
+		File &operator = (File const &);
+
+		Vfs::Env &_env;
+
+		/*
+		 * Range of file content stored at 'extent_offset' within 'extent'
+		 *
+		 * Runs backed by a dataspace are page-aligned in offset, size, and
+		 * extent offset. Bytes of a run beyond the file length are zero.
+		 */
+		struct Run
+		{
+			size_t  offset;
+			size_t  size;
+			Extent *extent;
+			size_t  extent_offset;
+
+			size_t end() const { return offset + size; }
+
+			char *base() const { return extent->base() + extent_offset; }
+		};
 
-		Chunk_level_0 _chunk;
+		Run     *_runs     = nullptr;  /* sorted by offset, gaps are holes */
+		unsigned _num_runs = 0;
+		unsigned _max_runs = 0;
 
 		size_t _length = 0;
 
+		enum { COW_GRANULE_LOG2 = 14 };
+
+		static size_t _page_aligned(size_t size) {
+			return size & ~((size_t)Extent::PAGE_SIZE - 1); }
+
+		/**
+		 * Make room for at least 'num' runs
+		 *
+		 * \throw Out_of_memory
+		 */
+		void _reserve_runs(unsigned num)
+		{
+			if (num <= _max_runs)
+				return;
+
+			unsigned const max_runs = max(max(2*_max_runs, 4U), num);
+
+			Run * const runs = (Run *)_env.alloc().alloc(max_runs*sizeof(Run));
+			for (unsigned i = 0; i < _num_runs; i++)
+				runs[i] = _runs[i];
+
+			if (_runs)
+				_env.alloc().free(_runs, _max_runs*sizeof(Run));
+
+			_runs     = runs;
+			_max_runs = max_runs;
+		}
+
+		/**
+		 * Insert 'run' at index 'i', the capacity must have been reserved
+		 */
+		void _insert_run(unsigned i, Run const &run)
+		{
+			for (unsigned j = _num_runs; j > i; j--)
+				_runs[j] = _runs[j - 1];
+
+			_runs[i] = run;
+			_num_runs++;
+		}
+
+		void _remove_run(unsigned i)
+		{
+			Extent::release(*_runs[i].extent);
+
+			for (unsigned j = i + 1; j < _num_runs; j++)
+				_runs[j - 1] = _runs[j];
+
+			_num_runs--;
+		}
+
+		/**
+		 * Return index of the first run that ends beyond 'offset'
+		 *
+		 * The run contains 'offset' unless 'offset' lies within a hole.
+		 */
+		unsigned _run_index(size_t offset) const
+		{
+			unsigned lo = 0, hi = _num_runs;
+			while (lo < hi) {
+				unsigned const mid = (lo + hi)/2;
+				if (_runs[mid].end() <= offset)
+					lo = mid + 1;
+				else
+					hi = mid;
+			}
+			return lo;
+		}
+
+		bool _contains(unsigned i, size_t offset) const {
+			return i < _num_runs && _runs[i].offset <= offset; }
+
+		/**
+		 * Allocate extent, throws 'Out_of_memory' on exhausted RAM or caps
+		 */
+		Extent &_new_extent(size_t size, Extent::Backing backing)
+		{
+			try { return *new (_env.alloc()) Extent(_env, size, backing); }
+			catch (Out_of_caps) { throw Out_of_memory(); }
+		}
+
+		/**
+		 * Store the range from 'start' to 'end' in the new 'extent'
+		 *
+		 * Runs overlapping the range are trimmed or dropped. The file takes
+		 * over the reference of 'extent'.
+		 *
+		 * \throw Out_of_memory
+		 */
+		void _replace(size_t start, size_t end, Extent &extent)
+		{
+			try { _reserve_runs(_num_runs + 2); }
+			catch (...) { Extent::release(extent); throw; }
+
+			unsigned i = _run_index(start);
+
+			/* split run that starts before the range */
+			if (_contains(i, start) && _runs[i].offset < start) {
+
+				Run const run = _runs[i];
+
+				if (run.end() > end) {
+					run.extent->ref();
+					_insert_run(i + 1, { end, run.end() - end, run.extent,
+					                     run.extent_offset + (end - run.offset) });
+				}
+				_runs[i].size = start - run.offset;
+				i++;
+			}
+
+			/* drop runs within the range, trim the run that ends beyond */
+			while (i < _num_runs && _runs[i].offset < end) {
+
+				Run &run = _runs[i];
+				if (run.end() <= end) {
+					_remove_run(i);
+					continue;
+				}
+
+				size_t const cut = end - run.offset;
+				run.offset        += cut;
+				run.size          -= cut;
+				run.extent_offset += cut;
+				break;
+			}
+
+			_insert_run(i, { start, end - start, &extent, 0 });
+		}
+
+		/**
+		 * Return index of the run containing 'offset' for modifying 'len' bytes
+		 *
+		 * If the extent of run 'i' is referenced by an exported dataspace,
+		 * the granules of the run touched by the modification are copied to
+		 * a new extent beforehand.
+		 *
+		 * \throw Out_of_memory
+		 */
+		unsigned _writeable(unsigned i, size_t offset, size_t len)
+		{
+			Run const run = _runs[i];
+			if (!run.extent->exported())
+				return i;
+
+			size_t const granule = 1UL << COW_GRANULE_LOG2;
+
+			size_t const start = max(run.offset, offset & ~(granule - 1));
+			size_t const end   = min(run.end(),
+			                         align_addr(offset + len, COW_GRANULE_LOG2));
+			size_t const size  = end - start;
+
+			Extent &copy = _new_extent(size, (size <= Extent::HEAP_MAX_SIZE)
+			                                 ? Extent::Backing::HEAP
+			                                 : Extent::Backing::DATASPACE);
+
+			memcpy(copy.base(), run.base() + (start - run.offset), size);
+
+			_replace(start, end, copy);
+
+			return _run_index(offset);
+		}
+
+		/**
+		 * Back the hole at 'offset' by memory for up to 'len' bytes
+		 *
+		 * Only a write at the end of the file allocates ahead, by a quarter of
+		 * the file length. Holes receive no more memory than written.
+		 *
+		 * \throw Out_of_memory
+		 */
+		void _fill_hole(size_t offset, size_t len)
+		{
+			unsigned const i = _run_index(offset);
+
+			size_t const hole = (i < _num_runs) ? _runs[i].offset - offset
+			                                    : ~(size_t)0 - offset;
+			len = min(len, hole);
+
+			/* extend the preceding run into the unused part of its extent */
+			if (i > 0) {
+
+				Run &prev = _runs[i - 1];
+
+				size_t const avail = prev.extent->size()
+				                   - prev.extent_offset - prev.size;
+
+				size_t const n = prev.extent->dataspace()
+				               ? _page_aligned(min(min(avail, hole),
+				                                   align_addr(len, Extent::PAGE_SIZE_LOG2)))
+				               : min(avail, len);
+
+				if (prev.end() == offset && n && !prev.extent->exported()) {
+					memset(prev.base() + prev.size, 0, n);
+					prev.size += n;
+					return;
+				}
+			}
+
+			_reserve_runs(_num_runs + 1);
+
+			bool const append = (i == _num_runs)
+			                 && (offset <= align_addr(_length, Extent::PAGE_SIZE_LOG2));
+
+			size_t const want = append ? max(len, _length/4) : len;
+
+			bool const page_aligned = !(offset & (Extent::PAGE_SIZE - 1))
+			                       && hole >= Extent::PAGE_SIZE;
+
+			if (want >= Extent::DS_MIN_SIZE && page_aligned) {
+
+				size_t const size = min(align_addr(want, Extent::PAGE_SIZE_LOG2),
+				                        (size_t)Extent::MAX_SIZE);
+
+				Extent &extent = _new_extent(size, Extent::Backing::DATASPACE);
+
+				size_t const run_size = min(size, _page_aligned(hole));
+
+				_insert_run(i, { offset, min(run_size,
+				                             align_addr(len, Extent::PAGE_SIZE_LOG2)),
+				                 &extent, 0 });
+				return;
+			}
+
+			/*
+			 * Use the heap, for large writes only up to the next page
+			 * boundary, which is the start of the following dataspace.
+			 */
+			size_t size = min(want, (size_t)Extent::HEAP_MAX_SIZE);
+
+			if (want >= Extent::DS_MIN_SIZE && (offset & (Extent::PAGE_SIZE - 1)))
+				size = Extent::PAGE_SIZE - (offset & (Extent::PAGE_SIZE - 1));
+
+			size = max(align_addr(size, 6), (size_t)Extent::MIN_SIZE);
+
+			Extent &extent = _new_extent(size, Extent::Backing::HEAP);
+
+			_insert_run(i, { offset, min(size, len), &extent, 0 });
+		}
+
 	public:
 
-		File(char const * const name, Allocator &alloc)
-		: Node(name), _chunk(alloc, Seek{0}) { }
+		File(char const * const name, Vfs::Env &env) : Node(name), _env(env) { }
 
-		size_t read(Byte_range_ptr const &dst, Seek seek) override
+		~File()
 		{
-			size_t const chunk_used_size = _chunk.used_size();
+			while (_num_runs)
+				_remove_run(_num_runs - 1);
 
+			if (_runs)
+				_env.alloc().free(_runs, _max_runs*sizeof(Run));
+		}
+
+		size_t read(Byte_range_ptr const &dst, Seek seek) override
+		{
 			if (seek.value >= _length)
 				return 0;
 
-			/*
-			 * Constrain read transaction to available chunk data
-			 *
-			 * Note that 'chunk_used_size' may be lower than '_length'
-			 * because 'Chunk' may have truncated tailing zeros.
-			 */
+			size_t const len = min(dst.num_bytes, _length - seek.value);
+			size_t const end = seek.value + len;
 
-			size_t const len = (seek.value + dst.num_bytes >= _length)
-			                 ? _length - min(_length, seek.value)
-			                 : dst.num_bytes;
+			/* holes read as zeros */
+			size_t pos = seek.value;
+			for (unsigned i = _run_index(pos); i < _num_runs && _runs[i].offset < end; i++) {
 
-			size_t read_len = len;
+				Run const &run = _runs[i];
 
-			if (seek.value + read_len > chunk_used_size) {
-				if (chunk_used_size >= seek.value)
-					read_len = chunk_used_size - seek.value;
-				else
-					read_len = 0;
-			}
+				if (run.offset > pos) {
+					memset(dst.start + (pos - seek.value), 0, run.offset - pos);
+					pos = run.offset;
+				}
 
-			_chunk.read(Byte_range_ptr(dst.start, read_len), seek);
+				size_t const n = min(end, run.end()) - pos;
+				memcpy(dst.start + (pos - seek.value), run.base() + (pos - run.offset), n);
+				pos += n;
+			}
 
-			/* add zero padding if needed */
-			if (read_len < dst.num_bytes)
-				memset(dst.start + read_len, 0, len - read_len);
+			if (pos < end)
+				memset(dst.start + (pos - seek.value), 0, end - pos);
 
 			return len;
 		}
@@ -314,35 +685,153 @@ class Vfs_ram::File : public Vfs_ram::Node
 
 		size_t write(Const_byte_range_ptr const &src, Seek const seek) override
 		{
-			size_t const at = (seek.value == ~0UL) ? _chunk.used_size() : seek.value;
+			size_t const at = (seek.value == ~0UL) ? _length : seek.value;
 
-			size_t len = src.num_bytes;
+			size_t done = 0;
+			try {
+				while (done < src.num_bytes) {
 
-			if (at + src.num_bytes >= Chunk_level_0::SIZE)
-				len = Chunk_level_0::SIZE - at + src.num_bytes;
+					size_t const pos = at + done;
+					size_t const len = src.num_bytes - done;
 
-			try { _chunk.write(src, Seek{at}); }
-			catch (Out_of_memory) { return 0; }
+					unsigned i = _run_index(pos);
+					if (!_contains(i, pos)) {
+						_fill_hole(pos, len);
+						continue;
+					}
 
-			/*
-			 * Keep track of file length. We cannot use 'chunk.used_size()'
-			 * as file length because trailing zeros may by represented
-			 * by zero chunks, which do not contribute to 'used_size()'.
-			 */
-			_length = max(_length, at + len);
+					i = _writeable(i, pos, len);
 
-			return len;
+					Run const &run = _runs[i];
+					size_t const n = min(len, run.end() - pos);
+
+					memcpy(run.base() + (pos - run.offset), src.start + done, n);
+					done += n;
+				}
+			}
+			catch (Out_of_memory) { }
+			catch (Out_of_caps)   { }
+
+			_length = max(_length, at + done);
+
+			return done;
 		}
 
 		size_t length() override { return _length; }
 
+		/**
+		 * \throw Out_of_memory
+		 */
 		void truncate(Seek size) override
 		{
-			if (size.value < _chunk.used_size())
-				_chunk.truncate(size);
+			/* extending the file leaves a hole or zeroed run tails */
+			if (size.value >= _length) {
+				_length = size.value;
+				return;
+			}
+
+			/* clear the remainder of the page at the new end, copied if exported */
+			unsigned const i = _run_index(size.value);
+			if (_contains(i, size.value) && _runs[i].extent->dataspace()) {
+
+				size_t const tail = min(_runs[i].end(),
+				                        align_addr(size.value, Extent::PAGE_SIZE_LOG2))
+				                  - size.value;
+				if (tail) {
+					unsigned const w = _writeable(i, size.value, tail);
+					Run const &run = _runs[w];
+					memset(run.base() + (size.value - run.offset), 0, tail);
+				}
+			}
+
+			while (_num_runs && _runs[_num_runs - 1].offset >= size.value)
+				_remove_run(_num_runs - 1);
+
+			/* trim the last run, keeping dataspace-backed runs page-aligned */
+			if (_num_runs && _runs[_num_runs - 1].end() > size.value) {
+
+				Run &run = _runs[_num_runs - 1];
+
+				run.size = run.extent->dataspace()
+				         ? align_addr(size.value - run.offset, Extent::PAGE_SIZE_LOG2)
+				         : size.value - run.offset;
+
+				/* move the run out of a dataspace it uses less than half of */
+				if (run.extent->dataspace() && !run.extent->shared()
+				 && 2*run.size <= run.extent->size()) {
+
+					Run const last = run;
+					try {
+						Extent &extent = _new_extent(last.size, Extent::Backing::DATASPACE);
+						memcpy(extent.base(), last.base(), last.size);
+						_replace(last.offset, last.end(), extent);
+					}
+					catch (Out_of_memory) { }
+				}
+			}
 
 			_length = size.value;
 		}
+
+		/**
+		 * Size of the dataspace exported for the file
+		 */
+		size_t export_size() const {
+			return align_addr(max(_length, (size_t)1), Extent::PAGE_SIZE_LOG2); }
+
+		/**
+		 * Prepare the file content for the export as dataspace
+		 *
+		 * Runs backed by dataspaces are exported as is. Heap-backed runs and
+		 * holes in between are copied into dataspace-backed extents of at most
+		 * 'Extent::MAX_SIZE'.
+		 *
+		 * \throw Out_of_memory
+		 */
+		void prepare_export()
+		{
+			size_t const limit = export_size();
+
+			for (size_t pos = 0; pos < limit; ) {
+
+				unsigned const i = _run_index(pos);
+
+				if (_contains(i, pos) && _runs[i].extent->dataspace()) {
+					pos = _runs[i].end();
+					continue;
+				}
+
+				size_t end = min(limit, pos + Extent::MAX_SIZE);
+				for (unsigned j = i; j < _num_runs && _runs[j].offset < end; j++)
+					if (_runs[j].offset > pos && _runs[j].extent->dataspace())
+						end = _runs[j].offset;
+
+				Extent &extent = _new_extent(end - pos, Extent::Backing::DATASPACE);
+
+				read(Byte_range_ptr(extent.base(), end - pos), Seek { pos });
+
+				_replace(pos, end, extent);
+
+				pos = end;
+			}
+		}
+
+		unsigned num_runs() const { return _num_runs; }
+
+		/**
+		 * Call 'fn(extent, extent_offset, offset, size)' for each run within
+		 * the exported range
+		 */
+		void for_each_exported_run(auto const &fn) const
+		{
+			size_t const limit = export_size();
+
+			for (unsigned i = 0; i < _num_runs && _runs[i].offset < limit; i++) {
+				Run const &run = _runs[i];
+				fn(*run.extent, run.extent_offset, run.offset,
+				   min(run.size, limit - run.offset));
+			}
+		}
 };
 
 
@@ -498,6 +987,106 @@ class Vfs::Ram_file_system : public Vfs::File_system
 		Vfs::Env           &_env;
 		Vfs_ram::Directory  _root = { "" };
 
+		/*
+		 * Region maps for exporting file content as read-only managed
+		 * dataspaces, created on the first call of 'dataspace'
+		 */
+		Genode::Constructible<Genode::Rm_connection> _rm { };
+
+		/*
+		 * Managed dataspace handed out via 'dataspace', looked up on 'release'
+		 *
+		 * The extents of the file are attached read-only and stay referenced
+		 * until the release of the dataspace.
+		 */
+		class Export : public Genode::List<Export>::Element
+		{
+			private:
+
+				/*
+				 * Noncopyable
+				 */
+				Export(Export const &);
+				Export &operator = (Export const &);
+
+				Genode::Rm_connection &_rm;
+				Genode::Allocator     &_alloc;
+
+				unsigned           const _max_extents;
+				Vfs_ram::Extent ** const _extents;
+				unsigned                 _num_extents = 0;
+
+				Genode::Capability<Genode::Region_map> _map_cap { };
+
+				Genode::Constructible<Genode::Region_map_client> _map { };
+
+				size_t _extents_size() const {
+					return _max_extents*sizeof(Vfs_ram::Extent *); }
+
+			public:
+
+				Dataspace_capability ds { };
+
+				Export(Genode::Rm_connection &rm, Genode::Allocator &alloc,
+				       size_t size, unsigned max_extents)
+				:
+					_rm(rm), _alloc(alloc), _max_extents(max_extents),
+					_extents((Vfs_ram::Extent **)alloc.alloc(_extents_size()))
+				{
+					try { _map_cap = rm.create(size); }
+					catch (...) { alloc.free(_extents, _extents_size()); throw; }
+
+					_map.construct(_map_cap);
+					ds = _map->dataspace();
+				}
+
+				~Export()
+				{
+					_rm.destroy(_map_cap);
+
+					for (unsigned i = 0; i < _num_extents; i++)
+						Vfs_ram::Extent::release_export(*_extents[i]);
+
+					_alloc.free(_extents, _extents_size());
+				}
+
+				/**
+				 * Attach 'size' bytes of 'extent' read-only at offset 'at'
+				 */
+				bool attach(Vfs_ram::Extent &extent, size_t extent_offset,
+				            size_t at, size_t size)
+				{
+					if (_num_extents == _max_extents)
+						return false;
+
+					for (;;) {
+						Genode::Region_map::Attach_result const result =
+							_map->attach(extent.cap(), {
+								.size       = size,
+								.offset     = extent_offset,
+								.use_at     = true,
+								.at         = at,
+								.executable = false,
+								.writeable  = false
+							});
+
+						if (result.ok())
+							break;
+
+						using Error = Genode::Region_map::Attach_error;
+						if      (result == Error::OUT_OF_RAM)  _rm.upgrade_ram(8*1024);
+						else if (result == Error::OUT_OF_CAPS) _rm.upgrade_caps(2);
+						else return false;
+					}
+
+					extent.export_ref();
+					_extents[_num_extents++] = &extent;
+					return true;
+				}
+		};
+
+		Genode::List<Export> _exports { };
+
 		Vfs_ram::Node *lookup(char const *path, bool return_parent = false)
 		{
 			using namespace Vfs_ram;
@@ -574,7 +1163,15 @@ class Vfs::Ram_file_system : public Vfs::File_system
 
 		Ram_file_system(Vfs::Env &env, Genode::Xml_node) : _env(env) { }
 
-		~Ram_file_system() { _root.empty(_env.alloc()); }
+		~Ram_file_system()
+		{
+			_root.empty(_env.alloc());
+
+			while (Export *e = _exports.first()) {
+				_exports.remove(e);
+				destroy(_env.alloc(), e);
+			}
+		}
 
 
 		/*********************************
@@ -626,7 +1223,7 @@ class Vfs::Ram_file_system : public Vfs::File_system
 				if (strlen(name) >= MAX_NAME_LEN)
 					return OPEN_ERR_NAME_TOO_LONG;
 
-				try { file = new (_env.alloc()) File(name, _env.alloc()); }
+				try { file = new (_env.alloc()) File(name, _env); }
 				catch (Out_of_memory) { return OPEN_ERR_NO_SPACE; }
 				parent->adopt(file);
 				parent->notify();
@@ -894,6 +1491,14 @@ class Vfs::Ram_file_system : public Vfs::File_system
 			return UNLINK_OK;
 		}
 
+		/**
+		 * Return read-only dataspace with the content of the file at 'path'
+		 *
+		 * The dataspace is a managed dataspace composed of the extents of
+		 * the file rather than a copy. Modifications of the file after the
+		 * export are applied to copies of the affected pages, which leaves
+		 * the content of the dataspace intact for its users.
+		 */
 		Dataspace_capability dataspace(char const * const path) override
 		{
 			using namespace Vfs_ram;
@@ -906,33 +1511,48 @@ class Vfs::Ram_file_system : public Vfs::File_system
 			if (!file)
 				return { };
 
-			size_t const len = file->length();
-
-			return _env.env().ram().try_alloc(len).convert<Dataspace_capability>(
-				[&] (Ram_dataspace_capability ds_cap) {
-					return _env.env().rm().attach(ds_cap, {
-						.size = { },  .offset     = { },  .use_at    = { },
-						.at   = { },  .executable = { },  .writeable = true
-					}).convert<Dataspace_capability>(
-						[&] (Region_map::Range const range) {
-							file->read(Byte_range_ptr((char *)range.start, len), Seek{0});
-							_env.env().rm().detach(range.start);
-							return ds_cap;
-						},
-						[&] (Region_map::Attach_error) {
-							_env.env().ram().free(ds_cap);
-							return Dataspace_capability();
-						}
-					);
-				},
-				[&] (Ram_allocator::Alloc_error) { return Dataspace_capability(); }
-			);
+			Export *export_ptr = nullptr;
+			try {
+				if (!_rm.constructed())
+					_rm.construct(_env.env());
+
+				file->prepare_export();
+
+				export_ptr = new (_env.alloc())
+					Export(*_rm, _env.alloc(), file->export_size(), file->num_runs());
+
+				bool attached = true;
+				file->for_each_exported_run([&] (Extent &extent, size_t extent_offset,
+				                                 size_t offset, size_t size) {
+					attached = attached
+					        && export_ptr->attach(extent, extent_offset, offset, size); });
+
+				if (attached) {
+					_exports.insert(export_ptr);
+					return export_ptr->ds;
+				}
+			}
+			catch (Out_of_memory)                  { }
+			catch (Genode::Out_of_caps)            { }
+			catch (Genode::Service_denied)         { }
+			catch (Genode::Insufficient_ram_quota) { }
+			catch (Genode::Insufficient_cap_quota) { }
+
+			if (export_ptr)
+				destroy(_env.alloc(), export_ptr);
+
+			return { };
 		}
 
 		void release(char const *, Dataspace_capability ds_cap) override
 		{
-			_env.env().ram().free(
-				static_cap_cast<Genode::Ram_dataspace>(ds_cap));
+			for (Export *e = _exports.first(); e; e = e->next()) {
+				if (e->ds == ds_cap) {
+					_exports.remove(e);
+					destroy(_env.alloc(), e);
+					return;
+				}
+			}
 		}
 
 		Watch_result watch(char const * const path, Vfs_watch_handle **handle,
@@ -1014,6 +1634,7 @@ class Vfs::Ram_file_system : public Vfs::File_system
 
 			try { handle.node.truncate(at); }
 			catch (Vfs_ram::Out_of_memory) { return FTRUNCATE_ERR_NO_SPACE; }
+			catch (Genode::Out_of_caps)    { return FTRUNCATE_ERR_NO_SPACE; }
 			return FTRUNCATE_OK;
 		}
 
@@ -18,6 +18,7 @@
 #include <vfs/file_system.h>
 #include <vfs/vfs_handle.h>
 #include <base/attached_rom_dataspace.h>
+#include <os/compressed_archive.h>
 
 namespace Vfs { class Tar_file_system; }
 
@@ -195,6 +196,14 @@ class Vfs::Tar_file_system : public File_system
 	{
 		using Tar_vfs_handle::Tar_vfs_handle;
 
+		/*
+		 * Child returned by the previous read, which lets a sequential
+		 * traversal of the directory proceed without rescanning the list
+		 * of children
+		 */
+		Node const *_cursor_node  = nullptr;
+		unsigned    _cursor_index = 0;
+
 		Read_result read(Byte_range_ptr const &dst, size_t &out_count) override
 		{
 			if (dst.num_bytes < sizeof(Dirent))
@@ -204,7 +213,12 @@ class Vfs::Tar_file_system : public File_system
 
 			unsigned const index = (unsigned)(seek() / sizeof(Dirent));
 
-			Node const *node_ptr = _node->lookup_child(index);
+			Node const *node_ptr = (_cursor_node && index == _cursor_index + 1)
+			                     ? _cursor_node->next()
+			                     : _node->lookup_child(index);
+
+			_cursor_node  = node_ptr;
+			_cursor_index = index;
 
 			if (!node_ptr) {
 				dirent = Dirent { };
@@ -289,67 +303,137 @@ class Vfs::Tar_file_system : public File_system
 
 	struct Node : List<Node>, List<Node>::Element
 	{
-		char const *name;
+		char const   *name;
 		Record const *record;
 
+		Node const *parent       = nullptr;
+		unsigned    hash         = 0;        /* hash of parent and name */
+		Node       *index_next   = nullptr;  /* next node of index bucket */
+		unsigned    num_children = 0;
+
 		Node(char const *name, Record const *record) : name(name), record(record) { }
 
-		Node *lookup(char const *name)
+		Node(Node const &parent, unsigned hash, char const *name, Record const *record)
+		: name(name), record(record), parent(&parent), hash(hash) { }
+
+		Node const *lookup_child(unsigned index) const
 		{
-			Absolute_path lookup_path(name);
+			for (Node const *child_node = first(); child_node; child_node = child_node->next(), index--) {
+				if (index == 0)
+					return child_node;
+			}
 
-			Node *parent_node = this;
-			Node *child_node;
+			return 0;
+		}
 
-			Path_element_token t(lookup_path.base());
+		file_size num_dirent() const { return num_children; }
 
-			while (t) {
+		private:
 
-				if (t.type() != Path_element_token::IDENT) {
-						t = t.next();
-						continue;
-				}
+			/*
+			 * Noncopyable
+			 */
+			Node(Node const &);
+			Node &operator = (Node const &);
 
-				char path_element[MAX_PATH_LEN];
+	} _root_node;
+
+
+	/*
+	 * Hash index of all nodes of the archive, keyed by parent node and name
+	 *
+	 * The index is populated once while scanning the archive and replaces
+	 * the linear search of the children of each directory on lookup.
+	 */
+	class Node_index
+	{
+		private:
+
+			Genode::Allocator &_alloc;
+
+			Node   **_buckets     = nullptr;
+			unsigned _num_buckets = 0;   /* power of two */
+			unsigned _num_nodes   = 0;
 
-				t.string(path_element, sizeof(path_element));
+			/*
+			 * Noncopyable
+			 */
+			Node_index(Node_index const &);
+			Node_index &operator = (Node_index const &);
+
+			Node *&_bucket(unsigned hash) const {
+				return _buckets[hash & (_num_buckets - 1)]; }
+
+			void _grow()
+			{
+				unsigned const old_num_buckets = _num_buckets;
+				Node   **const old_buckets     = _buckets;
+
+				_num_buckets = old_num_buckets ? 2*old_num_buckets : 256;
+				_buckets     = (Node **)_alloc.alloc(_num_buckets*sizeof(Node *));
 
-				for (child_node = parent_node->first(); child_node; child_node = child_node->next()) {
-					if (strcmp(child_node->name, path_element) == 0) {
-						parent_node = child_node;
-						break;
+				for (unsigned i = 0; i < _num_buckets; i++)
+					_buckets[i] = nullptr;
+
+				for (unsigned i = 0; i < old_num_buckets; i++) {
+					for (Node *node = old_buckets[i], *next; node; node = next) {
+						next = node->index_next;
+						node->index_next = _bucket(node->hash);
+						_bucket(node->hash) = node;
 					}
 				}
 
-				if (!child_node)
-					return 0;
+				if (old_buckets)
+					_alloc.free(old_buckets, old_num_buckets*sizeof(Node *));
+			}
+
+		public:
 
-				t = t.next();
+			/**
+			 * Return hash of path element 'name' of 'len' bytes below 'parent'
+			 */
+			static unsigned hash(Node const &parent, char const *name, size_t len)
+			{
+				/* FNV-1a seeded with the hash of the parent */
+				unsigned h = 2166136261u ^ parent.hash;
+				for (size_t i = 0; i < len; i++)
+					h = (h ^ (unsigned char)name[i]) * 16777619u;
+				return h;
 			}
 
-			return parent_node;
-		}
+			Node_index(Genode::Allocator &alloc) : _alloc(alloc) { }
 
+			~Node_index()
+			{
+				if (_buckets)
+					_alloc.free(_buckets, _num_buckets*sizeof(Node *));
+			}
 
-		Node const *lookup_child(int index) const
-		{
-			for (Node const *child_node = first(); child_node; child_node = child_node->next(), index--) {
-				if (index == 0)
-					return child_node;
+			void insert(Node &node)
+			{
+				if (_num_nodes >= _num_buckets)
+					_grow();
+
+				node.index_next = _bucket(node.hash);
+				_bucket(node.hash) = &node;
+				_num_nodes++;
 			}
 
-			return 0;
-		}
+			Node *lookup(Node const &parent, char const *name, size_t len) const
+			{
+				if (!_num_buckets)
+					return nullptr;
 
+				unsigned const h = hash(parent, name, len);
 
-		file_size num_dirent()
-		{
-			file_size count = 0;
-			for (Node *child_node = first(); child_node; child_node = child_node->next(), count++) ;
-			return count;
-		}
+				for (Node *node = _bucket(h); node; node = node->index_next)
+					if (node->hash == h && node->parent == &parent
+					 && strcmp(node->name, name, len) == 0 && node->name[len] == 0)
+						return node;
 
-	} _root_node;
+				return nullptr;
+			}
+	} _node_index { _alloc };
 
 
 	/*
@@ -361,13 +445,15 @@ class Vfs::Tar_file_system : public File_system
 
 			Genode::Allocator &_alloc;
 
-			Node &_root_node;
+			Node       &_root_node;
+			Node_index &_node_index;
 
 		public:
 
 			Add_node_action(Genode::Allocator &alloc,
-			                Node              &root_node)
-			: _alloc(alloc), _root_node(root_node) { }
+			                Node              &root_node,
+			                Node_index        &node_index)
+			: _alloc(alloc), _root_node(root_node), _node_index(node_index) { }
 
 			void operator()(Record const *record)
 			{
@@ -402,10 +488,9 @@ class Vfs::Tar_file_system : public File_system
 
 					t.string(path_element, sizeof(path_element));
 
-					for (child_node = parent_node->first(); child_node; child_node = child_node->next()) {
-						if (strcmp(child_node->name, path_element) == 0)
-							break;
-					}
+					size_t const len = strlen(path_element);
+
+					child_node = _node_index.lookup(*parent_node, path_element, len);
 
 					if (child_node) {
 
@@ -416,26 +501,28 @@ class Vfs::Tar_file_system : public File_system
 							child_node->record = record;
 						}
 					} else {
-						if (remaining_path.has_single_element()) {
 
-							/*
-							 * TODO: find 'path_element' in 'record->name'
-							 * and use the location in the record as name
-							 * pointer to save some memory
-							 */
-							Genode::size_t name_size = strlen(path_element) + 1;
-							char *name = (char*)_alloc.alloc(name_size);
-							copy_cstring(name, path_element, name_size);
-							child_node = new (_alloc) Node(name, record);
-						} else {
-
-							/* create a directory node without record */
-							Genode::size_t name_size = strlen(path_element) + 1;
-							char *name = (char*)_alloc.alloc(name_size);
-							copy_cstring(name, path_element, name_size);
-							child_node = new (_alloc) Node(name, 0);
-						}
+						/*
+						 * TODO: find 'path_element' in 'record->name'
+						 * and use the location in the record as name
+						 * pointer to save some memory
+						 */
+						Genode::size_t name_size = len + 1;
+						char *name = (char*)_alloc.alloc(name_size);
+						copy_cstring(name, path_element, name_size);
+
+						unsigned const hash = Node_index::hash(*parent_node, name, len);
+
+						/* a node without record is a directory */
+						Record const *node_record =
+							remaining_path.has_single_element() ? record : 0;
+
+						child_node = new (_alloc)
+							Node(*parent_node, hash, name, node_record);
+
 						parent_node->insert(child_node);
+						parent_node->num_children++;
+						_node_index.insert(*child_node);
 					}
 
 					parent_node = child_node;
@@ -478,37 +565,101 @@ class Vfs::Tar_file_system : public File_system
 	}
 
 
-	struct Num_dirent_cache
+	/*
+	 * Bounded cache of recently resolved paths
+	 *
+	 * Lookups tend to come in bursts for the same paths, e.g., when the
+	 * dynamic linker probes its search path. Failed lookups are cached as
+	 * well because the content of the archive never changes.
+	 */
+	class Path_cache
 	{
-		Node     &root_node;
-		bool      valid;              /* true after first lookup */
-		char      key[256];           /* key used for lookup */
-		file_size cached_num_dirent;  /* cached value */
+		private:
 
-		Num_dirent_cache(Node &root_node)
-		: root_node(root_node), valid(false), cached_num_dirent(0) { }
+			enum { NUM_ENTRIES = 64 };
 
-		file_size num_dirent(char const *path)
-		{
-			/* check for cache miss */
-			if (!valid || strcmp(path, key) != 0) {
-				Node *node = root_node.lookup(path);
-				if (!node)
-					return 0;
-				copy_cstring(key, path, sizeof(key));
-				cached_num_dirent = node->num_dirent();
-				valid = true;
+			using Path_string = Genode::String<MAX_PATH_LEN>;
+
+			struct Entry
+			{
+				Path_string      path { };
+				unsigned         hash = 0;
+				Node            *node = nullptr;
+				Genode::uint64_t used = 0;  /* zero if entry is unused */
+
+				Entry() { }
+
+				Entry(char const *path, unsigned hash, Node *node, Genode::uint64_t used)
+				: path(path), hash(hash), node(node), used(used) { }
+
+				Entry(Entry const &) = default;
+				Entry &operator = (Entry const &) = default;
+			};
+
+			Entry            _entries[NUM_ENTRIES] { };
+			Genode::uint64_t _now = 0;
+
+			static unsigned _hash(char const *path)
+			{
+				unsigned h = 2166136261u;
+				for (; *path; path++)
+					h = (h ^ (unsigned char)*path) * 16777619u;
+				return h;
 			}
-			return cached_num_dirent;
-		}
-	} _cached_num_dirent;
+
+		public:
+
+			/**
+			 * Return node of 'path', resolved via 'resolve_fn' on cache miss
+			 */
+			Node *lookup(char const *path, auto const &resolve_fn)
+			{
+				unsigned const hash = _hash(path);
+
+				Entry *victim = &_entries[0];
+
+				for (Entry &entry : _entries) {
+					if (entry.used && entry.hash == hash && entry.path == path) {
+						entry.used = ++_now;
+						return entry.node;
+					}
+					if (entry.used < victim->used)
+						victim = &entry;
+				}
+
+				Node * const node = resolve_fn(path);
+
+				*victim = Entry(path, hash, node, ++_now);
+
+				return node;
+			}
+	} _path_cache { };
+
+	Node *_lookup_uncached(char const *path)
+	{
+		Absolute_path lookup_path(path);
+
+		Node *node = &_root_node;
+
+		for (Path_element_token t(lookup_path.base()); t && node; t = t.next())
+			if (t.type() == Path_element_token::IDENT)
+				node = _node_index.lookup(*node, t.start(), t.len());
+
+		return node;
+	}
+
+	Node *_lookup(char const *path)
+	{
+		return _path_cache.lookup(path, [&] (char const *p) {
+			return _lookup_uncached(p); });
+	}
 
 	/**
 	 * Walk hardlinks until we reach a file
 	 */
 	Node const *dereference(char const *path)
 	{
-		Node const *node = _root_node.lookup(path);
+		Node const *node = _lookup(path);
 		Node const *slow_node = node;
 		int i = 0;
 		while (node) {
@@ -522,9 +673,9 @@ class Vfs::Tar_file_system : public File_system
 			 * loop then eventually we catch it as the faster
 			 * laps the slower.
 			 */
-			node = _root_node.lookup(record->linked_name());
+			node = _lookup(record->linked_name());
 			if (i++ & 1) {
-				slow_node = _root_node.lookup(slow_node->record->linked_name());
+				slow_node = _lookup(slow_node->record->linked_name());
 				if (node == slow_node) {
 					Genode::error(_rom_name, " contains a hard-link loop at '", path, "'");
 					node = nullptr;
@@ -540,10 +691,15 @@ class Vfs::Tar_file_system : public File_system
 		:
 			_env(env.env()), _alloc(env.alloc()),
 			_rom_name(config.attribute_value("name", Rom_name())),
-			_root_node("", 0),
-			_cached_num_dirent(_root_node)
+			_root_node("", 0)
 		{
-			_for_each_tar_record_do(Add_node_action(_alloc, _root_node));
+			Genode::Compressed_archive const archive { _tar_base, _tar_size };
+			if (archive.compressed()) {
+				Genode::error(_rom_name, " ", archive);
+				return;
+			}
+
+			_for_each_tar_record_do(Add_node_action(_alloc, _root_node, _node_index));
 		}
 
 		/*********************************
@@ -651,14 +807,15 @@ class Vfs::Tar_file_system : public File_system
 
 		Rename_result rename(char const *from, char const *to) override
 		{
-			if (_root_node.lookup(from) || _root_node.lookup(to))
+			if (_lookup(from) || _lookup(to))
 				return RENAME_ERR_NO_PERM;
 			return RENAME_ERR_NO_ENTRY;
 		}
 
 		file_size num_dirent(char const *path) override
 		{
-			return _cached_num_dirent.num_dirent(path);
+			Node const *node = _lookup(path);
+			return node ? node->num_dirent() : 0;
 		}
 
 		bool directory(char const *path) override
@@ -680,7 +837,7 @@ class Vfs::Tar_file_system : public File_system
 			 * case, return the whole path, which is relative to the root
 			 * of this file system.
 			 */
-			Node *node = _root_node.lookup(path);
+			Node const *node = _lookup(path);
 			return node ? path : 0;
 		}
 
@@ -0,0 +1,309 @@
+/*
+ * \brief  Page cache of the block cache
+ * \author agent
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _BLOCK_CACHE__CACHE_H_
+#define _BLOCK_CACHE__CACHE_H_
+
+/* Genode includes */
+#include <base/attached_ram_dataspace.h>
+#include <util/misc_math.h>
+
+namespace Block_cache {
+
+	using namespace Genode;
+
+	struct Page;
+	class  Page_cache;
+}
+
+
+struct Block_cache::Page
+{
+	uint64_t number;   /* page number, i.e., byte offset / page size */
+
+	bool dirty;        /* content differs from the device */
+	bool writing;      /* write-back in flight */
+
+	Page *lru_prev,   *lru_next;    /* LRU order, or free list */
+	Page *dirty_prev, *dirty_next;  /* dirty pages not under write-back */
+	Page *hash_next;
+
+	bool evictable() const { return !dirty && !writing; }
+};
+
+
+/**
+ * Fixed-size set of cached pages
+ *
+ * Pages are looked up by their page number via a hash table. Clean pages
+ * are replaced in least-recently-used order. Dirty pages cannot be replaced
+ * and are queued for write-back in the order in which they became dirty.
+ */
+class Block_cache::Page_cache : Noncopyable
+{
+	private:
+
+		/* number of LRU pages inspected when looking for a page to replace */
+		enum { MAX_EVICTION_SCAN = 64 };
+
+		size_t   const _page_size;
+		unsigned const _num_pages;
+		unsigned const _num_buckets;
+
+		Attached_ram_dataspace _data;
+		Attached_ram_dataspace _meta;
+
+		Page  * const _pages;
+		Page ** const _buckets;
+
+		Page *_free      = nullptr;
+		Page *_lru_first = nullptr;  /* least recently used */
+		Page *_lru_last  = nullptr;
+
+		Page *_dirty_first = nullptr;
+		Page *_dirty_last  = nullptr;
+
+		unsigned _num_used    = 0;
+		unsigned _num_dirty   = 0;
+		unsigned _num_writing = 0;
+
+		/*
+		 * Noncopyable
+		 */
+		Page_cache(Page_cache const &);
+		Page_cache &operator = (Page_cache const &);
+
+		static unsigned _buckets_for(unsigned num_pages)
+		{
+			unsigned result = 1;
+			while (result < num_pages)
+				result <<= 1;
+			return result;
+		}
+
+		Page *&_bucket(uint64_t number) {
+			return _buckets[(number ^ (number >> 17)) & (_num_buckets - 1)]; }
+
+		void _lru_remove(Page &page)
+		{
+			if (page.lru_prev) page.lru_prev->lru_next = page.lru_next;
+			else               _lru_first = page.lru_next;
+
+			if (page.lru_next) page.lru_next->lru_prev = page.lru_prev;
+			else               _lru_last = page.lru_prev;
+
+			page.lru_prev = page.lru_next = nullptr;
+		}
+
+		void _lru_append(Page &page)
+		{
+			page.lru_prev = _lru_last;
+			page.lru_next = nullptr;
+
+			if (_lru_last) _lru_last->lru_next = &page;
+			else           _lru_first = &page;
+
+			_lru_last = &page;
+		}
+
+		void _dirty_remove(Page &page)
+		{
+			if (page.dirty_prev) page.dirty_prev->dirty_next = page.dirty_next;
+			else                 _dirty_first = page.dirty_next;
+
+			if (page.dirty_next) page.dirty_next->dirty_prev = page.dirty_prev;
+			else                 _dirty_last = page.dirty_prev;
+
+			page.dirty_prev = page.dirty_next = nullptr;
+		}
+
+		void _dirty_append(Page &page)
+		{
+			page.dirty_prev = _dirty_last;
+			page.dirty_next = nullptr;
+
+			if (_dirty_last) _dirty_last->dirty_next = &page;
+			else             _dirty_first = &page;
+
+			_dirty_last = &page;
+		}
+
+		void _hash_remove(Page &page)
+		{
+			for (Page **p = &_bucket(page.number); *p; p = &(*p)->hash_next)
+				if (*p == &page) {
+					*p = page.hash_next;
+					break;
+				}
+			page.hash_next = nullptr;
+		}
+
+		Page *_evict()
+		{
+			unsigned scanned = 0;
+			for (Page *page = _lru_first; page && scanned < MAX_EVICTION_SCAN;
+			     page = page->lru_next, scanned++) {
+
+				if (!page->evictable())
+					continue;
+
+				_lru_remove(*page);
+				_hash_remove(*page);
+				_num_used--;
+				return page;
+			}
+			return nullptr;
+		}
+
+	public:
+
+		/**
+		 * Return metadata size needed per page
+		 */
+		static constexpr size_t meta_size_per_page() {
+			return sizeof(Page) + 2*sizeof(Page *); }
+
+		Page_cache(Ram_allocator &ram, Region_map &rm,
+		           size_t page_size, unsigned num_pages)
+		:
+			_page_size(page_size), _num_pages(max(num_pages, 1U)),
+			_num_buckets(_buckets_for(_num_pages)),
+			_data(ram, rm, _num_pages*_page_size),
+			_meta(ram, rm, _num_pages*sizeof(Page) + _num_buckets*sizeof(Page *)),
+			_pages(_meta.local_addr<Page>()),
+			_buckets((Page **)(_pages + _num_pages))
+		{
+			/* the dataspace is zero-initialized, so only the free list is built */
+			for (unsigned i = _num_pages; i > 0; i--) {
+				_pages[i - 1].lru_next = _free;
+				_free = &_pages[i - 1];
+			}
+		}
+
+		size_t   page_size()   const { return _page_size; }
+		unsigned num_pages()   const { return _num_pages; }
+		unsigned num_used()    const { return _num_used; }
+		unsigned num_dirty()   const { return _num_dirty; }
+		unsigned num_writing() const { return _num_writing; }
+
+		char *data(Page const &page) const {
+			return _data.local_addr<char>() + (size_t)(&page - _pages)*_page_size; }
+
+		Page *lookup(uint64_t number)
+		{
+			for (Page *page = _bucket(number); page; page = page->hash_next)
+				if (page->number == number)
+					return page;
+			return nullptr;
+		}
+
+		/**
+		 * Allocate clean page for 'number', replacing the LRU page if needed
+		 *
+		 * \return  nullptr if all inspected pages are dirty or under
+		 *          write-back
+		 */
+		Page *insert(uint64_t number)
+		{
+			Page *page = _free;
+			if (page)
+				_free = page->lru_next;
+			else
+				page = _evict();
+
+			if (!page)
+				return nullptr;
+
+			*page = Page { .number     = number,
+			               .dirty      = false,
+			               .writing    = false,
+			               .lru_prev   = nullptr, .lru_next   = nullptr,
+			               .dirty_prev = nullptr, .dirty_next = nullptr,
+			               .hash_next  = _bucket(number) };
+
+			_bucket(number) = page;
+			_lru_append(*page);
+			_num_used++;
+			return page;
+		}
+
+		/**
+		 * Mark page as most recently used
+		 */
+		void touch(Page &page)
+		{
+			_lru_remove(page);
+			_lru_append(page);
+		}
+
+		void mark_dirty(Page &page)
+		{
+			if (page.dirty)
+				return;
+
+			page.dirty = true;
+			_num_dirty++;
+
+			/* pages under write-back are queued once the write-back completed */
+			if (!page.writing)
+				_dirty_append(page);
+		}
+
+		/**
+		 * Return the page that is dirty for the longest time and not under
+		 * write-back
+		 */
+		Page *oldest_dirty() { return _dirty_first; }
+
+		bool write_back_candidate(Page const &page) const {
+			return page.dirty && !page.writing; }
+
+		void write_back_started(Page &page)
+		{
+			_dirty_remove(page);
+			page.dirty   = false;
+			page.writing = true;
+			_num_dirty--;
+			_num_writing++;
+		}
+
+		void write_back_completed(Page &page)
+		{
+			page.writing = false;
+			_num_writing--;
+
+			/* page was modified during the write-back */
+			if (page.dirty)
+				_dirty_append(page);
+		}
+
+		/**
+		 * Requeue page whose write-back failed
+		 *
+		 * The page keeps its content and stays dirty until a later
+		 * write-back succeeds.
+		 */
+		void write_back_failed(Page &page)
+		{
+			page.writing = false;
+			_num_writing--;
+
+			if (!page.dirty) {
+				page.dirty = true;
+				_num_dirty++;
+			}
+			_dirty_append(page);
+		}
+};
+
+#endif /* _BLOCK_CACHE__CACHE_H_ */
@@ -0,0 +1,930 @@
+/*
+ * \brief  Block cache
+ * \author agent
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/attached_rom_dataspace.h>
+#include <base/component.h>
+#include <base/heap.h>
+#include <base/registry.h>
+#include <block/request_stream.h>
+#include <block_session/connection.h>
+#include <root/root.h>
+#include <timer_session/connection.h>
+
+/* local includes */
+#include "cache.h"
+
+namespace Block_cache {
+
+	struct Request_slot;
+	struct Job;
+	class  Session_component;
+	struct Main;
+
+	using Block_connection = Block::Connection<Job>;
+	using Response         = Block::Request_stream::Response;
+}
+
+
+/*
+ * Client request that is accepted but not yet acknowledged
+ */
+struct Block_cache::Request_slot
+{
+	enum class State { FREE, PENDING, COMPLETE };
+
+	State          state = State::FREE;
+	Block::Request request { };
+	char          *payload = nullptr;
+
+	unsigned pending_jobs = 0;  /* device jobs that serve the request */
+
+	void complete(bool success)
+	{
+		request.success = success;
+		state = State::COMPLETE;
+	}
+
+	void job_completed(bool success)
+	{
+		request.success &= success;
+		if (--pending_jobs == 0)
+			state = State::COMPLETE;
+	}
+};
+
+
+struct Block_cache::Job : Block_connection::Job
+{
+	enum class Type { FILL, READ_AHEAD, WRITE_BACK, WRITE_THROUGH, SYNC };
+
+	Registry<Job>::Element _element;
+
+	Type           const type;
+	Request_slot * const slot;      /* client request served by the job */
+
+	/* read data may populate the cache, see '_invalidate_fills' */
+	bool may_fill;
+
+	Job(Block_connection &block, Block::Operation operation,
+	    Registry<Job> &registry, Type type, Request_slot *slot, bool may_fill)
+	:
+		Block_connection::Job(block, operation),
+		_element(registry, *this),
+		type(type), slot(slot), may_fill(may_fill)
+	{ }
+
+	bool fills() const { return type == Type::FILL || type == Type::READ_AHEAD; }
+
+	/*
+	 * Noncopyable
+	 */
+	Job(Job const &) = delete;
+	Job &operator = (Job const &) = delete;
+};
+
+
+class Block_cache::Session_component : public Rpc_object<Block::Session>,
+                                       public Block::Request_stream
+{
+	private:
+
+		Entrypoint &_ep;
+
+		Ram_quota _ram_quota;  /* donated by the client, including upgrades */
+
+	public:
+
+		Session_component(Region_map &rm, Entrypoint &ep,
+		                  Dataspace_capability ds,
+		                  Signal_context_capability sigh,
+		                  Block::Session::Info info, Ram_quota ram_quota)
+		:
+			Request_stream(rm, ds, ep, sigh, info), _ep(ep),
+			_ram_quota(ram_quota)
+		{
+			_ep.manage(*this);
+		}
+
+		~Session_component() { _ep.dissolve(*this); }
+
+		void upgrade(Ram_quota ram_quota) { _ram_quota.value += ram_quota.value; }
+
+		Ram_quota ram_quota() const { return _ram_quota; }
+
+		Info info() const override { return Request_stream::info(); }
+
+		Capability<Tx> tx_cap() override { return Request_stream::tx_cap(); }
+};
+
+
+struct Block_cache::Main : Rpc_object<Typed_root<Block::Session>>
+{
+	enum {
+		MAX_REQUESTS = 128,
+		MAX_JOBS     = 64,
+
+		/* RAM kept for the client's I/O buffer and the heap by default */
+		RESERVED_RAM = 8*1024*1024,
+	};
+
+	Env &_env;
+
+	Attached_rom_dataspace _config { _env, "config" };
+
+	Heap _heap { _env.ram(), _env.rm() };
+
+	Io_signal_handler<Main> _io_handler { _env.ep(), *this, &Main::_handle_io };
+
+	Number_of_bytes const _io_buffer_size =
+		_config.xml().attribute_value("io_buffer", Number_of_bytes(4*1024*1024));
+
+	Allocator_avl    _block_alloc { &_heap };
+	Block_connection _block { _env, &_block_alloc, _io_buffer_size };
+
+	Block::Session::Info const _info { _block.info() };
+
+	size_t const _block_size = _info.block_size;
+
+	size_t const _page_size = _init_page_size();
+
+	size_t _init_page_size()
+	{
+		size_t const size = _config.xml().attribute_value("page_size",
+		                                                  Number_of_bytes(4096));
+
+		if (size < _block_size || size % _block_size) {
+			warning("page size ", size, " is no multiple of block size, "
+			        "using ", _block_size);
+			return _block_size;
+		}
+		return size;
+	}
+
+	/* maximum number of pages transferred by one job */
+	unsigned const _max_job_pages = (unsigned)max(1UL,
+		min(256UL, _block.tx()->bulk_buffer_size() / 4 / _page_size));
+
+	Page_cache _cache { _env.ram(), _env.rm(), _page_size, _init_num_pages() };
+
+	unsigned _init_num_pages()
+	{
+		size_t const avail = _env.pd().avail_ram().value;
+
+		size_t const size =
+			_config.xml().attribute_value("cache_size",
+			                              Number_of_bytes(avail > RESERVED_RAM
+			                                              ? avail - RESERVED_RAM : 0));
+
+		return (unsigned)(size / (_page_size + Page_cache::meta_size_per_page()));
+	}
+
+	uint64_t const _read_ahead_pages =
+		_config.xml().attribute_value("read_ahead", Number_of_bytes(128*1024))
+		/ _page_size;
+
+	/* write back in the background if more pages than this are dirty */
+	unsigned const _max_dirty = _cache.num_pages() / 2;
+
+	bool const _writeable = _config.xml().attribute_value("writeable", false)
+	                     && _info.writeable;
+
+	bool const _verbose = _config.xml().attribute_value("verbose", false);
+
+	Timer::Connection _timer { _env };
+
+	Microseconds const _sync_interval { 1000 *
+		_config.xml().attribute_value("sync_interval_ms", (uint64_t)1000) };
+
+	Timer::One_shot_timeout<Main> _sync_timeout {
+		_timer, *this, &Main::_handle_sync_timeout };
+
+	Registry<Job> _jobs { };
+	unsigned      _num_jobs = 0;
+
+	Request_slot _slots[MAX_REQUESTS] { };
+
+	unsigned _wt_in_flight = 0;
+
+	bool _flush_all   = false;
+	bool _write_error = false;  /* failed write since the last sync */
+
+	/* write-back is retried with the next sync timeout only */
+	bool _write_back_stalled = false;
+
+	Request_slot *_sync_slot = nullptr;
+	bool          _sync_issued = false;
+
+	/* sequential-access detection */
+	Block::block_number_t _last_read_end  = 0;
+	uint64_t              _read_ahead_end = 0;  /* page number */
+
+	struct Stats
+	{
+		uint64_t hits, misses, read_ahead, write_backs, write_throughs;
+	} _stats { };
+
+	Constructible<Attached_ram_dataspace> _session_ds { };
+	Constructible<Session_component>      _session    { };
+
+	/*
+	 * Noncopyable
+	 */
+	Main(Main const &);
+	Main &operator = (Main const &);
+
+
+	/******************
+	 ** Page helpers **
+	 ******************/
+
+	/**
+	 * Call 'fn' for each page touched by a range of blocks
+	 *
+	 * The arguments of 'fn' are the page number, the byte offset within
+	 * the page, the number of bytes, and the byte offset within the range.
+	 */
+	void _for_each_page(Block::block_number_t first, Block::block_count_t count,
+	                    auto const &fn) const
+	{
+		uint64_t const start = first*_block_size;
+		uint64_t const end   = (first + count)*_block_size;
+
+		for (uint64_t pos = start; pos < end; ) {
+			uint64_t const page   = pos / _page_size;
+			size_t   const offset = (size_t)(pos % _page_size);
+			size_t   const length = (size_t)min((uint64_t)(_page_size - offset), end - pos);
+
+			fn(page, offset, length, (size_t)(pos - start));
+			pos += length;
+		}
+	}
+
+	/**
+	 * Return device operation for a range of pages
+	 */
+	Block::Operation _page_operation(Block::Operation::Type type,
+	                                 uint64_t first, uint64_t count) const
+	{
+		uint64_t const blocks_per_page = _page_size / _block_size;
+
+		Block::block_number_t const block = first*blocks_per_page;
+
+		return { .type         = type,
+		         .block_number = block,
+		         .count        = min(count*blocks_per_page,
+		                             _info.block_count - block) };
+	}
+
+	bool _jobs_available(unsigned count = 1) const {
+		return _num_jobs + count <= MAX_JOBS; }
+
+	/*
+	 * Read data may populate the cache only if no write-through job was
+	 * in flight when the read was issued and no write to the read range
+	 * was accepted since. Otherwise, the read might return data that is
+	 * outdated by the write.
+	 */
+	Job &_new_job(Block::Operation operation, Job::Type type, Request_slot *slot)
+	{
+		_num_jobs++;
+		return *new (_heap) Job(_block, operation, _jobs, type, slot,
+		                        _wt_in_flight == 0);
+	}
+
+	void _invalidate_fills(Block::Operation const &op)
+	{
+		_jobs.for_each([&] (Job &job) {
+			Block::Operation const &read = job.operation();
+
+			if (job.fills() && !job.completed()
+			 && read.block_number < op.block_number + op.count
+			 && op.block_number < read.block_number + read.count)
+				job.may_fill = false;
+		});
+	}
+
+	void _schedule_sync()
+	{
+		if (_sync_interval.value && !_sync_timeout.scheduled())
+			_sync_timeout.schedule(_sync_interval);
+	}
+
+	void _handle_sync_timeout(Duration)
+	{
+		_flush_all = true;
+		_handle_io();
+	}
+
+
+	/****************
+	 ** Write-back **
+	 ****************/
+
+	/**
+	 * Issue write-back of the run of dirty pages around 'page'
+	 */
+	bool _write_back(Page &page)
+	{
+		if (!_jobs_available())
+			return false;
+
+		auto candidate = [&] (uint64_t number) {
+			Page *p = _cache.lookup(number);
+			return p && _cache.write_back_candidate(*p); };
+
+		uint64_t first = page.number;
+		while (first > 0 && page.number - first + 1 < _max_job_pages
+		    && candidate(first - 1))
+			first--;
+
+		uint64_t count = 0;
+		while (count < _max_job_pages && candidate(first + count)) {
+			_cache.write_back_started(*_cache.lookup(first + count));
+			count++;
+		}
+
+		_new_job(_page_operation(Block::Operation::Type::WRITE, first, count),
+		         Job::Type::WRITE_BACK, nullptr);
+
+		_stats.write_backs += count;
+		return true;
+	}
+
+	/**
+	 * Issue write-back jobs according to the flush state and dirty limit
+	 *
+	 * \return true if a job was issued
+	 */
+	bool _update_write_back()
+	{
+		bool progress = false;
+
+		if (_write_back_stalled && !_flush_all)
+			return false;
+
+		bool const flush_all = _flush_all || _sync_slot;
+
+		while (Page *page = _cache.oldest_dirty()) {
+
+			if (!flush_all && _cache.num_dirty() <= _max_dirty)
+				break;
+
+			if (!_write_back(*page))
+				return progress;
+
+			progress = true;
+		}
+
+		_flush_all = false;
+		return progress;
+	}
+
+	bool _update_sync()
+	{
+		if (!_sync_slot || _sync_issued)
+			return false;
+
+		if (_cache.num_writing() || _wt_in_flight)
+			return false;
+
+		/* report a failed write-back instead of waiting for the retry */
+		if (_write_error) {
+			_sync_slot->complete(false);
+			_sync_slot   = nullptr;
+			_write_error = false;
+			return true;
+		}
+
+		if (_cache.num_dirty())
+			return false;
+
+		if (!_jobs_available())
+			return false;
+
+		Block::Operation const operation { .type         = Block::Operation::Type::SYNC,
+		                                   .block_number = 0,
+		                                   .count        = 0 };
+
+		_new_job(operation, Job::Type::SYNC, _sync_slot);
+		_sync_issued = true;
+		return true;
+	}
+
+
+	/*********************
+	 ** Client requests **
+	 *********************/
+
+	Request_slot *_alloc_slot()
+	{
+		for (Request_slot &slot : _slots)
+			if (slot.state == Request_slot::State::FREE)
+				return &slot;
+		return nullptr;
+	}
+
+	void _read_ahead(Block::block_number_t end)
+	{
+		if (!_read_ahead_pages || !_jobs_available())
+			return;
+
+		uint64_t const end_page   = (end*_block_size + _page_size - 1) / _page_size;
+		uint64_t const num_pages  = (_info.block_count*_block_size) / _page_size;
+		uint64_t const window_end = min(end_page + _read_ahead_pages, num_pages);
+
+		/* refill the window once half of it was consumed */
+		if (_read_ahead_end >= end_page + _read_ahead_pages/2)
+			return;
+
+		uint64_t first = max(end_page, _read_ahead_end);
+		while (first < window_end && _cache.lookup(first))
+			first++;
+
+		uint64_t const count = min(window_end - first, (uint64_t)_max_job_pages);
+		if (!count)
+			return;
+
+		_new_job(_page_operation(Block::Operation::Type::READ, first, count),
+		         Job::Type::READ_AHEAD, nullptr);
+
+		_read_ahead_end = first + count;
+		_stats.read_ahead += count;
+	}
+
+	Response _read(Request_slot &slot)
+	{
+		Block::Request const &request = slot.request;
+
+		/*
+		 * Count runs of missing pages, each is fetched by one job whose
+		 * size is limited to the I/O buffer
+		 */
+		unsigned runs = 0;
+		uint64_t run_count = 0;
+		_for_each_page(request.operation.block_number, request.operation.count,
+		               [&] (uint64_t number, size_t, size_t, size_t) {
+			if (_cache.lookup(number)) {
+				run_count = 0;
+				return;
+			}
+			if (run_count == 0 || run_count == _max_job_pages) {
+				runs++;
+				run_count = 0;
+			}
+			run_count++;
+		});
+
+		if (!_jobs_available(runs))
+			return Response::RETRY;
+
+		slot.request.success = true;
+		slot.pending_jobs    = 0;
+
+		/* copy cached content, issue jobs for the runs of missing pages */
+		uint64_t run_first = 0;
+		run_count = 0;
+
+		auto issue_run = [&] {
+			if (!run_count)
+				return;
+			_new_job(_page_operation(Block::Operation::Type::READ, run_first, run_count),
+			         Job::Type::FILL, &slot);
+			slot.pending_jobs++;
+			run_count = 0;
+		};
+
+		_for_each_page(request.operation.block_number, request.operation.count,
+		               [&] (uint64_t number, size_t offset, size_t length, size_t pos) {
+
+			if (Page *page = _cache.lookup(number)) {
+				memcpy(slot.payload + pos, _cache.data(*page) + offset, length);
+				_cache.touch(*page);
+				_stats.hits++;
+				issue_run();
+				return;
+			}
+
+			if (run_count == _max_job_pages)
+				issue_run();
+
+			if (!run_count)
+				run_first = number;
+
+			run_count++;
+			_stats.misses++;
+		});
+		issue_run();
+
+		if (!slot.pending_jobs)
+			slot.complete(true);
+		else
+			slot.state = Request_slot::State::PENDING;
+
+		/* detect sequential access */
+		Block::block_number_t const end = request.operation.block_number
+		                                + request.operation.count;
+
+		if (request.operation.block_number == _last_read_end)
+			_read_ahead(end);
+		else
+			_read_ahead_end = 0;
+
+		_last_read_end = end;
+
+		return Response::ACCEPTED;
+	}
+
+	Response _write(Request_slot &slot)
+	{
+		Block::Request const &request = slot.request;
+
+		if (!_jobs_available())
+			return Response::RETRY;
+
+		bool write_through = false;
+
+		_invalidate_fills(request.operation);
+
+		_for_each_page(request.operation.block_number, request.operation.count,
+		               [&] (uint64_t number, size_t offset, size_t length, size_t pos) {
+
+			Page *page = _cache.lookup(number);
+
+			/* fully written pages need not be read from the device */
+			if (!page && length == _page_size)
+				page = _cache.insert(number);
+
+			if (!page) {
+				write_through = true;
+				return;
+			}
+
+			memcpy(_cache.data(*page) + offset, slot.payload + pos, length);
+			_cache.mark_dirty(*page);
+			_cache.touch(*page);
+		});
+
+		if (_cache.num_dirty())
+			_schedule_sync();
+
+		if (!write_through) {
+			slot.complete(true);
+			return Response::ACCEPTED;
+		}
+
+		/*
+		 * Pages that are only partially written and not cached, or could not
+		 * be allocated, are written to the device directly. The cached pages
+		 * of the request were updated above.
+		 */
+		_new_job(request.operation, Job::Type::WRITE_THROUGH, &slot);
+		slot.state = Request_slot::State::PENDING;
+
+		_wt_in_flight++;
+		_stats.write_throughs++;
+
+		return Response::ACCEPTED;
+	}
+
+	Response _submit(Block::Request const &request)
+	{
+		using Type = Block::Operation::Type;
+
+		Block::Operation const &op = request.operation;
+
+		/* requests are not reordered with respect to a pending sync */
+		if (_sync_slot)
+			return Response::RETRY;
+
+		if (op.type == Type::INVALID)
+			return Response::REJECTED;
+
+		if (op.type == Type::WRITE && !_writeable)
+			return Response::REJECTED;
+
+		if (Block::Operation::has_payload(op.type)
+		 && (op.block_number + op.count > _info.block_count
+		  || op.block_number + op.count < op.block_number))
+			return Response::REJECTED;
+
+		Request_slot *slot = _alloc_slot();
+		if (!slot)
+			return Response::RETRY;
+
+		slot->request = request;
+		slot->payload = nullptr;
+
+		Response response = Response::REJECTED;
+
+		switch (op.type) {
+
+		case Type::READ:
+		case Type::WRITE:
+			_session->with_content(request, [&] (void *addr, size_t) {
+				slot->payload = (char *)addr;
+				response = (op.type == Type::READ) ? _read(*slot)
+				                                   : _write(*slot);
+			});
+			break;
+
+		case Type::SYNC:
+			_sync_slot = slot;
+			slot->state = Request_slot::State::PENDING;
+			response = Response::ACCEPTED;
+			break;
+
+		case Type::TRIM:
+			/* no-op, the cache keeps trimmed pages */
+			slot->complete(true);
+			response = Response::ACCEPTED;
+			break;
+
+		case Type::INVALID:
+			break;
+		}
+
+		if (response != Response::ACCEPTED)
+			slot->state = Request_slot::State::FREE;
+
+		return response;
+	}
+
+	bool _acknowledge()
+	{
+		bool progress = false;
+
+		_session->try_acknowledge([&] (Block::Request_stream::Ack &ack) {
+			for (Request_slot &slot : _slots) {
+				if (slot.state != Request_slot::State::COMPLETE)
+					continue;
+
+				ack.submit(slot.request);
+				slot = Request_slot { };
+				progress = true;
+				return;
+			}
+		});
+		return progress;
+	}
+
+
+	/********************
+	 ** I/O processing **
+	 ********************/
+
+	void _destroy_completed_jobs()
+	{
+		_jobs.for_each([&] (Job &job) {
+			if (!job.completed())
+				return;
+
+			destroy(_heap, &job);
+			_num_jobs--;
+		});
+	}
+
+	void _handle_io()
+	{
+		for (;;) {
+
+			bool progress = _block.update_jobs(*this);
+
+			_destroy_completed_jobs();
+
+			if (_session.constructed()) {
+
+				progress |= _acknowledge();
+
+				_session->with_requests([&] (Block::Request request) {
+					Response const response = _submit(request);
+					if (response != Response::RETRY)
+						progress = true;
+					return response;
+				});
+			}
+
+			progress |= _update_write_back();
+			progress |= _update_sync();
+
+			if (!progress)
+				break;
+		}
+
+		if (_session.constructed())
+			_session->wakeup_client_if_needed();
+	}
+
+
+	/************************
+	 ** Update_jobs_policy **
+	 ************************/
+
+	void produce_write_content(Job &job, off_t offset, char *dst, size_t length)
+	{
+		if (job.type == Job::Type::WRITE_THROUGH) {
+			memcpy(dst, job.slot->payload + offset, length);
+			return;
+		}
+
+		/* write-back, the pages are kept in the cache during the write */
+		Block::block_number_t const block = job.operation().block_number
+		                                  + offset / _block_size;
+
+		_for_each_page(block, length / _block_size,
+		               [&] (uint64_t number, size_t page_offset, size_t n, size_t pos) {
+			if (Page const *page = _cache.lookup(number))
+				memcpy(dst + pos, _cache.data(*page) + page_offset, n); });
+	}
+
+	void consume_read_result(Job &job, off_t offset, char const *src, size_t length)
+	{
+		Block::block_number_t const block = job.operation().block_number
+		                                  + offset / _block_size;
+		Block::block_count_t  const count = length / _block_size;
+
+		/* populate the cache with complete pages not cached yet */
+		if (job.may_fill)
+			_for_each_page(block, count,
+			               [&] (uint64_t number, size_t, size_t n, size_t pos) {
+				if (n != _page_size || _cache.lookup(number))
+					return;
+
+				if (Page *page = _cache.insert(number))
+					memcpy(_cache.data(*page), src + pos, _page_size);
+			});
+
+		if (!job.slot)
+			return;
+
+		/* copy the part requested by the client */
+		Block::Operation const &op = job.slot->request.operation;
+
+		Block::block_number_t const first = max(block, op.block_number);
+		Block::block_number_t const last  = min(block + count, op.block_number + op.count);
+
+		if (first < last)
+			memcpy(job.slot->payload + (first - op.block_number)*_block_size,
+			       src + (first - block)*_block_size,
+			       (last - first)*_block_size);
+	}
+
+	void completed(Job &job, bool success)
+	{
+		switch (job.type) {
+
+		case Job::Type::FILL:
+			job.slot->job_completed(success);
+			break;
+
+		case Job::Type::READ_AHEAD:
+			break;
+
+		case Job::Type::WRITE_BACK:
+			{
+				Block::Operation const op = job.operation();
+				_for_each_page(op.block_number, op.count,
+				               [&] (uint64_t number, size_t, size_t, size_t) {
+					if (Page *page = _cache.lookup(number)) {
+						if (success) _cache.write_back_completed(*page);
+						else         _cache.write_back_failed(*page);
+					}
+				});
+
+				_write_back_stalled = !success;
+
+				if (!success) {
+					error("write-back of blocks ", op.block_number, "+",
+					      op.count, " failed");
+					_write_error = true;
+				}
+
+				if (_cache.num_dirty())
+					_schedule_sync();
+			}
+			break;
+
+		case Job::Type::WRITE_THROUGH:
+			_wt_in_flight--;
+			job.slot->complete(success);
+			break;
+
+		case Job::Type::SYNC:
+			job.slot->complete(success && !_write_error);
+			_write_error = false;
+			_sync_slot   = nullptr;
+			_sync_issued = false;
+			break;
+		}
+	}
+
+
+	/********************
+	 ** Root interface **
+	 ********************/
+
+	Session_capability session(Root::Session_args const &args,
+	                            Affinity const &) override
+	{
+		if (_session.constructed())
+			throw Service_denied();
+
+		size_t const tx_buf_size =
+			Arg_string::find_arg(args.string(), "tx_buf_size").aligned_size();
+
+		Ram_quota const ram_quota = ram_quota_from_args(args.string());
+
+		if (!tx_buf_size)
+			throw Service_denied();
+
+		if (tx_buf_size > ram_quota.value) {
+			error("insufficient 'ram_quota', got ", ram_quota, ", need ",
+			      tx_buf_size);
+			throw Insufficient_ram_quota();
+		}
+
+		Block::Session::Info const info {
+			.block_size  = _block_size,
+			.block_count = _info.block_count,
+			.align_log2  = 0,
+			.writeable   = _writeable,
+		};
+
+		_session_ds.construct(_env.ram(), _env.rm(), tx_buf_size);
+		_session.construct(_env.rm(), _env.ep(), _session_ds->cap(),
+		                   _io_handler, info, ram_quota);
+
+		return _session->cap();
+	}
+
+	void upgrade(Session_capability cap, Root::Upgrade_args const &args) override
+	{
+		if (!args.valid_string())
+			return;
+
+		if (!_session.constructed() || !(cap == _session->cap())) {
+			warning("upgrade of unknown session");
+			return;
+		}
+
+		/* the donated quota is credited to the component's PD by the parent */
+		_session->upgrade(ram_quota_from_args(args.string()));
+
+		if (_verbose)
+			log("session quota upgraded to ", _session->ram_quota());
+	}
+
+	void close(Session_capability cap) override
+	{
+		if (!_session.constructed() || !(cap == _session->cap()))
+			return;
+
+		/* complete the jobs that refer to the client's I/O buffer */
+		auto client_jobs_outstanding = [&] {
+			bool result = false;
+			_jobs.for_each([&] (Job const &job) {
+				result |= (job.slot && !job.completed()); });
+			return result;
+		};
+
+		while (client_jobs_outstanding())
+			_env.ep().wait_and_dispatch_one_io_signal();
+
+		for (Request_slot &slot : _slots)
+			slot = Request_slot { };
+
+		_sync_slot = nullptr;
+
+		_session.destruct();
+		_session_ds.destruct();
+
+		if (_verbose)
+			log("hits: ",           _stats.hits,
+			    " misses: ",        _stats.misses,
+			    " read-ahead: ",    _stats.read_ahead,
+			    " write-backs: ",   _stats.write_backs,
+			    " write-throughs: ", _stats.write_throughs);
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		_block.sigh(_io_handler);
+
+		log("cache of ", _cache.num_pages(), " pages of ", _page_size, " bytes");
+
+		_env.parent().announce(_env.ep().manage(*this));
+	}
+};
+
+
+void Component::construct(Genode::Env &env) { static Block_cache::Main main(env); }
@@ -36,6 +36,9 @@ namespace Cached_fs_rom {
 	using Path = Genode::Path<File_system::MAX_PATH_LEN>;
 	using Tx_source = File_system::Session_client::Tx::Source;
 
+	struct Content;
+	using Content_list = Genode::List<Content>;
+
 	struct Cached_rom;
 	using Cache_space = Genode::Id_space<Cached_rom>;
 
@@ -52,10 +55,18 @@ namespace Cached_fs_rom {
 }
 
 
-struct Cached_fs_rom::Cached_rom final
+/**
+ * File content backing one or more cache entries
+ *
+ * Files of identical content are kept only once. When a transfer completes,
+ * the content is compared to the contents already cached and, if a match is
+ * found, all cache entries are redirected to the existing copy, which makes
+ * all sessions share the same read-only dataspace.
+ */
+struct Cached_fs_rom::Content final : Content_list::Element
 {
-	Cached_rom(Cached_rom const &);
-	Cached_rom &operator = (Cached_rom const &);
+	Content(Content const &);
+	Content &operator = (Content const &);
 
 	Genode::Env   &env;
 	Rm_connection &rm_connection;
@@ -77,26 +88,46 @@ struct Cached_fs_rom::Cached_rom final
 	addr_t                 rm_attachment { };
 	Dataspace_capability   rm_ds { };
 
-	Path const path;
-
-	Cache_space::Element cache_elem;
+	/**
+	 * Hash of the file content, valid once the content is complete
+	 */
+	uint64_t hash = 0;
 
 	Transfer *transfer = nullptr;
 
 	/**
-	 * Reference count of cache entry
+	 * Number of cache entries referring to the content
 	 */
-	int _ref_count = 0;
+	unsigned users = 0;
 
-	Cached_rom(Cache_space   &cache_space,
-	           Env           &env,
-	           Rm_connection &rm,
-	           Path const    &file_path,
-	           size_t         size)
+	/**
+	 * Hash 'size' bytes at 'data'
+	 *
+	 * FNV-1a applied to 64-bit words, with the upper half folded into the
+	 * lower half after each step to let all bits of a word take effect.
+	 * The backing store is page-aligned, which permits the word accesses.
+	 */
+	static uint64_t _hash(char const *data, size_t size)
+	{
+		uint64_t const prime = 0x100000001b3ull;
+		uint64_t       h     = 0xcbf29ce484222325ull;
+
+		uint64_t const *words = (uint64_t const *)data;
+
+		size_t i = 0;
+		for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t)) {
+			h  = (h ^ *words++)*prime;
+			h ^= h >> 32;
+		}
+		for (; i < size; i++)
+			h = (h ^ (uint8_t)data[i])*prime;
+
+		return h ^ size;
+	}
+
+	Content(Env &env, Rm_connection &rm, size_t size)
 	:
-		env(env), rm_connection(rm), file_size(size),
-		path(file_path),
-		cache_elem(*this, cache_space)
+		env(env), rm_connection(rm), file_size(size)
 	{
 		if (size == 0)
 			complete();
@@ -105,17 +136,18 @@ struct Cached_fs_rom::Cached_rom final
 	/**
 	 * Destructor
 	 */
-	~Cached_rom()
+	~Content()
 	{
 		if (rm_attachment)
 			rm.detach(rm_attachment);
 	}
 
 	bool completed() const { return rm_ds.valid(); }
-	bool unused()    const { return (_ref_count < 1); }
 
 	void complete()
 	{
+		hash = _hash(ram_ds.local_addr<char const>(), file_size);
+
 		/* attach dataspace read-only into region map */
 		rm_attachment = rm.attach(ram_ds.cap(), {
 			.size       = ram_ds.size(),
@@ -134,11 +166,76 @@ struct Cached_fs_rom::Cached_rom final
 		rm_ds = rm.dataspace();
 	}
 
+	/**
+	 * Return true if 'other' is a complete copy of the same content
+	 */
+	bool identical(Content const &other) const
+	{
+		return completed() && other.completed()
+		    && file_size == other.file_size
+		    && hash      == other.hash
+		    && memcmp(ram_ds.local_addr<void const>(),
+		              other.ram_ds.local_addr<void const>(), file_size) == 0;
+	}
+};
+
+
+struct Cached_fs_rom::Cached_rom final
+{
+	Cached_rom(Cached_rom const &);
+	Cached_rom &operator = (Cached_rom const &);
+
+	Content *_content;
+
+	Path const path;
+
+	Cache_space::Element cache_elem;
+
+	/**
+	 * Reference count of cache entry
+	 */
+	int _ref_count = 0;
+
+	/**
+	 * Point in time of the last request, used for LRU eviction
+	 */
+	uint64_t last_use = 0;
+
+	Cached_rom(Cache_space   &cache_space,
+	           Content       &content,
+	           Path const    &file_path)
+	:
+		_content(&content), path(file_path),
+		cache_elem(*this, cache_space)
+	{
+		_content->users++;
+	}
+
+	/**
+	 * Destructor
+	 */
+	~Cached_rom() { _content->users--; }
+
+	Content &content() { return *_content; }
+
+	/**
+	 * Redirect cache entry to an identical copy of its content
+	 */
+	void content(Content &content)
+	{
+		_content->users--;
+		_content = &content;
+		_content->users++;
+	}
+
+	bool completed() const { return _content->completed(); }
+	bool unused()    const { return (_ref_count < 1); }
+
 	/**
 	 * Return dataspace with content of file
 	 */
 	Rom_dataspace_capability dataspace() const {
-		return static_cap_cast<Rom_dataspace>(rm_ds); }
+		return static_cap_cast<Rom_dataspace>(_content->rm_ds); }
 
 	struct Guard
 	{
@@ -208,13 +305,17 @@ struct Cached_fs_rom::Transfer final
 			_handle(file_handle), _size(file_size),
 			_transfer_elem(*this, space, Transfer_space::Id{_handle.value})
 		{
-			_cached_rom.transfer = this;
+			_cached_rom.content().transfer = this;
 
 			_submit_next_packet();
 		}
 
+		~Transfer() { _fs.close(_handle); }
+
 		Path const &path() const { return _cached_rom.path; }
 
+		Content &content() { return _cached_rom.content(); }
+
 		bool completed() const { return (_seek >= _size); }
 
 		/**
@@ -230,13 +331,13 @@ struct Cached_fs_rom::Transfer final
 				_seek = _size;
 			} else {
 				size_t const n = min(packet.length(), (size_t)(_size - pkt_seek));
-				memcpy(_cached_rom.ram_ds.local_addr<char>()+pkt_seek,
+				memcpy(content().ram_ds.local_addr<char>()+pkt_seek,
 				       _fs.tx()->packet_content(packet), n);
 				_seek = pkt_seek+n;
 			}
 
 			if (completed())
-					_cached_rom.complete();
+				content().complete();
 			else
 				_submit_next_packet();
 		}
@@ -283,6 +384,7 @@ struct Cached_fs_rom::Main final : Genode::Session_request_handler
 
 	Rm_connection rm { env };
 
+	Content_list   contents  { };
 	Cache_space    cache     { };
 	Transfer_space transfers { };
 	Session_space  sessions  { };
@@ -297,21 +399,66 @@ struct Cached_fs_rom::Main final : Genode::Session_request_handler
 	Io_signal_handler<Main> packet_handler {
 		env.ep(), *this, &Main::handle_packets };
 
+	/**
+	 * Counter for tracking the recent use of cache entries
+	 */
+	uint64_t use_count = 0;
+
+	void release(Content &content)
+	{
+		if (content.users)
+			return;
+
+		contents.remove(&content);
+		destroy(heap, &content);
+	}
+
+	void discard(Cached_rom &rom)
+	{
+		Content &content = rom.content();
+		destroy(heap, &rom);
+		release(content);
+	}
+
 	/**
 	 * Return true when a cache element is freed
+	 *
+	 * The least recently used entry without sessions is evicted. Its
+	 * content is freed once no other cache entry refers to it.
 	 */
 	bool cache_evict()
 	{
 		Cached_rom *discard = nullptr;
 
 		cache.for_each<Cached_rom&>([&] (Cached_rom &rom) {
-			if (!discard && rom.unused()) discard = &rom; });
+			if (rom.unused() && (!discard || rom.last_use < discard->last_use))
+				discard = &rom; });
 
 		if (discard)
-			destroy(heap, discard);
+			this->discard(*discard);
 		return (bool)discard;
 	}
 
+	/**
+	 * Replace freshly read content by an identical one already cached
+	 */
+	void deduplicate(Content &content)
+	{
+		Content *match = nullptr;
+		for (Content *c = contents.first(); c && !match; c = c->next())
+			if (c != &content && c->identical(content))
+				match = c;
+
+		if (!match)
+			return;
+
+		cache.for_each<Cached_rom&>([&] (Cached_rom &rom) {
+			if (&rom.content() == &content)
+				rom.content(*match); });
+
+		release(content);
+	}
+
 	/**
 	 * Open a file handle
 	 */
@@ -393,13 +540,21 @@ struct Cached_fs_rom::Main final : Genode::Session_request_handler
 			File_system::file_size_t file_size = fs.status(handle).size;
 
 			while (env.pd().avail_ram().value < file_size || env.pd().avail_caps().value < 8) {
-				/* drop unused cache entries */
+				/* drop least recently used cache entries */
 				if (!cache_evict()) break;
 			}
 
-			rom = new (heap) Cached_rom(cache, env, rm, path, (size_t)file_size);
+			Content &content = *new (heap) Content(env, rm, (size_t)file_size);
+			contents.insert(&content);
+
+			rom = new (heap) Cached_rom(cache, content, path);
+
+			if (content.completed())
+				deduplicate(content);
 		}
 
+		rom->last_use = ++use_count;
+
 		if (rom->completed()) {
 			/* Create new RPC object */
 			Session_component *session = new (heap)
@@ -408,11 +563,12 @@ struct Cached_fs_rom::Main final : Genode::Session_request_handler
 				log("deliver ROM \"", label, "\"");
 			env.parent().deliver_session_cap(pid, env.ep().manage(*session));
 
-		} else if (!rom->transfer) {
+		} else if (!rom->content().transfer) {
 			File_system::File_handle handle = try_open(path);
 
 			try {
-				new (heap) Transfer(transfers, *rom, fs, handle, rom->file_size);
+				new (heap) Transfer(transfers, *rom, fs, handle,
+				                    rom->content().file_size);
 			}
 			catch (...) {
 				fs.close(handle);
@@ -450,8 +606,10 @@ struct Cached_fs_rom::Main final : Genode::Session_request_handler
 			{
 				transfer.process_packet(pkt);
 				if (transfer.completed()) {
+					Content &content = transfer.content();
 					session_requests.schedule();
 					destroy(heap, &transfer);
+					deduplicate(content);
 				}
 				stray_pkt = false;
 			});
@@ -23,6 +23,9 @@
 #include <base/session_label.h>
 #include <util/arg_string.h>
 #include <base/heap.h>
+#include <rm_session/connection.h>
+#include <region_map/client.h>
+#include <dataspace/client.h>
 
 
 /*****************
@@ -55,6 +58,12 @@ class Fs_rom::Rom_session_component : public  Rpc_object<Rom_session>
 		Sessions             &_sessions;
 		File_system::Session &_fs;
 
+		/*
+		 * RM session for exporting dataspaces of the file-system server,
+		 * not constructed if the RM service is unavailable
+		 */
+		Constructible<Rm_connection> &_rm;
+
 		Constructible<Sessions::Element> _watch_elem { };
 
 		enum { PATH_MAX_LEN = 512 };
@@ -90,6 +99,76 @@ class Fs_rom::Rom_session_component : public  Rpc_object<Rom_session>
 		 */
 		Attached_ram_dataspace _file_ds;
 
+		/**
+		 * Dataspace of the file provided by the file-system server
+		 *
+		 * If the server hands out the file content as dataspace, it is
+		 * passed to the client as ROM module without copying. The server's
+		 * dataspace may be writeable, e.g., a RAM copy made by a VFS plugin.
+		 * Therefore, it is attached read-only to a managed dataspace, and
+		 * only the managed dataspace is handed out. The file handle is kept
+		 * open as long as the dataspace is in use.
+		 */
+		struct Fs_dataspace : Genode::Noncopyable
+		{
+			struct Attach_failed : Exception { };
+
+			File_system::Session           &fs;
+			Rm_connection                  &rm;
+			File_system::File_handle const  handle;
+			Capability<Region_map>   const  map;
+			Dataspace_capability            cap { };
+
+			Fs_dataspace(File_system::Session     &fs,
+			             Rm_connection            &rm,
+			             File_system::File_handle  handle,
+			             Dataspace_capability      fs_ds)
+			:
+				fs(fs), rm(rm), handle(handle),
+				map(rm.create(Dataspace_client(fs_ds).size()))
+			{
+				Region_map_client region_map { map };
+
+				for (;;) {
+					Region_map::Attach_result const result =
+						region_map.attach(fs_ds, {
+							.size       = { },
+							.offset     = { },
+							.use_at     = true,
+							.at         = 0,
+							.executable = false,
+							.writeable  = false
+						});
+
+					if (result.ok())
+						break;
+
+					using Error = Region_map::Attach_error;
+					if      (result == Error::OUT_OF_RAM)  rm.upgrade_ram(8*1024);
+					else if (result == Error::OUT_OF_CAPS) rm.upgrade_caps(2);
+					else {
+						rm.destroy(map);
+						throw Attach_failed();
+					}
+				}
+				cap = region_map.dataspace();
+			}
+
+			~Fs_dataspace()
+			{
+				rm.destroy(map);
+				fs.close(handle);
+			}
+		};
+
+		Constructible<Fs_dataspace> _fs_ds { };
+
+		/*
+		 * Set once the server declined to hand out the file as dataspace or
+		 * the dataspace could not be exported read-only
+		 */
+		bool _fs_ds_unavailable = false;
+
 		/**
 		 * Signal destination for ROM file changes
 		 */
@@ -218,6 +297,40 @@ class Fs_rom::Rom_session_component : public  Rpc_object<Rom_session>
 
 		enum { UPDATE_OR_REPLACE = false, UPDATE_ONLY = true };
 
+		/**
+		 * Obtain the file content as dataspace from the server
+		 *
+		 * \return false if the server does not provide the dataspace
+		 */
+		bool _open_fs_dataspace(File_system::Dir_handle parent_handle,
+		                        char const *file_name)
+		{
+			if (_fs_ds_unavailable || !_rm.constructed()) {
+				_fs_ds_unavailable = true;
+				return false;
+			}
+
+			File_system::File_handle const handle =
+				_fs.file(parent_handle, file_name, File_system::READ_ONLY, false);
+
+			Dataspace_capability ds_cap { };
+			try { ds_cap = _fs.dataspace(handle); }
+			catch (...) { }
+
+			if (ds_cap.valid()) {
+				try { _fs_ds.construct(_fs, *_rm, handle, ds_cap); }
+				catch (...) { }
+			}
+
+			if (!_fs_ds.constructed()) {
+				_fs.close(handle);
+				_fs_ds_unavailable = true;
+				return false;
+			}
+			_file_size = _fs.status(handle).size;
+			return true;
+		}
+
 		/**
 		 * Fill dataspace with file content, return true if the
 		 * current dataspace is reused.
@@ -234,6 +347,22 @@ class Fs_rom::Rom_session_component : public  Rpc_object<Rom_session>
 			Dir_handle parent_handle = _fs.dir(dir_path.base(), false);
 			Handle_guard parent_guard(_fs, parent_handle);
 
+			/*
+			 * The content of a dataspace provided by the server cannot be
+			 * updated in place but is replaced by a new dataspace.
+			 */
+			if (_fs_ds.constructed()) {
+				if (update_only)
+					return false;
+
+				_fs_ds.destruct();
+			}
+
+			if (!update_only && _open_fs_dataspace(parent_handle, file_name.base() + 1)) {
+				_handed_out_version = _curr_version;
+				return true;
+			}
+
 			/* the file handle is opened here... */
 			_file_handle = _fs.file(
 				parent_handle, file_name.base() + 1,
@@ -332,6 +461,7 @@ class Fs_rom::Rom_session_component : public  Rpc_object<Rom_session>
 
 				/* notify if the file is removed */
 				catch (File_system::Lookup_failed) {
+					_fs_ds.destruct();
 					if (_file_size > 0) {
 						memset(_file_ds.local_addr<char>(), 0x00, (size_t)_file_size);
 						_file_size = 0;
@@ -349,6 +479,8 @@ class Fs_rom::Rom_session_component : public  Rpc_object<Rom_session>
 		 * Constructor
 		 *
 		 * \param fs        file-system session to read the file from
+		 * \param rm        RM session for exporting dataspaces of the
+		 *                  file-system server read-only
 		 * \param filename  requested file name
 		 * \param sig_rec   signal receiver used to get notified about changes
 		 *                  within the compound directory (in the case when
@@ -358,9 +490,10 @@ class Fs_rom::Rom_session_component : public  Rpc_object<Rom_session>
 		Rom_session_component(Env &env,
 		                      Sessions &sessions,
 		                      File_system::Session &fs,
+		                      Constructible<Rm_connection> &rm,
 		                      const char *file_path)
 		:
-			_env(env), _sessions(sessions), _fs(fs),
+			_env(env), _sessions(sessions), _fs(fs), _rm(rm),
 			_file_path(file_path),
 			_file_ds(env.ram(), env.rm(), 0) /* realloc later */
 		{
@@ -393,6 +526,9 @@ class Fs_rom::Rom_session_component : public  Rpc_object<Rom_session>
 
 			_try_read_dataspace(UPDATE_OR_REPLACE);
 
+			if (_fs_ds.constructed())
+				return static_cap_cast<Rom_dataspace>(_fs_ds->cap);
+
 			/* always serve a valid, even empty, dataspace */
 			if (_file_ds.size() < 1) {
 				_file_ds.realloc(&_env.ram(), 1);
@@ -492,6 +628,9 @@ class Fs_rom::Rom_root : public Root_component<Fs_rom::Rom_session_component>
 		/* open file-system session */
 		File_system::Connection _fs { _env, _fs_tx_block_alloc };
 
+		/* RM session for exporting dataspaces of the file-system server */
+		Constructible<Rm_connection> _rm { };
+
 		Io_signal_handler<Rom_root> _packet_handler {
 			_env.ep(), *this, &Rom_root::_handle_packets };
 
@@ -524,7 +663,7 @@ class Fs_rom::Rom_root : public Root_component<Fs_rom::Rom_session_component>
 
 			/* create new session for the requested file */
 			return new (md_alloc())
-				Rom_session_component(_env, _sessions, _fs, module_name.string());
+				Rom_session_component(_env, _sessions, _fs, _rm, module_name.string());
 		}
 
 	public:
@@ -541,6 +680,10 @@ class Fs_rom::Rom_root : public Root_component<Fs_rom::Rom_session_component>
 			Root_component<Rom_session_component>(env.ep(), md_alloc),
 			_env(env)
 		{
+			/* without RM service, file content is always copied */
+			try { _rm.construct(_env); }
+			catch (...) { }
+
 			/* Process CONTENT_CHANGED acknowledgement packets at the entrypoint  */
 			_fs.sigh(_packet_handler);
 
@@ -0,0 +1,600 @@
+/*
+ * \brief  Asynchronous file I/O on the Linux host
+ * \author agent
+ * \date   2026-10-18
+ *
+ * Jobs are executed via io_uring if the host kernel supports it and by a
+ * pool of worker threads otherwise. In both cases, jobs may complete in a
+ * different order than they were submitted. Completions are delivered in
+ * the context of the entrypoint.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU General Public License version 2.
+ */
+
+#ifndef _LX_AIO_H_
+#define _LX_AIO_H_
+
+/* Genode includes */
+#include <base/blockade.h>
+#include <base/env.h>
+#include <base/log.h>
+#include <base/mutex.h>
+#include <base/semaphore.h>
+#include <base/signal.h>
+#include <base/thread.h>
+#include <util/reconstructible.h>
+
+/* Linux includes */
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wconversion"
+#include <errno.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <linux/io_uring.h>
+#pragma GCC diagnostic pop  /* restore -Wconversion warnings */
+
+namespace Lx_aio {
+
+	using namespace Genode;
+
+	struct Job;
+	struct Backend;
+	class  Io_uring;
+	class  Thread_pool;
+	class  Queue;
+}
+
+
+/*
+ * I/O operation on a host file descriptor
+ *
+ * A job must stay valid and its file descriptor open until 'completed'
+ * was called.
+ */
+struct Lx_aio::Job : Interface
+{
+	enum class Op { READ, WRITE, FSYNC };
+
+	Op       op     { Op::READ };
+	int      fd     { -1 };
+	char    *buffer { nullptr };
+	size_t   length { 0 };
+	uint64_t offset { 0 };
+
+	Job() { }
+
+	/**
+	 * Called by the entrypoint
+	 *
+	 * \param result  number of bytes transferred or negative errno value
+	 */
+	virtual void completed(long result) = 0;
+
+	long execute() const
+	{
+		ssize_t ret = 0;
+		switch (op) {
+		case Op::READ:  ret = ::pread(fd, buffer, length, (off_t)offset);  break;
+		case Op::WRITE: ret = ::pwrite(fd, buffer, length, (off_t)offset); break;
+		case Op::FSYNC: ret = ::fsync(fd);                                 break;
+		}
+		return ret < 0 ? -errno : ret;
+	}
+
+	private:
+
+		/*
+		 * Noncopyable
+		 */
+		Job(Job const &);
+		Job &operator = (Job const &);
+};
+
+
+struct Lx_aio::Backend : Interface
+{
+	/**
+	 * Queue job
+	 *
+	 * \return false if the backend cannot take another job
+	 */
+	virtual bool submit(Job &) = 0;
+
+	/**
+	 * Pass queued jobs to the host
+	 */
+	virtual void flush() = 0;
+
+	/**
+	 * Return next completed job or nullptr
+	 */
+	virtual Job *next_completed(long &result) = 0;
+
+	/**
+	 * Called once all completed jobs were consumed
+	 */
+	virtual void completions_consumed() = 0;
+
+	/**
+	 * Block until at least one job completed
+	 */
+	virtual void wait_for_completion() = 0;
+};
+
+
+class Lx_aio::Io_uring : public Backend
+{
+	public:
+
+		struct Setup_failed : Exception { };
+
+	private:
+
+		/*
+		 * Noncopyable
+		 */
+		Io_uring(Io_uring const &);
+		Io_uring &operator = (Io_uring const &);
+
+		Signal_context &_completion_sigh;
+
+		io_uring_params _params { };
+
+		int const _fd;
+
+		size_t _sq_size { 0 };
+		size_t _cq_size { 0 };
+
+		char         *_sq_ring { nullptr };
+		char         *_cq_ring { nullptr };
+		io_uring_sqe *_sqes    { nullptr };
+
+		unsigned      *_sq_head  { nullptr };
+		unsigned      *_sq_tail  { nullptr };
+		unsigned      *_sq_array { nullptr };
+		unsigned       _sq_mask  { 0 };
+		unsigned      *_cq_head  { nullptr };
+		unsigned      *_cq_tail  { nullptr };
+		unsigned       _cq_mask  { 0 };
+		io_uring_cqe  *_cqes     { nullptr };
+
+		unsigned _unsubmitted { 0 };
+
+		/*
+		 * Thread that waits for completions and signals the entrypoint
+		 */
+		struct Completion_thread : Thread
+		{
+			Io_uring &_ring;
+			Blockade  blockade { };
+
+			Completion_thread(Env &env, Io_uring &ring)
+			: Thread(env, "aio_completion", 0x2000), _ring(ring) { }
+
+			void entry() override
+			{
+				while (true) {
+					_ring._enter(0, 1, IORING_ENTER_GETEVENTS);
+					_ring._completion_sigh.local_submit();
+
+					/* wait until the entrypoint consumed the completions */
+					blockade.block();
+				}
+			}
+		};
+
+		Constructible<Completion_thread> _thread { };
+
+		static int _setup(unsigned entries, io_uring_params &params)
+		{
+			long const fd = ::syscall(__NR_io_uring_setup, entries, &params);
+			if (fd < 0)
+				throw Setup_failed();
+
+			if (!_ops_supported((int)fd)) {
+				::close((int)fd);
+				throw Setup_failed();
+			}
+
+			return (int)fd;
+		}
+
+		/*
+		 * Kernels before Linux 5.6 provide io_uring but lack the READ and
+		 * WRITE operations as well as the probe, which fails with -EINVAL.
+		 */
+		static bool _ops_supported(int fd)
+		{
+			enum { MAX_OPS = 256 };
+
+			alignas(io_uring_probe)
+			char buf[sizeof(io_uring_probe) + MAX_OPS*sizeof(io_uring_probe_op)] { };
+
+			io_uring_probe &probe = *(io_uring_probe *)buf;
+
+			if (::syscall(__NR_io_uring_register, fd, IORING_REGISTER_PROBE,
+			              &probe, MAX_OPS) < 0)
+				return false;
+
+			auto supported = [&] (unsigned op) {
+				return op < probe.ops_len
+				    && (probe.ops[op].flags & IO_URING_OP_SUPPORTED); };
+
+			return supported(IORING_OP_READ) && supported(IORING_OP_WRITE)
+			    && supported(IORING_OP_FSYNC);
+		}
+
+		long _enter(unsigned to_submit, unsigned min_complete, unsigned flags)
+		{
+			long ret;
+			do {
+				ret = ::syscall(__NR_io_uring_enter, _fd, to_submit,
+				                min_complete, flags, nullptr, 0);
+			} while (ret < 0 && errno == EINTR);
+
+			return ret;
+		}
+
+		void *_mmap(size_t size, off_t offset)
+		{
+			void * const ptr = ::mmap(nullptr, size, PROT_READ | PROT_WRITE,
+			                          MAP_SHARED | MAP_POPULATE, _fd, offset);
+			if (ptr == MAP_FAILED)
+				throw Setup_failed();
+
+			return ptr;
+		}
+
+		template <typename T>
+		static T *_at(char *ring, unsigned offset) { return (T *)(ring + offset); }
+
+		void _unmap()
+		{
+			if (_sqes)
+				::munmap(_sqes, _params.sq_entries*sizeof(io_uring_sqe));
+			if (_cq_ring && _cq_ring != _sq_ring)
+				::munmap(_cq_ring, _cq_size);
+			if (_sq_ring)
+				::munmap(_sq_ring, _sq_size);
+		}
+
+	public:
+
+		Io_uring(Env &env, Signal_context &completion_sigh, unsigned entries)
+		:
+			_completion_sigh(completion_sigh), _fd(_setup(entries, _params))
+		{
+			_sq_size = _params.sq_off.array + _params.sq_entries*sizeof(unsigned);
+			_cq_size = _params.cq_off.cqes  + _params.cq_entries*sizeof(io_uring_cqe);
+
+			bool const single_mmap = _params.features & IORING_FEAT_SINGLE_MMAP;
+			if (single_mmap)
+				_sq_size = _cq_size = max(_sq_size, _cq_size);
+
+			try {
+				_sq_ring = (char *)_mmap(_sq_size, IORING_OFF_SQ_RING);
+				_cq_ring = single_mmap ? _sq_ring
+				                       : (char *)_mmap(_cq_size, IORING_OFF_CQ_RING);
+				_sqes    = (io_uring_sqe *)_mmap(_params.sq_entries*sizeof(io_uring_sqe),
+				                                 IORING_OFF_SQES);
+			} catch (...) {
+				_unmap();
+				::close(_fd);
+				throw;
+			}
+
+			_sq_head  = _at<unsigned>(_sq_ring, _params.sq_off.head);
+			_sq_tail  = _at<unsigned>(_sq_ring, _params.sq_off.tail);
+			_sq_array = _at<unsigned>(_sq_ring, _params.sq_off.array);
+			_sq_mask  = *_at<unsigned>(_sq_ring, _params.sq_off.ring_mask);
+			_cq_head  = _at<unsigned>(_cq_ring, _params.cq_off.head);
+			_cq_tail  = _at<unsigned>(_cq_ring, _params.cq_off.tail);
+			_cq_mask  = *_at<unsigned>(_cq_ring, _params.cq_off.ring_mask);
+			_cqes     = _at<io_uring_cqe>(_cq_ring, _params.cq_off.cqes);
+
+			_thread.construct(env, *this);
+			_thread->start();
+		}
+
+		unsigned entries() const { return _params.sq_entries; }
+
+
+		/*************
+		 ** Backend **
+		 *************/
+
+		bool submit(Job &job) override
+		{
+			unsigned const tail = *_sq_tail;
+			if (tail - __atomic_load_n(_sq_head, __ATOMIC_ACQUIRE) >= _params.sq_entries)
+				return false;
+
+			unsigned const index = tail & _sq_mask;
+			io_uring_sqe &sqe = _sqes[index];
+
+			sqe = io_uring_sqe { };
+			switch (job.op) {
+			case Job::Op::READ:  sqe.opcode = IORING_OP_READ;  break;
+			case Job::Op::WRITE: sqe.opcode = IORING_OP_WRITE; break;
+			case Job::Op::FSYNC: sqe.opcode = IORING_OP_FSYNC; break;
+			}
+			sqe.fd        = job.fd;
+			sqe.addr      = (__u64)job.buffer;
+			sqe.len       = (__u32)job.length;
+			sqe.off       = job.offset;
+			sqe.user_data = (__u64)&job;
+
+			_sq_array[index] = index;
+			__atomic_store_n(_sq_tail, tail + 1, __ATOMIC_RELEASE);
+
+			_unsubmitted++;
+			return true;
+		}
+
+		void flush() override
+		{
+			while (_unsubmitted) {
+				long const ret = _enter(_unsubmitted, 0, 0);
+				if (ret <= 0) {
+					error("io_uring_enter failed: ", -errno);
+					return;
+				}
+				_unsubmitted -= (unsigned)ret;
+			}
+		}
+
+		Job *next_completed(long &result) override
+		{
+			unsigned const head = *_cq_head;
+			if (head == __atomic_load_n(_cq_tail, __ATOMIC_ACQUIRE))
+				return nullptr;
+
+			io_uring_cqe const &cqe = _cqes[head & _cq_mask];
+
+			Job * const job = (Job *)cqe.user_data;
+			result = cqe.res;
+
+			__atomic_store_n(_cq_head, head + 1, __ATOMIC_RELEASE);
+			return job;
+		}
+
+		void completions_consumed() override { _thread->blockade.wakeup(); }
+
+		void wait_for_completion() override { _enter(0, 1, IORING_ENTER_GETEVENTS); }
+};
+
+
+class Lx_aio::Thread_pool : public Backend
+{
+	public:
+
+		enum { MAX_JOBS = 256, MAX_THREADS = 16 };
+
+	private:
+
+		/*
+		 * Noncopyable
+		 */
+		Thread_pool(Thread_pool const &);
+		Thread_pool &operator = (Thread_pool const &);
+
+		struct Worker : Thread
+		{
+			Thread_pool &_pool;
+
+			Worker(Env &env, Thread_pool &pool)
+			: Thread(env, "aio_worker", 0x2000), _pool(pool) { }
+
+			void entry() override { _pool._work(); }
+		};
+
+		struct Done
+		{
+			Job  *job;
+			long  result;
+		};
+
+		Signal_context &_completion_sigh;
+
+		Mutex     _mutex         { };
+		Semaphore _pending_sem   { };
+		Blockade  _completed     { };
+
+		Job *_pending[MAX_JOBS] { };
+		Done _done[MAX_JOBS]    { };
+
+		unsigned _pending_head { 0 }, _pending_tail { 0 };
+		unsigned _done_head    { 0 }, _done_tail    { 0 };
+
+		Constructible<Worker> _workers[MAX_THREADS] { };
+
+		void _work()
+		{
+			while (true) {
+				_pending_sem.down();
+
+				Job *job = nullptr;
+				{
+					Mutex::Guard guard(_mutex);
+					job = _pending[_pending_head++ % MAX_JOBS];
+				}
+
+				long const result = job->execute();
+				{
+					Mutex::Guard guard(_mutex);
+					_done[_done_tail++ % MAX_JOBS] = { job, result };
+				}
+
+				_completion_sigh.local_submit();
+				_completed.wakeup();
+			}
+		}
+
+	public:
+
+		Thread_pool(Env &env, Signal_context &completion_sigh, unsigned threads)
+		:
+			_completion_sigh(completion_sigh)
+		{
+			for (unsigned i = 0; i < min(max(threads, 1u), (unsigned)MAX_THREADS); i++) {
+				_workers[i].construct(env, *this);
+				_workers[i]->start();
+			}
+		}
+
+
+		/*************
+		 ** Backend **
+		 *************/
+
+		bool submit(Job &job) override
+		{
+			{
+				Mutex::Guard guard(_mutex);
+				if (_pending_tail - _pending_head >= MAX_JOBS)
+					return false;
+
+				_pending[_pending_tail++ % MAX_JOBS] = &job;
+			}
+			_pending_sem.up();
+			return true;
+		}
+
+		void flush() override { }
+
+		Job *next_completed(long &result) override
+		{
+			Mutex::Guard guard(_mutex);
+			if (_done_head == _done_tail)
+				return nullptr;
+
+			Done const &done = _done[_done_head++ % MAX_JOBS];
+			result = done.result;
+			return done.job;
+		}
+
+		void completions_consumed() override { }
+
+		void wait_for_completion() override { _completed.block(); }
+};
+
+
+/*
+ * Queue of asynchronously executed jobs
+ */
+class Lx_aio::Queue : Noncopyable
+{
+	public:
+
+		enum { MAX_DEPTH = Thread_pool::MAX_JOBS };
+
+	private:
+
+		unsigned const _depth;
+		unsigned       _in_flight     { 0 };
+		bool           _flush_pending { false };
+
+		Signal_handler<Queue> _completion_handler;
+		Signal_handler<Queue> _flush_handler;
+
+		Constructible<Io_uring>    _io_uring    { };
+		Constructible<Thread_pool> _thread_pool { };
+
+		Backend &_backend;
+
+		Backend &_init_backend(Env &env, bool io_uring, unsigned threads)
+		{
+			if (io_uring) {
+				try {
+					_io_uring.construct(env, _completion_handler, _depth);
+					log("using io_uring with ", _io_uring->entries(), " entries");
+					return *_io_uring;
+				} catch (Io_uring::Setup_failed) {
+					warning("io_uring not available, using thread pool"); }
+			}
+
+			_thread_pool.construct(env, _completion_handler, threads);
+			log("using thread pool with ", threads, " threads");
+			return *_thread_pool;
+		}
+
+		void _handle_flush()
+		{
+			_flush_pending = false;
+			_backend.flush();
+		}
+
+		void _handle_completions()
+		{
+			long result = 0;
+			while (Job *job = _backend.next_completed(result)) {
+				_in_flight--;
+				job->completed(result);
+			}
+			_backend.completions_consumed();
+		}
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param depth     maximum number of jobs in flight
+		 * \param io_uring  try to use io_uring
+		 * \param threads   number of worker threads if io_uring is not used
+		 */
+		Queue(Env &env, unsigned depth, bool io_uring, unsigned threads)
+		:
+			_depth(min(max(depth, 1u), (unsigned)MAX_DEPTH)),
+			_completion_handler(env.ep(), *this, &Queue::_handle_completions),
+			_flush_handler(env.ep(), *this, &Queue::_handle_flush),
+			_backend(_init_backend(env, io_uring, threads))
+		{ }
+
+		unsigned in_flight() const { return _in_flight; }
+
+		bool full() const { return _in_flight >= _depth; }
+
+		/**
+		 * Submit job
+		 *
+		 * Jobs submitted during one signal or RPC dispatch are passed to
+		 * the host at once.
+		 *
+		 * \return false if the queue is full
+		 */
+		bool submit(Job &job)
+		{
+			if (full() || !_backend.submit(job))
+				return false;
+
+			_in_flight++;
+
+			if (!_flush_pending) {
+				_flush_pending = true;
+				_flush_handler.local_submit();
+			}
+			return true;
+		}
+
+		/**
+		 * Block until at least one job completed and deliver completions
+		 */
+		void wait_for_completion()
+		{
+			if (!_in_flight)
+				return;
+
+			_backend.flush();
+			_backend.wait_for_completion();
+			_handle_completions();
+		}
+};
+
+#endif /* _LX_AIO_H_ */
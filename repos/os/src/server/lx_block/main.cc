@@ -18,6 +18,7 @@
 #include <base/log.h>
 #include <block/component.h>
 #include <block/driver.h>
+#include <util/bit_allocator.h>
 #include <util/string.h>
 
 /* libc includes */
@@ -30,6 +31,9 @@
 #include <stdio.h> /* perror */
 #pragma GCC diagnostic pop  /* restore -Wconversion warnings */
 
+/* local includes */
+#include <lx_aio.h>
+
 static bool xml_attr_ok(Genode::Xml_node node, char const *attr)
 {
 	return node.attribute_value(attr, false);
@@ -82,6 +86,84 @@ class Lx_block_driver : public Block::Driver
 
 		int _fd { -1 };
 
+		enum { MAX_REQUESTS = Lx_aio::Queue::MAX_DEPTH };
+
+		struct Request : Lx_aio::Job
+		{
+			Lx_block_driver          &driver;
+			unsigned           const  index;
+			Block::Packet_descriptor  packet;
+
+			Request(Lx_block_driver &driver, unsigned index,
+			        Block::Packet_descriptor const &packet)
+			: driver(driver), index(index), packet(packet) { }
+
+			void completed(long result) override {
+				driver._completed(*this, result); }
+		};
+
+		struct Sync_job : Lx_aio::Job
+		{
+			bool done   { false };
+			long result { 0 };
+
+			void completed(long result) override
+			{
+				this->result = result;
+				done = true;
+			}
+		};
+
+		Lx_aio::Queue _queue;
+
+		Genode::Constructible<Request>    _requests[MAX_REQUESTS] { };
+		Genode::Bit_allocator<MAX_REQUESTS> _request_alloc { };
+
+		void _submit(Lx_aio::Job::Op op, Block::sector_t block_number,
+		             Genode::size_t block_count, char *buffer,
+		             Block::Packet_descriptor &packet)
+		{
+			if (_queue.full())
+				throw Request_congestion();
+
+			unsigned index = 0;
+			try { index = (unsigned)_request_alloc.alloc(); }
+			catch (Genode::Bit_allocator<MAX_REQUESTS>::Out_of_indices) {
+				throw Request_congestion(); }
+
+			_requests[index].construct(*this, index, packet);
+			Request &request = *_requests[index];
+
+			request.op     = op;
+			request.fd     = _fd;
+			request.buffer = buffer;
+			request.length = block_count  * _info.block_size;
+			request.offset = block_number * _info.block_size;
+
+			if (!_queue.submit(request)) {
+				_requests[index].destruct();
+				_request_alloc.free(index);
+				throw Request_congestion();
+			}
+		}
+
+		void _completed(Request &request, long result)
+		{
+			bool const success = result == (long)request.length;
+			if (!success)
+				Genode::error(request.op == Lx_aio::Job::Op::READ ? "read" : "write",
+				              " at offset ", request.offset, " failed: ", result);
+
+			Block::Packet_descriptor packet = request.packet;
+
+			unsigned const index = request.index;
+			_requests[index].destruct();
+			_request_alloc.free(index);
+
+			/* may submit further requests */
+			ack_packet(packet, success);
+		}
+
 	public:
 
 		struct Could_not_open_file : Genode::Exception { };
@@ -90,7 +172,10 @@ class Lx_block_driver : public Block::Driver
 		:
 			Block::Driver(env.ram()),
 			_env(env),
-			_info(_init_info(config))
+			_info(_init_info(config)),
+			_queue(env, config.attribute_value("queue_depth", (unsigned)MAX_REQUESTS),
+			       config.attribute_value("io_uring", true),
+			       config.attribute_value("threads", 4u))
 		{
 			/* open file */
 			File_name const file_name = _file_name(config);
@@ -125,16 +210,7 @@ class Lx_block_driver : public Block::Driver
 		          char                     *buffer,
 		          Block::Packet_descriptor &packet) override
 		{
-			Block::sector_t const offset = block_number * _info.block_size;
-			size_t          const count  = block_count  * _info.block_size;
-
-			ssize_t const n = pread(_fd, buffer, count, (off_t)offset);
-			if (n == -1) {
-				perror("pread");
-				throw Io_error();
-			}
-
-			ack_packet(packet);
+			_submit(Lx_aio::Job::Op::READ, block_number, block_count, buffer, packet);
 		}
 
 		void write(Block::sector_t           block_number,
@@ -147,19 +223,38 @@ class Lx_block_driver : public Block::Driver
 				throw Io_error();
 			}
 
-			Block::sector_t  const offset = block_number * _info.block_size;
-			size_t           const count  = block_count  * _info.block_size;
+			_submit(Lx_aio::Job::Op::WRITE, block_number, block_count,
+			        const_cast<char *>(buffer), packet);
+		}
 
-			ssize_t const n = pwrite(_fd, buffer, count, (off_t)offset);
-			if (n == -1) {
-				perror("pwrite");
+		/*
+		 * The sync is retried by the session once all requests in flight
+		 * completed, which retains the order of writes and syncs. The
+		 * session expects the sync to be finished on return.
+		 */
+		void sync() override
+		{
+			if (_queue.in_flight())
+				throw Request_congestion();
+
+			if (!_info.writeable)
+				return;
+
+			Sync_job job { };
+			job.op = Lx_aio::Job::Op::FSYNC;
+			job.fd = _fd;
+
+			if (!_queue.submit(job))
+				throw Request_congestion();
+
+			while (!job.done)
+				_queue.wait_for_completion();
+
+			if (job.result < 0) {
+				Genode::error("fsync failed: ", job.result);
 				throw Io_error();
 			}
-
-			ack_packet(packet);
 		}
-
-		void sync() override { }
 };
 
 
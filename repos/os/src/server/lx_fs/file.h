@@ -145,6 +145,8 @@ class Lx_fs::File : public Node
 			return (int)ret == -1 ? 0UL : ret;
 		}
 
+		int fd() const override { return _fd; }
+
 		bool sync() override
 		{
 			int ret = fsync(_fd);
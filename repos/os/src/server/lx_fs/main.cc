@@ -24,9 +24,11 @@
 #include <file_system_session/rpc_object.h>
 #include <os/session_policy.h>
 #include <root/component.h>
+#include <util/bit_allocator.h>
 #include <util/xml_node.h>
 
 /* local includes */
+#include <lx_aio.h>
 #include "directory.h"
 #include "notifier.h"
 #include "open_node.h"
@@ -101,6 +103,150 @@ class Lx_fs::Session_component : private Session_resources,
 		Absolute_path const          _root_dir;
 		Signal_handler               _process_packet_dispatcher;
 		Notifier                    &_notifier;
+		Lx_aio::Queue               &_queue;
+
+		/*
+		 * Asynchronously executed READ or WRITE packet
+		 */
+		struct Io_job : Lx_aio::Job
+		{
+			Session_component       &session;
+			unsigned          const  index;
+			Packet_descriptor const  packet;
+			Node                    &node;
+
+			Io_job(Session_component &session, unsigned index,
+			       Packet_descriptor const &packet, Node &node)
+			: session(session), index(index), packet(packet), node(node) { }
+
+			void completed(long result) override {
+				session._io_job_completed(*this, result); }
+
+			bool overlaps(Packet_descriptor const &other) const
+			{
+				return other.position() < offset + length
+				    && offset < other.position() + other.length();
+			}
+		};
+
+		enum { MAX_IO_JOBS = TX_QUEUE_SIZE };
+
+		Constructible<Io_job>          _io_jobs[MAX_IO_JOBS] { };
+		Bit_allocator<MAX_IO_JOBS>     _io_job_alloc         { };
+		unsigned                       _io_jobs_in_flight    { 0 };
+		Constructible<Packet_descriptor> _deferred_packet    { };
+
+		template <typename FN>
+		void _for_each_io_job(Node const &node, FN const &fn)
+		{
+			for (unsigned i = 0; i < MAX_IO_JOBS; i++)
+				if (_io_jobs[i].constructed() && &_io_jobs[i]->node == &node)
+					fn(*_io_jobs[i]);
+		}
+
+		/**
+		 * Wait until all jobs operating on 'node' completed
+		 */
+		void _wait_for_io_jobs(Node const &node)
+		{
+			auto in_flight = [&] {
+				bool result = false;
+				_for_each_io_job(node, [&] (Io_job const &) { result = true; });
+				return result;
+			};
+
+			while (in_flight())
+				_queue.wait_for_completion();
+		}
+
+		void _io_job_completed(Io_job &job, long result)
+		{
+			Packet_descriptor packet = job.packet;
+
+			bool succeeded = false;
+			if (job.op == Lx_aio::Job::Op::READ)
+				/* read data or EOF is a success */
+				succeeded = result > 0
+				         || (result == 0 && packet.position() >= job.node.status().size);
+			else
+				succeeded = (result == (long)job.length);
+
+			unsigned const index = job.index;
+			_io_jobs[index].destruct();
+			_io_job_alloc.free(index);
+			_io_jobs_in_flight--;
+
+			/* File system session can't handle partial writes */
+			if (packet.operation() == Packet_descriptor::WRITE && !succeeded) {
+				/* don't acknowledge */
+				_process_packet_dispatcher.local_submit();
+				return;
+			}
+
+			packet.length(result > 0 ? (size_t)result : 0);
+			packet.succeeded(succeeded);
+			tx_sink()->acknowledge_packet(packet);
+
+			/* resume packet processing outside of the completion handling */
+			_process_packet_dispatcher.local_submit();
+		}
+
+		enum class Io_submit { SUBMITTED, SYNCHRONOUS, DEFERRED };
+
+		/**
+		 * Try to execute the packet operation asynchronously
+		 *
+		 * Reads may overtake each other but are ordered with respect to
+		 * overlapping writes in flight. All other operations on a node are
+		 * executed synchronously once the node has no jobs in flight.
+		 */
+		Io_submit _submit_io_job(Packet_descriptor const &packet, Node &node)
+		{
+			bool const read  = (packet.operation() == Packet_descriptor::READ);
+			bool const write = (packet.operation() == Packet_descriptor::WRITE);
+
+			bool const async = (read || write)
+			                && node.fd() >= 0
+			                && packet.position() != SEEK_TAIL
+			                && tx_sink()->packet_valid(packet)
+			                && packet.length() <= packet.size()
+			                && packet.length() > 0;
+
+			bool conflict = false;
+			_for_each_io_job(node, [&] (Io_job const &job) {
+				if (!async
+				 || ((write || job.op == Lx_aio::Job::Op::WRITE) && job.overlaps(packet)))
+					conflict = true; });
+
+			if (conflict)
+				return Io_submit::DEFERRED;
+
+			if (!async)
+				return Io_submit::SYNCHRONOUS;
+
+			/* the queue may be occupied by other sessions */
+			if (_queue.full() || _io_jobs_in_flight == MAX_IO_JOBS)
+				return _io_jobs_in_flight ? Io_submit::DEFERRED : Io_submit::SYNCHRONOUS;
+
+			unsigned const index = (unsigned)_io_job_alloc.alloc();
+			_io_jobs[index].construct(*this, index, packet, node);
+
+			Io_job &job = *_io_jobs[index];
+			job.op     = read ? Lx_aio::Job::Op::READ : Lx_aio::Job::Op::WRITE;
+			job.fd     = node.fd();
+			job.buffer = tx_sink()->packet_content(packet);
+			job.length = packet.length();
+			job.offset = packet.position();
+
+			if (!_queue.submit(job)) {
+				_io_jobs[index].destruct();
+				_io_job_alloc.free(index);
+				return _io_jobs_in_flight ? Io_submit::DEFERRED : Io_submit::SYNCHRONOUS;
+			}
+
+			_io_jobs_in_flight++;
+			return Io_submit::SUBMITTED;
+		}
 
 		/******************************
 		 ** Packet-stream processing **
@@ -182,15 +328,25 @@ class Lx_fs::Session_component : private Session_resources,
 			tx_sink()->acknowledge_packet(packet);
 		}
 
-		void _process_packet()
+		/**
+		 * Process packet
+		 *
+		 * \return false if the packet must wait for the completion of
+		 *         jobs in flight
+		 */
+		bool _process_packet(Packet_descriptor packet)
 		{
-			Packet_descriptor packet = tx_sink()->get_packet();
-
 			/* assume failure by default */
 			packet.succeeded(false);
 
+			bool deferred = false;
+
 			auto process_packet_fn = [&] (Open_node &open_node) {
-				_process_packet_op(packet, open_node);
+				switch (_submit_io_job(packet, open_node.node())) {
+				case Io_submit::SUBMITTED:   break;
+				case Io_submit::DEFERRED:    deferred = true; break;
+				case Io_submit::SYNCHRONOUS: _process_packet_op(packet, open_node); break;
+				}
 			};
 
 			try {
@@ -199,14 +355,30 @@ class Lx_fs::Session_component : private Session_resources,
 				Genode::error("Invalid_handle");
 				tx_sink()->acknowledge_packet(packet);
 			}
+
+			return !deferred;
 		}
 
+		/*
+		 * Acknowledgements of jobs in flight must not block
+		 */
+		bool _ready_to_process() {
+			return tx_sink()->ack_slots_free() > _io_jobs_in_flight; }
+
 		/**
 		 * Called by signal dispatcher, executed in the context of the main
 		 * thread (not serialized with the RPC functions)
 		 */
 		void _process_packets()
 		{
+			/* packet that had to wait for the completion of jobs in flight */
+			if (_deferred_packet.constructed()) {
+				if (!_ready_to_process() || !_process_packet(*_deferred_packet))
+					return;
+
+				_deferred_packet.destruct();
+			}
+
 			while (tx_sink()->packet_avail()) {
 
 				/*
@@ -221,10 +393,14 @@ class Lx_fs::Session_component : private Session_resources,
 				 * of the main thread. The main thread is however needed
 				 * for receiving any subsequent 'ready-to-ack' signals.
 				 */
-				if (!tx_sink()->ready_to_ack())
+				if (!tx_sink()->ready_to_ack() || !_ready_to_process())
 					return;
 
-				_process_packet();
+				Packet_descriptor const packet = tx_sink()->get_packet();
+				if (!_process_packet(packet)) {
+					_deferred_packet.construct(packet);
+					return;
+				}
 			}
 		}
 
@@ -297,7 +473,8 @@ class Lx_fs::Session_component : private Session_resources,
 		                  size_t               tx_buf_size,
 		                  char const          *root_dir,
 		                  bool                 writeable,
-		                  Notifier            &notifier)
+		                  Notifier            &notifier,
+		                  Lx_aio::Queue       &queue)
 		:
 			Session_resources { env.pd(), env.rm(), ram_quota, cap_quota, tx_buf_size },
 			Session_rpc_object {_packet_ds.cap(), env.rm(), env.ep().rpc_ep() },
@@ -306,7 +483,8 @@ class Lx_fs::Session_component : private Session_resources,
 			_writeable { writeable },
 			_root_dir { root_dir },
 			_process_packet_dispatcher { env.ep(), *this, &Session_component::_process_packets },
-			_notifier { notifier }
+			_notifier { notifier },
+			_queue { queue }
 		{
 			/*
 			 * Register '_process_packets' dispatch function as signal
@@ -321,6 +499,10 @@ class Lx_fs::Session_component : private Session_resources,
 		 */
 		~Session_component()
 		{
+			/* the buffers and file descriptors of jobs in flight must stay valid */
+			while (_io_jobs_in_flight)
+				_queue.wait_for_completion();
+
 			List<List_element<Open_node>> node_list;
 
 			auto collect_fn = [&node_list, this] (Open_node &open_node) {
@@ -448,6 +630,7 @@ class Lx_fs::Session_component : private Session_resources,
 		{
 			_with_open_node(handle, [&] (Open_node &open_node) {
 				Node &node = open_node.node();
+				_wait_for_io_jobs(node);
 				destroy(_alloc, &open_node);
 				destroy(_alloc, &node);
 			});
@@ -547,6 +730,11 @@ class Lx_fs::Root : public Root_component<Session_component>
 		Genode::Attached_rom_dataspace  _config   { _env, "config" };
 		Notifier                        _notifier { _env };
 
+		Lx_aio::Queue _queue {
+			_env, _config.xml().attribute_value("queue_depth", (unsigned)Lx_aio::Queue::MAX_DEPTH),
+			_config.xml().attribute_value("io_uring", true),
+			_config.xml().attribute_value("threads", 4u) };
+
 		static inline bool writeable_from_args(char const *args)
 		{
 			return { Arg_string::find_arg(args, "writeable").bool_value(true) };
@@ -628,7 +816,7 @@ class Lx_fs::Root : public Root_component<Session_component>
 				                           Genode::Cap_quota { cap_quota },
 				                           tx_buf_size,
 				                           absolute_root_dir(root_dir).string(),
-				                           writeable, _notifier };
+				                           writeable, _notifier, _queue };
 
 				auto ram_used { _env.pd().used_ram().value - initial_ram_usage };
 				auto cap_used { _env.pd().used_caps().value - initial_cap_usage };
@@ -74,6 +74,11 @@ class Lx_fs::Node : public File_system::Node_base
 
 		virtual bool sync() { return true; }
 
+		/**
+		 * Return host file descriptor usable for asynchronous I/O or -1
+		 */
+		virtual int fd() const { return -1; }
+
 		virtual Status status() = 0;
 
 		virtual unsigned num_entries() { return 0; }
@@ -3,4 +3,4 @@ REQUIRES = linux
 SRC_CC   = main.cc notifier.cc lx_util.cc watch.cc
 LIBS     = lx_hybrid
 
-INC_DIR += $(PRG_DIR)
+INC_DIR += $(PRG_DIR) $(REP_DIR)/src/server/lx_block
@@ -23,6 +23,7 @@
 #include <nic_session/connection.h>
 #include <os/session_policy.h>
 #include <root/component.h>
+#include <timer_session/connection.h>
 #include <util/arg_string.h>
 
 /* NIC router includes */
@@ -211,6 +212,9 @@ class Net::Root : public Genode::Root_component<Net::Session_component>
 		Genode::Xml_node  _config;
 		bool       const &_verbose;
 
+		/* constructed on demand for the signal moderation of sessions */
+		Genode::Constructible<Timer::Connection> _timer { };
+
 	protected:
 
 		Session_component *_create_session(const char *args) override
@@ -232,7 +236,7 @@ class Net::Root : public Genode::Root_component<Net::Session_component>
 				throw Service_denied();
 			}
 
-			return new (md_alloc())
+			Session_component &session = *new (md_alloc())
 				Session_component(_env.ram(), _env.rm(), _env.ep(),
 				                  ram_quota_from_args(args),
 				                  cap_quota_from_args(args),
@@ -240,6 +244,17 @@ class Net::Root : public Genode::Root_component<Net::Session_component>
 				                  Arg_string::find_arg(args, "rx_buf_size").ulong_value(0),
 				                  mac, _nic, _verbose, label,
 				                  policy.attribute_value("ip_addr", Session_component::Ip_addr()));
+
+			Packet_handler::Signal_moderator::Policy const moderation {
+				Packet_handler::Signal_moderator::Policy::from_xml(policy) };
+
+			if (moderation.enabled()) {
+				if (!_timer.constructed())
+					_timer.construct(_env);
+
+				session.moderate_signals(*_timer, moderation);
+			}
+			return &session;
 		}
 
 		
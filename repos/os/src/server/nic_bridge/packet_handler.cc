@@ -25,27 +25,54 @@ using namespace Net;
 
 void Packet_handler::_ready_to_submit()
 {
+	Packet_descriptor packets[BATCH_SIZE];
+
 	/* as long as packets are available, and we can ack them */
 	while (sink()->packet_avail()) {
-		_packet = sink()->get_packet();
-		if (!_packet.size() || !sink()->packet_valid(_packet)) continue;
-		handle_ethernet(sink()->packet_content(_packet), _packet.size());
 
-		if (!sink()->ready_to_ack()) {
+		unsigned const max = Genode::min((unsigned)BATCH_SIZE,
+		                                 sink()->ack_slots_free());
+		if (!max) {
 			Genode::warning("ack state FULL");
-			return;
+			break;
 		}
 
-		sink()->acknowledge_packet(_packet);
+		unsigned const count = sink()->try_get_packets(packets, max);
+		unsigned       acks  = 0;
+		for (unsigned i = 0; i < count; i++) {
+
+			Packet_descriptor const packet = packets[i];
+			if (!packet.size() || !sink()->packet_valid(packet)) continue;
+			handle_ethernet(sink()->packet_content(packet), packet.size());
+			packets[acks++] = packet;
+		}
+		_signal_moderator.submitted(sink()->try_ack_packets(packets, acks));
 	}
+	_signal_moderator.wakeup();
 }
 
 
 void Packet_handler::_ready_to_ack()
 {
+	Packet_descriptor packets[BATCH_SIZE];
+
 	/* check for acknowledgements */
-	while (source()->ack_avail())
-		source()->release_packet(source()->get_acked_packet());
+	for (;;) {
+		unsigned const count = source()->try_get_acked_packets(packets, BATCH_SIZE);
+		for (unsigned i = 0; i < count; i++)
+			source()->release_packet(packets[i]);
+
+		if (count < BATCH_SIZE)
+			break;
+	}
+	_signal_moderator.wakeup();
+}
+
+
+void Packet_handler::_wakeup()
+{
+	sink()->wakeup();
+	source()->wakeup();
 }
 
 
@@ -114,7 +141,13 @@ void Packet_handler::send(Ethernet_frame *eth, Genode::size_t size)
 		Packet_descriptor packet  = source()->alloc_packet(size);
 		char             *content = source()->packet_content(packet);
 		Genode::memcpy((void*)content, (void*)eth, size);
-		source()->submit_packet(packet);
+		if (!source()->try_submit_packet(packet)) {
+			source()->release_packet(packet);
+			Genode::warning("Packet dropped");
+			return;
+		}
+		_signal_moderator.submitted();
+		_signal_moderator.wakeup();
 	} catch(Packet_stream_source< ::Nic::Session::Policy>::Packet_alloc_failed) {
 		Genode::warning("Packet dropped");
 	}
@@ -20,6 +20,7 @@
 #include <nic_session/connection.h>
 #include <net/ethernet.h>
 #include <net/ipv4.h>
+#include <os/packet_stream_signal_moderator.h>
 
 #include <vlan.h>
 
@@ -37,12 +38,24 @@ namespace Net {
  */
 class Net::Packet_handler
 {
+	public:
+
+		using Signal_moderator = Genode::Packet_stream_signal_moderator<Packet_handler>;
+
 	private:
 
-		Packet_descriptor      _packet { };
+		/* number of packets fetched from a packet-stream queue at once */
+		enum { BATCH_SIZE = 64 };
+
 		Net::Vlan             &_vlan;
 		Genode::Session_label  _label;
 		bool            const &_verbose;
+		Signal_moderator       _signal_moderator { *this, &Packet_handler::_wakeup };
+
+		/**
+		 * wake up the peer of the packet stream
+		 */
+		void _wakeup();
 
 		/**
 		 * submit queue not empty anymore
@@ -97,6 +110,13 @@ class Net::Packet_handler
 
 		Net::Vlan & vlan() { return _vlan; }
 
+		/**
+		 * Moderate the signals to the peer according to 'policy'
+		 */
+		void moderate_signals(Timer::Connection              &timer,
+		                      Signal_moderator::Policy const &policy) {
+			_signal_moderator.enable(timer, policy); }
+
 		/**
 		 * Broadcasts ethernet frame to all clients,
 		 * as long as its really a broadcast packtet.
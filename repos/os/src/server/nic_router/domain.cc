@@ -84,22 +84,18 @@ void Domain::_prepare_reconstructing_ip_config()
 		 * Destroy all link states
 		 *
 		 * Strictly speaking, it is not necessary to destroy all link states,
-		 * only those that this domain applies NAT to. However, the Genode AVL
-		 * tree is not built for removing a selection of nodes and trying to do
-		 * it anyways is complicated. So, for now, we simply destroy all links.
+		 * only those that this domain applies NAT to. However, the link-side
+		 * index is not built for removing a selection of entries and trying to
+		 * do it anyways is complicated. So, for now, we simply destroy all
+		 * links.
 		 */
-		while (Link_side *link_side = _icmp_links.first()) {
-			Link &link { link_side->link() };
+		auto destroy_link = [&] (Link_side &link_side) {
+			Link &link { link_side.link() };
 			link.client_interface().destroy_link(link);
-		}
-		while (Link_side *link_side = _tcp_links.first()) {
-			Link &link { link_side->link() };
-			link.client_interface().destroy_link(link);
-		}
-		while (Link_side *link_side = _udp_links.first()) {
-			Link &link { link_side->link() };
-			link.client_interface().destroy_link(link);
-		}
+		};
+		_icmp_links.drain(destroy_link);
+		_tcp_links.drain(destroy_link);
+		_udp_links.drain(destroy_link);
 	}
 }
 
@@ -285,7 +281,7 @@ bool Domain::finish_construction() const
 }
 
 
-Link_side_tree &Domain::links(L3_protocol const protocol)
+Link_side_table &Domain::links(L3_protocol const protocol)
 {
 	switch (protocol) {
 	case L3_protocol::TCP:  return _tcp_links;
@@ -1639,9 +1639,8 @@ void Interface::_drop_packet(Packet_descriptor const &pkt, char const *reason)
 }
 
 
-void Interface::_handle_pkt()
+void Interface::_handle_pkt(Packet_descriptor const &pkt)
 {
-	Packet_descriptor const pkt = _sink.get_packet();
 	if (!_sink.packet_valid(pkt) || pkt.size() < sizeof(Packet_stream_sink::Content_type)) {
 		_drop_packet(pkt, "invalid Nic packet");
 		return;
@@ -1656,6 +1655,47 @@ void Interface::_handle_pkt()
 }
 
 
+void Interface::_handle_pkts(unsigned long max_pkts)
+{
+	/*
+	 * Fetch received packets in batches, so that the submit queue of our
+	 * sink is updated only once per batch. Acknowledgements that result from
+	 * handling a batch are collected and handed over to the ack queue at once
+	 * as well.
+	 */
+	Packet_descriptor pkts[PKT_BATCH_SIZE];
+	_batch_acks = true;
+	for (unsigned long nr_of_pkts = 0; ; ) {
+
+		unsigned max_batch = PKT_BATCH_SIZE;
+		if (max_pkts) {
+			if (nr_of_pkts >= max_pkts) {
+
+				/*
+				 * Ensure that this handler is called again in order to handle
+				 * the packets left unhandled due to the configured limit.
+				 */
+				if (_sink.packet_avail())
+					Signal_transmitter(_pkt_stream_signal_handler).submit();
+
+				break;
+			}
+			max_batch = (unsigned)Genode::min((unsigned long)max_batch,
+			                                  max_pkts - nr_of_pkts);
+		}
+		unsigned const batch = _sink.try_get_packets(pkts, max_batch);
+		for (unsigned idx = 0; idx < batch; idx++)
+			_handle_pkt(pkts[idx]);
+
+		_flush_acks();
+		nr_of_pkts += batch;
+		if (batch < max_batch)
+			break;
+	}
+	_batch_acks = false;
+}
+
+
 void Interface::_handle_pkt_stream_signal()
 {
 	_timer.update_cached_time();
@@ -1665,8 +1705,16 @@ void Interface::_handle_pkt_stream_signal()
 	 * side. Doing this first frees packet-stream memory which facilitates
 	 * sending new packets in the subsequent steps of this handler.
 	 */
-	while (_source.ack_avail()) {
-		_source.release_packet(_source.try_get_acked_packet());
+	for (;;) {
+		Packet_descriptor acked_pkts[PKT_BATCH_SIZE];
+		unsigned const batch =
+			_source.try_get_acked_packets(acked_pkts, PKT_BATCH_SIZE);
+
+		for (unsigned idx = 0; idx < batch; idx++)
+			_source.release_packet(acked_pkts[idx]);
+
+		if (batch < PKT_BATCH_SIZE)
+			break;
 	}
 
 	/*
@@ -1675,26 +1723,7 @@ void Interface::_handle_pkt_stream_signal()
 	 * applied. If there is no such limit, received packets are handled until
 	 * none is left.
 	 */
-	unsigned long const max_pkts = _config_ptr->max_packets_per_signal();
-	if (max_pkts) {
-		for (unsigned long i = 0; _sink.packet_avail(); i++) {
-
-			if (i >= max_pkts) {
-
-				/*
-				 * Ensure that this handler is called again in order to handle
-				 * the packets left unhandled due to the configured limit.
-				 */
-				Signal_transmitter(_pkt_stream_signal_handler).submit();
-				break;
-			}
-			_handle_pkt();
-		}
-	} else {
-		while (_sink.packet_avail()) {
-			_handle_pkt();
-		}
-	}
+	_handle_pkts(_config_ptr->max_packets_per_signal());
 
 	/*
 	 * Since we use the try_*() variants of the packet-stream API, we
@@ -1890,7 +1919,27 @@ void Interface::_send_submit_pkt(Packet_descriptor &pkt,
 		                               pkt_base,
 		                               pkt_size);
 
-	_source.try_submit_packet(pkt);
+	if (_source.try_submit_packet(pkt))
+		_signal_moderator.submitted();
+}
+
+
+void Interface::_wakeup()
+{
+	_source.wakeup();
+	_sink.wakeup();
+}
+
+
+void Interface::moderate_signals(Genode::Xml_node const &policy)
+{
+	Signal_moderator::Policy const moderation {
+		Signal_moderator::Policy::from_xml(policy) };
+
+	_signal_moderator.enable(_timer, moderation);
+	if (_config_ptr->verbose() && moderation.enabled())
+		log("moderate signals for \"", _policy.label(), "\" (max packets ",
+		    moderation.max_packets, ", max delay ", moderation.max_delay, ")");
 }
 
 
@@ -2267,8 +2316,29 @@ void Interface::handle_config_3()
 }
 
 
+void Interface::_flush_acks()
+{
+	unsigned const nr_of_acked = _sink.try_ack_packets(_acks, _nr_of_acks);
+	_signal_moderator.submitted(nr_of_acked);
+	if (nr_of_acked < _nr_of_acks) {
+		if (_config_ptr->verbose()) {
+			log("[", *_domain_ptr, "] leak ", _nr_of_acks - nr_of_acked,
+			    " packets (sink not ready to acknowledge)");
+		}
+	}
+	_nr_of_acks = 0;
+}
+
+
 void Interface::_ack_packet(Packet_descriptor const &pkt)
 {
+	if (_batch_acks) {
+		if (_nr_of_acks == PKT_BATCH_SIZE)
+			_flush_acks();
+
+		_acks[_nr_of_acks++] = pkt;
+		return;
+	}
 	if (!_sink.try_ack_packet(pkt)) {
 		if (_config_ptr->verbose()) {
 			log("[", *_domain_ptr, "] leak packet (sink not ready to "
@@ -2276,6 +2346,7 @@ void Interface::_ack_packet(Packet_descriptor const &pkt)
 		}
 		return;
 	}
+	_signal_moderator.submitted();
 }
 
 
@@ -26,6 +26,7 @@
 /* Genode includes */
 #include <net/dhcp.h>
 #include <net/icmp.h>
+#include <os/packet_stream_signal_moderator.h>
 
 namespace Genode { class Xml_generator; }
 
@@ -126,9 +127,11 @@ class Net::Interface : private Interface_list::Element
 
 		using Signal_handler            = Genode::Signal_handler<Interface>;
 		using Signal_context_capability = Genode::Signal_context_capability;
+		using Signal_moderator          = Genode::Packet_stream_signal_moderator<Interface>;
 
 		enum { IPV4_TIME_TO_LIVE          = 64 };
 		enum { MAX_FREE_OPS_PER_EMERGENCY = 100 };
+		enum { PKT_BATCH_SIZE             = 64 };
 
 		struct Update_domain
 		{
@@ -172,6 +175,10 @@ class Net::Interface : private Interface_list::Element
 		Interface_object_stats                _arp_stats                 { };
 		Interface_object_stats                _dhcp_stats                { };
 		unsigned long                         _dropped_fragm_ipv4        { 0 };
+		Packet_descriptor                     _acks[PKT_BATCH_SIZE]      { };
+		unsigned                              _nr_of_acks                { 0 };
+		bool                                  _batch_acks                { false };
+		Signal_moderator                      _signal_moderator          { *this, &Interface::_wakeup };
 
 		/*
 		 * Noncopyable
@@ -308,7 +315,13 @@ class Net::Interface : private Interface_list::Element
 		                          void                  *const  prot_base,
 		                          Genode::size_t         const  prot_size);
 
-		void _handle_pkt();
+		void _handle_pkt(Packet_descriptor const &pkt);
+
+		void _handle_pkts(unsigned long max_pkts);
+
+		void _flush_acks();
+
+		void _wakeup();
 
 		void _continue_handle_eth(Packet_descriptor const &pkt);
 
@@ -394,6 +407,11 @@ class Net::Interface : private Interface_list::Element
 
 		void dhcp_allocation_expired(Dhcp_allocation &allocation);
 
+		/**
+		 * Apply the signal-moderation attributes of a session policy
+		 */
+		void moderate_signals(Genode::Xml_node const &policy);
+
 		void send(Genode::size_t pkt_size, auto const &write_to_pkt)
 		{
 			if (!link_state()) {
@@ -483,8 +501,8 @@ class Net::Interface : private Interface_list::Element
 		Interface_link_stats      &icmp_stats()                      { return _icmp_stats; }
 		Interface_object_stats    &arp_stats()                       { return _arp_stats; }
 		Interface_object_stats    &dhcp_stats()                      { return _dhcp_stats; }
-		void                       wakeup_source()                   { _source.wakeup(); }
-		void                       wakeup_sink()                     { _sink.wakeup(); }
+		void                       wakeup_source()                   { _signal_moderator.wakeup(); }
+		void                       wakeup_sink()                     { _signal_moderator.wakeup(); }
 };
 
 #endif /* _INTERFACE_H_ */
@@ -45,6 +45,29 @@ bool Link_side_id::operator > (Link_side_id const &id) const
 }
 
 
+uint32_t Link_side_id::hash() const
+{
+	/* combine the fields and mix the result (finalizer of MurmurHash3) */
+	uint32_t hash {
+		(uint32_t)src_ip.addr[0] << 24 | (uint32_t)src_ip.addr[1] << 16 |
+		(uint32_t)src_ip.addr[2] << 8  | (uint32_t)src_ip.addr[3] };
+
+	hash = hash * 0x9e3779b1 ^
+		((uint32_t)dst_ip.addr[0] << 24 | (uint32_t)dst_ip.addr[1] << 16 |
+		 (uint32_t)dst_ip.addr[2] << 8  | (uint32_t)dst_ip.addr[3]);
+
+	hash = hash * 0x9e3779b1 ^
+		((uint32_t)src_port.value << 16 | (uint32_t)dst_port.value);
+
+	hash ^= hash >> 16;
+	hash *= 0x85ebca6b;
+	hash ^= hash >> 13;
+	hash *= 0xc2b2ae35;
+	hash ^= hash >> 16;
+	return hash;
+}
+
+
 /***************
  ** Link_side **
  ***************/
@@ -53,7 +76,7 @@ Link_side::Link_side(Domain             &domain,
                      Link_side_id const &id,
                      Link               &link)
 :
-	_domain_ptr(&domain), _id(id), _link(link)
+	_domain_ptr(&domain), _id(id), _hash(id.hash()), _link(link)
 {
 	if (link.config().verbose()) {
 		log("[", domain, "] new ", l3_protocol_name(link.protocol()),
@@ -75,6 +98,97 @@ bool Link_side::is_client() const
 }
 
 
+/*********************
+ ** Link_side_table **
+ *********************/
+
+size_t Link_side_table::_size_from_attr(size_t attr)
+{
+	size_t size { 1 };
+	while (size < attr && size < MAX_SIZE)
+		size <<= 1;
+
+	return size < MAX_PROBE ? (size_t)MAX_PROBE : size;
+}
+
+
+Link_side_table::Link_side_table(Allocator &alloc, size_t size)
+:
+	_alloc { alloc },
+	_size  { _size_from_attr(size) },
+	_slots { (Slot *)_alloc.alloc(_size * sizeof(Slot)) }
+{
+	for (size_t idx = 0; idx < _size; idx++)
+		_slots[idx] = Slot { nullptr, 0 };
+}
+
+
+Link_side_table::~Link_side_table()
+{
+	_alloc.free(_slots, _size * sizeof(Slot));
+}
+
+
+void Link_side_table::insert(Link_side *side_ptr)
+{
+	size_t idx { side_ptr->_hash & _mask };
+	for (unsigned probe = 0; probe < MAX_PROBE; probe++, idx = _next(idx)) {
+
+		Slot &slot { _slots[idx] };
+		if (slot.side_ptr)
+			continue;
+
+		slot = Slot { side_ptr, side_ptr->_hash };
+		side_ptr->_overflow = false;
+		return;
+	}
+	_overflow.insert(side_ptr);
+	_overflow_cnt++;
+	side_ptr->_overflow = true;
+}
+
+
+void Link_side_table::remove(Link_side *side_ptr)
+{
+	if (side_ptr->_overflow) {
+		_overflow.remove(side_ptr);
+		_overflow_cnt--;
+		side_ptr->_overflow = false;
+		return;
+	}
+	size_t idx { side_ptr->_hash & _mask };
+	for (unsigned probe = 0; probe < MAX_PROBE; probe++, idx = _next(idx)) {
+
+		if (_slots[idx].side_ptr != side_ptr)
+			continue;
+
+		/*
+		 * Shift succeeding entries back into the hole as long as they stay
+		 * in the probe window of their hash value. This keeps probe
+		 * sequences free of holes, so lookups can stop at the first empty
+		 * slot. An entry that is MAX_PROBE or more slots behind the hole
+		 * can't be moved anyway.
+		 */
+		size_t hole { idx };
+		for (size_t next = _next(hole); _distance(hole, next) < MAX_PROBE; next = _next(next)) {
+
+			Slot const &slot { _slots[next] };
+			if (!slot.side_ptr)
+				break;
+
+			size_t const home { slot.hash & _mask };
+			if (_distance(home, hole) < _distance(home, next)) {
+				_slots[hole] = slot;
+				hole = next;
+			}
+		}
+		_slots[hole] = Slot { nullptr, 0 };
+		return;
+	}
+	ASSERT_NEVER_REACHED;
+}
+
+
 /**********
  ** Link **
  **********/
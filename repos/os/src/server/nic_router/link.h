@@ -35,6 +35,7 @@
 #include <util/list.h>
 #include <net/ipv4.h>
 #include <net/port.h>
+#include <base/allocator.h>
 
 /* local includes */
 #include <list.h>
@@ -52,6 +53,7 @@ namespace Net {
 	class  Link_side_id;
 	class  Link_side;
 	class  Link_side_tree;
+	class  Link_side_table;
 	class  Link;
 	struct Link_list : List<Link> { };
 	class  Tcp_link;
@@ -71,6 +73,8 @@ struct Net::Link_side_id
 
 	void *data_base() const { return (void *)&src_ip; }
 
+	Genode::uint32_t hash() const;
+
 
 	/************************
 	 ** Standard operators **
@@ -86,12 +90,15 @@ __attribute__((__packed__));
 class Net::Link_side : public Genode::Avl_node<Link_side>
 {
 	friend class Link;
+	friend class Link_side_table;
 
 	private:
 
 		Domain             *_domain_ptr;
 		Link_side_id const  _id;
+		Genode::uint32_t    _hash;
 		Link               &_link;
+		bool                _overflow { false };
 
 		/*
 		 * Noncopyable
@@ -174,6 +181,112 @@ struct Net::Link_side_tree : Genode::Avl_tree<Link_side>
 };
 
 
+/**
+ * Open-addressing hash index of link sides with a bounded probe length
+ *
+ * The slot array has a fixed size that is determined by the configuration of
+ * the domain and is allocated once from the allocator of the domain. Thus,
+ * creating a link, which is paid by the session of the initiating interface,
+ * never implies an allocation in the index. Link sides that do not find a
+ * free slot within the probe window of their hash value are kept in an AVL
+ * tree that serves as overflow and bounds the costs in the worst case.
+ */
+class Net::Link_side_table
+{
+	public:
+
+		enum {
+			DEFAULT_SIZE = 256,
+			MAX_SIZE     = 1 << 20,
+			MAX_PROBE    = 16,
+		};
+
+	private:
+
+		struct Slot
+		{
+			Link_side        *side_ptr;
+			Genode::uint32_t  hash;
+		};
+
+		Genode::Allocator    &_alloc;
+		Genode::size_t const  _size;
+		Genode::size_t const  _mask { _size - 1 };
+		Slot          *const  _slots;
+		Link_side_tree        _overflow     { };
+		Genode::size_t        _overflow_cnt { 0 };
+
+		static Genode::size_t _size_from_attr(Genode::size_t attr);
+
+		Genode::size_t _next(Genode::size_t idx) const { return (idx + 1) & _mask; }
+
+		Genode::size_t _distance(Genode::size_t from, Genode::size_t to) const {
+			return (to - from) & _mask; }
+
+		/*
+		 * Noncopyable
+		 */
+		Link_side_table(Link_side_table const &);
+		Link_side_table &operator = (Link_side_table const &);
+
+	public:
+
+		Link_side_table(Genode::Allocator &alloc, Genode::size_t size);
+
+		~Link_side_table();
+
+		void insert(Link_side *side_ptr);
+
+		void remove(Link_side *side_ptr);
+
+		void find_by_id(Link_side_id const &id, auto const &handle_match, auto const &handle_no_match) const
+		{
+			Genode::uint32_t const hash { id.hash() };
+			Genode::size_t idx { hash & _mask };
+			for (unsigned probe = 0; probe < MAX_PROBE; probe++, idx = _next(idx)) {
+
+				Slot const &slot { _slots[idx] };
+				if (!slot.side_ptr)
+					break;
+
+				if (slot.hash == hash && !(slot.side_ptr->_id != id)) {
+					handle_match(*slot.side_ptr);
+					return;
+				}
+			}
+			if (_overflow_cnt) {
+				_overflow.find_by_id(id, handle_match, handle_no_match);
+				return;
+			}
+			handle_no_match();
+		}
+
+		/**
+		 * Call 'fn' for each link side until the table is empty
+		 *
+		 * The functor must remove the given link side from the table.
+		 * Removing other link sides is permitted as well.
+		 */
+		void drain(auto const &fn)
+		{
+			/*
+			 * Entries move only into slots that were vacated by a removal,
+			 * never into slots that were empty before, so a single pass over
+			 * the slot array is sufficient.
+			 */
+			for (Genode::size_t idx = 0; idx < _size; idx++)
+				while (Link_side *side_ptr = _slots[idx].side_ptr)
+					fn(*side_ptr);
+
+			while (Link_side *side_ptr = _overflow.first())
+				fn(*side_ptr);
+		}
+
+		Genode::size_t size()         const { return _size; }
+		Genode::size_t overflow_cnt() const { return _overflow_cnt; }
+};
+
+
 class Net::Link : public Link_list::Element
 {
 	protected:
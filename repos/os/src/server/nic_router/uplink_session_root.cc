@@ -96,6 +96,10 @@ Net::Uplink_session_component::Uplink_session_component(Session_env
 	                                *_rx.source(), _interface_policy },
 	_ram_ds                       { ram_ds }
 {
+	with_matching_policy(label, config.node(),
+		[&] (Xml_node const &policy) { _interface.moderate_signals(policy); },
+		[&] { });
+
 	_interface.attach_to_domain();
 
 	/* install packet stream signal handlers */
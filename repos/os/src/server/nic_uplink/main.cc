@@ -29,6 +29,8 @@
 /* os includes */
 #include <net/ethernet.h>
 #include <nic/packet_allocator.h>
+#include <os/packet_stream_signal_moderator.h>
+#include <os/session_policy.h>
 #include <uplink_session/rpc_object.h>
 #include <nic_session/rpc_object.h>
 
@@ -75,6 +77,7 @@ class Net::Network_interface
 	public:
 
 		using Label = String<32>;
+		using Signal_moderator = Packet_stream_signal_moderator<Network_interface>;
 
 	private:
 
@@ -82,6 +85,13 @@ class Net::Network_interface
 		Packet_stream_source &_source;
 		Label const _label;
 		bool const _verbose;
+		Signal_moderator _signal_moderator { *this, &Network_interface::_wakeup };
+
+		void _wakeup()
+		{
+			_source.wakeup();
+			_sink.wakeup();
+		}
 
 	public:
 
@@ -112,7 +122,8 @@ class Net::Network_interface
 					generate_pkt(Byte_range_ptr { (char *)pkt_base, pkt_size });
 					Size_guard size_guard(pkt_size);
 					log_if(_verbose, "[", _label, "] snd ", Ethernet_frame::cast_from(pkt_base, size_guard));
-					_source.try_submit_packet(pkt);
+					if (_source.try_submit_packet(pkt))
+						_signal_moderator.submitted();
 				},
 				[&] (Packet_stream_source::Alloc_packet_error)
 				{
@@ -124,7 +135,7 @@ class Net::Network_interface
 		void forward_packet(Byte_range_ptr const &src);
 
 		template <typename HANDLE_PKT>
-		void handle_received_packets(HANDLE_PKT && handle_pkt) const
+		void handle_received_packets(HANDLE_PKT && handle_pkt)
 		{
 			while (_source.ack_avail()) {
 				_source.release_packet(_source.try_get_acked_packet());
@@ -132,14 +143,22 @@ class Net::Network_interface
 			while (_sink.packet_avail()) {
 				Packet_descriptor const pkt { _sink.get_packet() };
 				handle_pkt(Byte_range_ptr { _sink.packet_content(pkt), pkt.size() });
-				if (!_sink.try_ack_packet(pkt))
+				if (_sink.try_ack_packet(pkt))
+					_signal_moderator.submitted();
+				else
 					log_if(_verbose, "[", _label, "] failed to ack packet");
 			}
 		}
 
-		void wakeup_source() { _source.wakeup(); };
+		void moderate_signals(Timer::Connection &timer,
+		                      Signal_moderator::Policy const &policy)
+		{
+			_signal_moderator.enable(timer, policy);
+		}
 
-		void wakeup_sink() { _sink.wakeup(); }
+		void wakeup_source() { _signal_moderator.wakeup(); };
+
+		void wakeup_sink() { _signal_moderator.wakeup(); }
 };
 
 
@@ -189,6 +208,8 @@ class Net::Uplink_session_component
 
 		void wakeup_sink() { _net_if.wakeup_sink(); }
 
+		Network_interface &net_if() { return _net_if; }
+
 
 		/***************
 		 ** Accessors **
@@ -276,6 +297,8 @@ class Net::Nic_session_component
 
 		void wakeup_sink() { _net_if.wakeup_sink(); }
 
+		Network_interface &net_if() { return _net_if; }
+
 
 		/******************
 		 ** Nic::Session **
@@ -341,6 +364,7 @@ class Nic_uplink::Main
 		bool _uplink_mac_valid { false };
 		Attached_rom_dataspace _config_rom { _env, "config" };
 		bool const _verbose { _config_rom.xml().attribute_value("verbose", false) };
+		Constructible<Timer::Connection> _timer { };
 
 		Main(Main const &) = delete;
 
@@ -378,6 +402,8 @@ class Nic_uplink::Main
 		}
 
 		void dissolve_nic_session(Nic_session_component &session);
+
+		void moderate_signals(Network_interface &net_if, Session_label const &label);
 };
 
 
@@ -620,6 +646,7 @@ Net::Uplink_session_root::_create_session(char const *args)
 						Arg_string::find_arg(args, "rx_buf_size").ulong_value(0),
 						ram_ds, _main) };
 
+				_main.moderate_signals(session.net_if(), label_from_args(args));
 				_main.manage_uplink_session(session, mac);
 				return &session;
 			});
@@ -690,6 +717,7 @@ Nic_session_component *Net::Nic_session_root::_create_session(char const *args)
 						Arg_string::find_arg(args, "rx_buf_size").ulong_value(0),
 						ram_ds, _main) };
 
+				_main.moderate_signals(session.net_if(), label_from_args(args));
 				_main.manage_nic_session(session);
 				return &session;
 			}
@@ -797,6 +825,30 @@ void Nic_uplink::Main::dissolve_nic_session(Nic_session_component &session)
 }
 
 
+void Nic_uplink::Main::moderate_signals(Network_interface   &net_if,
+                                        Session_label const &label)
+{
+	with_matching_policy(label, _config_rom.xml(),
+		[&] (Xml_node const &policy)
+		{
+			Network_interface::Signal_moderator::Policy const moderation {
+				Network_interface::Signal_moderator::Policy::from_xml(policy) };
+
+			if (!moderation.enabled())
+				return;
+
+			if (!_timer.constructed())
+				_timer.construct(_env);
+
+			net_if.moderate_signals(*_timer, moderation);
+			log_if(_verbose, "[", label, "] moderate signals (max packets ",
+			       moderation.max_packets, ", max delay ",
+			       moderation.max_delay, ")");
+		},
+		[&] { });
+}
+
+
 /***********************
  ** Genode::Component **
  ***********************/
@@ -126,6 +126,11 @@ class Block::Ahdi : public Partition_table
 					fn(i);
 		};
 
+		Partition *_partition(long num) override
+		{
+			return partition_valid(num) ? &*_part_list[num - 1] : nullptr;
+		}
+
 	public:
 
 		using Partition_table::Partition_table;
@@ -143,7 +148,7 @@ class Block::Ahdi : public Partition_table
 
 				Ahdi_partition::Type type = r.id();
 
-				_part_list[i].construct(lba, length, _fs_type(lba), type);
+				_part_list[i].construct(lba, length, Fs::Type(), type);
 
 				log("AHDI Partition ", i + 1, ": LBA ", lba, " (", length,
 				    " blocks) type: '", type, "'");
@@ -21,6 +21,7 @@
 namespace Block {
 	struct Job;
 	struct Sync_read;
+	class  Batch_read;
 }
 
 
@@ -130,4 +131,140 @@ class Block::Sync_read : Noncopyable
 };
 
 
+/*
+ * Block I/O of several independent reads at once
+ *
+ * All reads are submitted before waiting for the first completion, which
+ * allows the device to process them concurrently.
+ */
+class Block::Batch_read : Noncopyable
+{
+	public:
+
+		enum { MAX_READS = 130 };
+
+	private:
+
+		struct Read
+		{
+			Constructible<Block_connection::Job> job    { };
+			Constructible<Byte_range_ptr>        buffer { };
+
+			bool success { false };
+		};
+
+		Sync_read::Handler &_handler;
+		Allocator          &_alloc;
+		size_t       const  _block_size;
+		Read                _reads[MAX_READS] { };
+		unsigned            _count { 0 };
+
+		/*
+		 * Noncopyable
+		 */
+		Batch_read(Batch_read const &) = delete;
+		Batch_read & operator = (Batch_read const &) = delete;
+
+		Read *_read(Block_connection::Job const &job)
+		{
+			for (unsigned i = 0; i < _count; i++)
+				if (&*_reads[i].job == &job)
+					return &_reads[i];
+			return nullptr;
+		}
+
+		bool _all_completed() const
+		{
+			for (unsigned i = 0; i < _count; i++)
+				if (!_reads[i].job->completed())
+					return false;
+			return true;
+		}
+
+	public:
+
+		Batch_read(Sync_read::Handler &handler, Allocator &alloc,
+		           size_t block_size)
+		: _handler(handler), _alloc(alloc), _block_size(block_size) { }
+
+		~Batch_read()
+		{
+			for (unsigned i = 0; i < _count; i++) {
+				_reads[i].job.destruct();
+				_alloc.free(_reads[i].buffer->start, _reads[i].buffer->num_bytes);
+			}
+		}
+
+		/**
+		 * Queue read of 'count' blocks at 'block_number'
+		 *
+		 * \return  index of the read, which is never successful if the
+		 *          batch is full
+		 */
+		unsigned add(block_number_t block_number, block_count_t count)
+		{
+			if (_count == MAX_READS) {
+				error("too many reads in batch");
+				return MAX_READS;
+			}
+
+			Read &read = _reads[_count];
+
+			size_t const size = count*_block_size;
+			read.buffer.construct((char *)_alloc.alloc(size), size);
+			read.job.construct(_handler.connection(), Operation {
+				.type         = Operation::Type::READ,
+				.block_number = block_number,
+				.count        = count });
+
+			return _count++;
+		}
+
+		/**
+		 * Submit all queued reads and wait for their completion
+		 */
+		void execute()
+		{
+			_handler.connection().update_jobs(*this);
+			while (!_all_completed()) {
+				_handler.block_for_io();
+				_handler.connection().update_jobs(*this);
+			}
+		}
+
+		bool success(unsigned index) const {
+			return index < _count && _reads[index].success; }
+
+		Byte_range_ptr const &buffer(unsigned index) const {
+			return *_reads[index].buffer; }
+
+		void consume_read_result(Block_connection::Job &job, off_t offset,
+		                         char const *src, size_t length)
+		{
+			Read * const read = _read(job);
+			if (!read || offset + length > read->buffer->num_bytes)
+				return;
+
+			memcpy(read->buffer->start + offset, src, length);
+		}
+
+		void produce_write_content(Block_connection::Job &, off_t,
+		                           char *, size_t)
+		{
+		}
+
+		void completed(Block_connection::Job &job, bool success)
+		{
+			Read * const read = _read(job);
+			if (!read)
+				return;
+
+			if (!success)
+				error("IO error during partition parsing");
+
+			read->success = success;
+		}
+};
+
+
 #endif /* _PART_BLOCK__BLOCK_H_ */
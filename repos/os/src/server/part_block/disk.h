@@ -23,7 +23,12 @@ class Block::Disk : public Partition_table
 {
 	private:
 
-		Partition _part { 0, _info.block_count, _fs_type(0) };
+		Partition _part { 0, _info.block_count, Fs::Type() };
+
+		Partition *_partition(long num) override
+		{
+			return partition_valid(num) ? &_part : nullptr;
+		}
 
 	public:
 
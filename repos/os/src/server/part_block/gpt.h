@@ -122,6 +122,8 @@ class Block::Gpt : public Block::Partition_table
 			Gpt_hdr() = delete;
 			using Mmio::Mmio;
 
+			uint32_t hdr_crc()        const { return read<Hdr_crc>(); }
+			uint64_t backup_hdr_lba() const { return read<Backup_hdr_lba>(); }
 			uint64_t part_lba_start() const { return read<Part_lba_start>(); }
 			uint64_t part_lba_end()   const { return read<Part_lba_end>(); }
 			uint64_t gpe_lba()        const { return read<Gpe_lba>(); }
@@ -162,8 +164,10 @@ class Block::Gpt : public Block::Partition_table
 				log(" gpe crc: ",    Hex(read<Gpe_crc>(), Hex::OMIT_PREFIX));
 			}
 
-			bool valid(Sync_read::Handler &handler, Allocator &alloc,
-			           size_t block_size, bool check_primary = true)
+			/**
+			 * Check signature, checksum, and location of the header
+			 */
+			bool valid_header(bool check_primary = true)
 			{
 				dump_hdr(check_primary);
 
@@ -176,7 +180,10 @@ class Block::Gpt : public Block::Partition_table
 				/* check header crc */
 				uint32_t crc = read<Hdr_crc>();
 				write<Hdr_crc>(0);
-				if (crc32(base(), read<Hdr_size>()) != crc) {
+				bool const crc_valid = crc32(base(), read<Hdr_size>()) == crc;
+				write<Hdr_crc>(crc);
+
+				if (!crc_valid) {
 					error("Wrong GPT header checksum");
 					return false;
 				}
@@ -186,25 +193,28 @@ class Block::Gpt : public Block::Partition_table
 					if (read<Hdr_lba>() != Hdr_lba::LBA)
 						return false;
 
-				/* check GPT entry array */
-				size_t length = entries() * entry_size();
-				Sync_read gpe(handler, alloc, gpe_lba(), length / block_size);
-				if (!gpe.success()
-				 || crc32((addr_t)gpe.buffer().start, length) != read<Gpe_crc>())
-					return false;
+				return true;
+			}
 
-				if (check_primary) {
-					/* check backup gpt header */
-					Sync_read backup_hdr(handler, alloc, read<Backup_hdr_lba>(), 1);
-					if (!backup_hdr.success())
-						return false;
+			size_t gpe_length() const { return entries() * entry_size(); }
 
-					Gpt_hdr backup(backup_hdr.buffer());
-					if (!backup.valid(handler, alloc, block_size, false))
-						warning("Backup GPT header is corrupted");
-				}
+			/**
+			 * Check GPT entry array
+			 */
+			bool valid_entries(Byte_range_ptr const &gpe)
+			{
+				return gpe.num_bytes >= gpe_length()
+				    && crc32((addr_t)gpe.start, gpe_length()) == read<Gpe_crc>();
+			}
 
-				return true;
+			bool valid(Sync_read::Handler &handler, Allocator &alloc,
+			           size_t block_size, bool check_primary = true)
+			{
+				if (!valid_header(check_primary))
+					return false;
+
+				Sync_read gpe(handler, alloc, gpe_lba(), gpe_length() / block_size);
+				return gpe.success() && valid_entries(gpe.buffer());
 			}
 
 			/* the remainder of the LBA must be zero */
@@ -215,6 +225,10 @@ class Block::Gpt : public Block::Partition_table
 		uint64_t _gpt_part_lba_end { 0 };
 		uint64_t _gpt_total        { 0 };
 		uint64_t _gpt_used         { 0 };
+		uint32_t _gpt_hdr_crc      { 0 };
+
+		/* partitions and file-system types were taken from a former report */
+		bool _from_report { false };
 
 
 		/**
@@ -357,18 +371,30 @@ class Block::Gpt : public Block::Partition_table
 		 */
 		bool _parse_gpt(Gpt_hdr &gpt)
 		{
-			if (!gpt.valid(_handler, _alloc, _info.block_size))
+			/* read entry array and backup header at once */
+			Batch_read batch(_handler, _alloc, _info.block_size);
+
+			unsigned const gpe_index =
+				batch.add(gpt.gpe_lba(), gpt.gpe_length() / _info.block_size);
+			unsigned const backup_index =
+				batch.add(gpt.backup_hdr_lba(), 1);
+
+			batch.execute();
+
+			if (!batch.success(gpe_index) || !gpt.valid_entries(batch.buffer(gpe_index)))
 				return false;
 
-			Sync_read entry_array(_handler, _alloc, gpt.gpe_lba(),
-			                      gpt.entries() * gpt.entry_size() / _info.block_size);
-			if (!entry_array.success())
+			/* check backup gpt header */
+			if (!batch.success(backup_index))
 				return false;
-			Gpt_entry entries(entry_array.buffer());
 
-			_gpt_part_lba_end = gpt.part_lba_end();
-			_gpt_total        = (gpt.part_lba_end() - gpt.part_lba_start()) + 1;
-			_gpt_used         = _calculate_used(gpt, entries, gpt.entries());
+			Gpt_hdr backup(batch.buffer(backup_index));
+			if (!backup.valid(_handler, _alloc, _info.block_size, false))
+				warning("Backup GPT header is corrupted");
+
+			Gpt_entry entries(batch.buffer(gpe_index));
+
+			_gpt_used = _calculate_used(gpt, entries, gpt.entries());
 
 			for (int i = 0; i < MAX_PARTITIONS; i++) {
 
@@ -384,7 +410,7 @@ class Block::Gpt : public Block::Partition_table
 				String<40>                  type { e.type() };
 				String<Gpt_entry::NAME_LEN> name { e };
 
-				_part_list[i].construct(lba, length, _fs_type(lba), guid, type, name);
+				_part_list[i].construct(lba, length, Fs::Type(), guid, type, name);
 
 				log("GPT Partition ", i + 1, ": LBA ", lba, " (", length,
 				    " blocks) type: '", type,
@@ -394,11 +420,59 @@ class Block::Gpt : public Block::Partition_table
 			return true;
 		}
 
+		/**
+		 * Take partitions from a former partitions report
+		 *
+		 * The report is only used if it was generated for the same header,
+		 * which covers the checksum of the entry array.
+		 */
+		bool _parse_report(Xml_node const &report)
+		{
+			if (!report.has_type("partitions")
+			 || report.attribute_value("type", String<8>()) != "gpt"
+			 || !report.has_attribute("gpt_hdr_crc")
+			 || report.attribute_value("gpt_hdr_crc", 0u) != _gpt_hdr_crc
+			 || report.attribute_value("block_size", 0ul) != _info.block_size)
+				return false;
+
+			report.for_each_sub_node("partition", [&] (Xml_node const &node) {
+
+				long const num = node.attribute_value("number", 0L);
+				if (num < 1 || num > MAX_PARTITIONS)
+					return;
+
+				_part_list[num - 1].construct(
+					node.attribute_value("start",       (block_number_t)0),
+					node.attribute_value("length",      (block_number_t)0),
+					node.attribute_value("file_system", Fs::Type()),
+					node.attribute_value("guid",        Gpt_partition::Uuid()),
+					node.attribute_value("type",        Gpt_partition::Uuid()),
+					node.attribute_value("name",        Gpt_partition::Name()));
+			});
+
+			_gpt_used    = report.attribute_value("gpt_used", 0ull);
+			_from_report = true;
+
+			log("GPT partitions taken from former report");
+			return true;
+		}
+
+		Partition *_partition(long num) override
+		{
+			return partition_valid(num) ? &*_part_list[num - 1] : nullptr;
+		}
+
 	public:
 
 		using Partition_table::Partition_table;
 
-		bool parse()
+		/**
+		 * Parse GPT
+		 *
+		 * \param report  former partitions report used instead of reading
+		 *                the entry array if the header did not change
+		 */
+		bool parse(Xml_node const &report)
 		{
 			Sync_read s(_handler, _alloc, Gpt_hdr::Hdr_lba::LBA, 1);
 			if (!s.success())
@@ -406,7 +480,14 @@ class Block::Gpt : public Block::Partition_table
 
 			Gpt_hdr gpt_hdr(s.buffer());
 
-			if (!_parse_gpt(gpt_hdr))
+			if (!gpt_hdr.valid_header())
+				return false;
+
+			_gpt_hdr_crc      = gpt_hdr.hdr_crc();
+			_gpt_part_lba_end = gpt_hdr.part_lba_end();
+			_gpt_total        = (gpt_hdr.part_lba_end() - gpt_hdr.part_lba_start()) + 1;
+
+			if (!_parse_report(report) && !_parse_gpt(gpt_hdr))
 				return false;
 
 			for (unsigned num = 0; num < MAX_PARTITIONS; num++)
@@ -415,6 +496,8 @@ class Block::Gpt : public Block::Partition_table
 			return false;
 		}
 
+		bool from_report() const { return _from_report; }
+
 		bool partition_valid(long num) const override
 		{
 			/* 1-based partition number to 0-based array index */
@@ -443,8 +526,10 @@ class Block::Gpt : public Block::Partition_table
 			uint64_t const total_blocks = _info.block_count;
 			xml.attribute("total_blocks", total_blocks);
 
-			xml.attribute("gpt_total", _gpt_total);
-			xml.attribute("gpt_used",  _gpt_used);
+			xml.attribute("gpt_total",   _gpt_total);
+			xml.attribute("gpt_used",    _gpt_used);
+			xml.attribute("gpt_hdr_crc", _gpt_hdr_crc);
+			xml.attribute("block_size",  _info.block_size);
 
 			_for_each_valid_partition([&] (unsigned i) {
 
@@ -507,6 +507,7 @@ Block::Partition_table & Block::Main::_table()
 	bool pmbr_found = false;
 	bool valid_ahdi = false;
 	bool report     = false;
+	bool reuse      = false;
 
 	if (ignore_gpt && ignore_mbr) {
 		error("invalid configuration: cannot ignore GPT as well as MBR");
@@ -514,7 +515,8 @@ Block::Partition_table & Block::Main::_table()
 	}
 
 	config.with_optional_sub_node("report", [&] (Xml_node const &node) {
-		report = node.attribute_value("partitions", false); });
+		report = node.attribute_value("partitions", false);
+		reuse  = node.attribute_value("reuse",      false); });
 
 	try {
 		if (report)
@@ -553,8 +555,23 @@ Block::Partition_table & Block::Main::_table()
 		}
 	}
 
-	if (!ignore_gpt)
-		valid_gpt = _gpt.parse();
+	if (!ignore_gpt) {
+		/*
+		 * A former report, e.g., of a previous instance of this component,
+		 * spares reading the entry array and probing for file systems if
+		 * the GPT header did not change.
+		 */
+		Constructible<Attached_rom_dataspace> former_report { };
+		if (reuse) {
+			try { former_report.construct(_env, "partitions"); }
+			catch (...) { warning("former partitions report not available"); }
+		}
+
+		if (former_report.constructed())
+			valid_gpt = _gpt.parse(former_report->xml());
+		else
+			valid_gpt = _gpt.parse(Xml_node("<empty/>"));
+	}
 
 	valid_ahdi = _ahdi.parse();
 
@@ -589,6 +606,9 @@ Block::Partition_table & Block::Main::_table()
 
 	Partition_table &table = pick_final_table();
 
+	if (&table != &_gpt || !_gpt.from_report())
+		table.probe_file_systems();
+
 	/* generate appropriate report */
 	if (_reporter.constructed()) {
 		_reporter->generate([&] (Xml_generator &xml) {
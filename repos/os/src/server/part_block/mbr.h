@@ -176,6 +176,11 @@ class Block::Mbr : public Partition_table
 					fn(i);
 		};
 
+		Partition *_partition(long num) override
+		{
+			return partition_valid(num) ? &*_part_list[num - 1] : nullptr;
+		}
+
 	public:
 
 		using Partition_table::Partition_table;
@@ -196,7 +201,7 @@ class Block::Mbr : public Partition_table
 				if (!r.extended()) {
 					block_number_t const lba = r.lba() + offset;
 
-					_part_list[nr - 1].construct(lba, r.sectors(), _fs_type(lba), r.type());
+					_part_list[nr - 1].construct(lba, r.sectors(), Fs::Type(), r.type());
 				}
 
 				log("MBR Partition ", nr, ": LBA ",
@@ -44,20 +44,17 @@ class Block::Partition_table : Interface, Noncopyable
 {
 	protected:
 
+		/* highest partition number of all table types */
+		enum { MAX_PARTITION_NUMBER = 128 };
+
 		Sync_read::Handler  &_handler;
 		Allocator           &_alloc;
 		Session::Info const  _info;
 
-		Fs::Type _fs_type(block_number_t lba)
-		{
-			/* probe for known file-system types */
-			enum { BYTES = 4096 };
-			Sync_read fs(_handler, _alloc, lba, BYTES / _info.block_size);
-			if (fs.success())
-				return Fs::probe((uint8_t *)fs.buffer().start, BYTES);
-			else
-				return Fs::Type();
-		}
+		/**
+		 * Return partition 'num' or nullptr if not valid
+		 */
+		virtual Partition *_partition(long num) = 0;
 
 	public:
 
@@ -71,6 +68,31 @@ class Block::Partition_table : Interface, Noncopyable
 		virtual block_number_t partition_sectors(long num) const = 0;
 
 		virtual void generate_report(Xml_generator &xml) const = 0;
+
+		/**
+		 * Probe all partitions for known file-system types
+		 *
+		 * The beginning of all partitions is read in one batch.
+		 */
+		void probe_file_systems()
+		{
+			enum { BYTES = 4096 };
+
+			Batch_read batch(_handler, _alloc, _info.block_size);
+			unsigned   index[MAX_PARTITION_NUMBER + 1] { };
+
+			for (long num = 0; num <= MAX_PARTITION_NUMBER; num++)
+				if (Partition const *part = _partition(num))
+					index[num] = batch.add(part->lba, BYTES / _info.block_size);
+
+			batch.execute();
+
+			for (long num = 0; num <= MAX_PARTITION_NUMBER; num++)
+				if (Partition *part = _partition(num))
+					if (batch.success(index[num]))
+						part->fs_type = Fs::probe((uint8_t *)batch.buffer(index[num]).start,
+						                          BYTES);
+		}
 };
 
 #endif /* _PART_BLOCK__PARTITION_TABLE_H_ */
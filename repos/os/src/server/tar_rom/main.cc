@@ -18,6 +18,7 @@
 #include <base/heap.h>
 #include <base/log.h>
 #include <base/session_label.h>
+#include <os/compressed_archive.h>
 #include <root/component.h>
 
 namespace Tar_rom {
@@ -255,6 +256,12 @@ struct Tar_rom::Main
 	{
 		log("using tar archive '", _tar_name(), "' with size ", _tar_ds.size());
 
+		Compressed_archive const archive {
+			_tar_ds.local_addr<char const>(), _tar_ds.size() };
+
+		if (archive.compressed())
+			error("'", _tar_name(), "' ", archive);
+
 		env.parent().announce(env.ep().manage(_root));
 	}
 };
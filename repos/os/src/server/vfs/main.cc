@@ -93,6 +93,8 @@ class Vfs_server::Session_component : private Session_resources,
 
 		Genode::Entrypoint &_ep;
 
+		Genode::Pd_session &_pd;
+
 		Io_progress_handler &_io_progress_handler;
 
 		Packet_stream &_stream { *tx_sink() };
@@ -119,6 +121,9 @@ class Vfs_server::Session_component : private Session_resources,
 
 		bool const _writeable;
 
+		/* permit handing out file content as dataspace */
+		bool const _dataspaces;
+
 		bool _stalled = false;
 
 
@@ -449,18 +454,21 @@ class Vfs_server::Session_component : private Session_resources,
 		                  Session_queue       &active_sessions,
 		                  Io_progress_handler &io_progress_handler,
 		                  char          const *root_path,
-		                  bool                 writeable)
+		                  bool                 writeable,
+		                  bool                 dataspaces)
 		:
 			Session_resources(env.pd(), env.rm(), ram_quota, cap_quota, tx_buf_size),
 			Session_rpc_object(_packet_ds.cap(), env.rm(), env.ep().rpc_ep()),
 			_vfs(vfs),
 			_io(io),
 			_ep(env.ep()),
+			_pd(env.pd()),
 			_io_progress_handler(io_progress_handler),
 			_active_sessions(active_sessions),
 			_root_path(root_path),
 			_label(label),
-			_writeable(writeable)
+			_writeable(writeable),
+			_dataspaces(dataspaces)
 		{
 			_tx.sigh_packet_avail(_packet_stream_handler);
 			_tx.sigh_ready_to_ack(_packet_stream_handler);
@@ -751,6 +759,15 @@ class Vfs_server::Session_component : private Session_resources,
 		}
 
 		void control(Node_handle, Control) override { }
+
+		Genode::Dataspace_capability dataspace(File_handle file_handle) override
+		{
+			if (!_dataspaces)
+				return Genode::Dataspace_capability();
+
+			return _apply(file_handle, [&] (File &file) {
+				return file.dataspace(_pd, _ram_guard, _cap_guard); });
+		}
 };
 
 
@@ -945,7 +962,8 @@ class Vfs_server::Root : public Genode::Root_component<Session_component>,
 				                  tx_buf_size, _vfs_env.root_dir(),
 				                  _vfs_env.io(),
 				                  _active_sessions, *this,
-				                  session_root.base(), writeable);
+				                  session_root.base(), writeable,
+				                  policy.attribute_value("dataspace", false));
 
 			auto ram_used = _env.pd().used_ram().value - initial_ram_usage;
 			auto cap_used = _env.pd().used_caps().value - initial_cap_usage;
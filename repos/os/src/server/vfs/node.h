@@ -20,6 +20,9 @@
 #include <vfs/file_system.h>
 #include <os/path.h>
 #include <base/id_space.h>
+#include <base/quota_guard.h>
+#include <pd_session/pd_session.h>
+#include <util/reconstructible.h>
 
 /* Local includes */
 #include "assert.h"
@@ -742,6 +745,36 @@ class Vfs_server::File : public Io_node
 
 		bool _watch_read_ready = false;
 
+		/* file content handed out via 'dataspace', released on close */
+		Dataspace_capability _ds { };
+
+		/*
+		 * Session quota charged for the resources the VFS plugin spent on
+		 * providing '_ds', replenished on close
+		 */
+		struct Ds_charge : Genode::Noncopyable
+		{
+			Genode::Ram_quota_guard &ram_guard;
+			Genode::Cap_quota_guard &cap_guard;
+			Genode::Ram_quota const  ram;
+			Genode::Cap_quota const  caps;
+
+			Ds_charge(Genode::Ram_quota_guard &ram_guard,
+			          Genode::Cap_quota_guard &cap_guard,
+			          Genode::Ram_quota ram, Genode::Cap_quota caps)
+			:
+				ram_guard(ram_guard), cap_guard(cap_guard), ram(ram), caps(caps)
+			{ }
+
+			~Ds_charge()
+			{
+				ram_guard.replenish(ram);
+				cap_guard.replenish(caps);
+			}
+		};
+
+		Genode::Constructible<Ds_charge> _ds_charge { };
+
 	protected:
 
 		static Vfs_handle &_open(Vfs::File_system  &vfs, Genode::Allocator &alloc,
@@ -768,6 +801,58 @@ class Vfs_server::File : public Io_node
 			_leaf_path(vfs.leaf_path(Node::path()))
 		{ }
 
+		~File()
+		{
+			if (_ds.valid())
+				_handle.ds().release(_leaf_path, _ds);
+		}
+
+		/**
+		 * Return dataspace with the file content
+		 *
+		 * The dataspace is obtained from the VFS plugin once per file
+		 * handle. The capability is invalid if the plugin cannot provide
+		 * the content as dataspace or the session quota does not cover the
+		 * RAM and caps the plugin consumed for it.
+		 *
+		 * \param pd  PD session of the server, used for measuring the
+		 *            consumed resources
+		 */
+		Dataspace_capability dataspace(Genode::Pd_session      &pd,
+		                               Genode::Ram_quota_guard &ram_guard,
+		                               Genode::Cap_quota_guard &cap_guard)
+		{
+			if (_ds.valid() || mode() != READ_ONLY)
+				return _ds;
+
+			Genode::size_t const ram_before  = pd.used_ram().value;
+			Genode::size_t const caps_before = pd.used_caps().value;
+
+			Dataspace_capability const ds = _handle.ds().dataspace(_leaf_path);
+			if (!ds.valid())
+				return ds;
+
+			using Genode::Ram_quota;
+			using Genode::Cap_quota;
+
+			Ram_quota const ram  { pd.used_ram().value  - Genode::min(ram_before,  pd.used_ram().value) };
+			Cap_quota const caps { pd.used_caps().value - Genode::min(caps_before, pd.used_caps().value) };
+
+			if (!ram_guard.try_withdraw(ram)) {
+				_handle.ds().release(_leaf_path, ds);
+				return Dataspace_capability();
+			}
+			if (!cap_guard.try_withdraw(caps)) {
+				ram_guard.replenish(ram);
+				_handle.ds().release(_leaf_path, ds);
+				return Dataspace_capability();
+			}
+
+			_ds_charge.construct(ram_guard, cap_guard, ram, caps);
+			_ds = ds;
+			return _ds;
+		}
+
 		void truncate(file_size_t size)
 		{
 			assert_truncate(_handle.fs().ftruncate(&_handle, size));
@@ -45,6 +45,7 @@ struct Vfs_block::File_info
 	File_path const path;
 	bool      const writeable;
 	size_t    const block_size;
+	unsigned  const jobs;
 };
 
 
@@ -59,10 +60,14 @@ Vfs_block::File_info Vfs_block::file_info_from_policy(Session_policy const &poli
 	size_t const block_size =
 		policy.attribute_value("block_size", 512u);
 
+	unsigned const jobs =
+		policy.attribute_value("jobs", (unsigned)Block::Session::TX_QUEUE_SIZE);
+
 	return File_info {
 		.path       = file_path,
 		.writeable  = writeable,
-		.block_size = block_size };
+		.block_size = block_size,
+		.jobs       = max(1u, min(jobs, (unsigned)Block::Session::TX_QUEUE_SIZE)) };
 }
 
 
@@ -73,41 +78,141 @@ class Vfs_block::File
 		File(const File&) = delete;
 		File& operator=(const File&) = delete;
 
-		Vfs::File_system &_vfs;
-		Vfs::Vfs_handle  *_vfs_handle;
+		/*
+		 * Each job operates on a VFS handle of its own as the seek
+		 * position and the outstanding read are a property of the
+		 * handle. The handles are opened on demand.
+		 */
+		struct Slot
+		{
+			Vfs::Vfs_handle *handle { nullptr };
+
+			Constructible<Vfs_block::Job> job { };
+
+			/* order in which the job was accepted */
+			uint64_t seq { 0 };
+
+			bool pending(Block::Operation::Type type) const
+			{
+				return job.constructed() && !job->completed()
+				    && job->request.operation.type == type;
+			}
+		};
+
+		enum { MAX_JOBS = Block::Session::TX_QUEUE_SIZE };
+
+		Genode::Allocator &_alloc;
+		Vfs::File_system  &_vfs;
+		File_info   const  _info;
+
+		Slot     _slots[MAX_JOBS] { };
+		unsigned _max_jobs;
+		unsigned _num_handles { 0 };
+		uint64_t _seq         { 0 };
 
-		Constructible<Vfs_block::Job> _job { };
+		/* SYNC job whose 'queue_sync' is in flight */
+		Slot *_sync_leader { nullptr };
 
 		Block::Session::Info _block_info { };
 
+		bool _open(Vfs::Vfs_handle *&handle)
+		{
+			using DS = Vfs::Directory_service;
+
+			unsigned const mode =
+				_info.writeable ? DS::OPEN_MODE_RDWR
+				                : DS::OPEN_MODE_RDONLY;
+
+			using Open_result = DS::Open_result;
+			return _vfs.open(_info.path.string(), mode, &handle, _alloc)
+			       == Open_result::OPEN_OK;
+		}
+
+		Slot *_free_slot()
+		{
+			for (unsigned i = 0; i < _num_handles; i++)
+				if (!_slots[i].job.constructed())
+					return &_slots[i];
+
+			if (_num_handles == _max_jobs)
+				return nullptr;
+
+			Slot &slot = _slots[_num_handles];
+			if (!_open(slot.handle)) {
+				/* the back end refuses further handles, stick to those we have */
+				warning("limit number of jobs to ", _num_handles);
+				_max_jobs = _num_handles;
+				return nullptr;
+			}
+
+			_num_handles++;
+			return &slot;
+		}
+
+		/*
+		 * A SYNC job acts as barrier for the WRITE jobs accepted
+		 * before. All SYNC jobs whose barrier is passed are served by
+		 * one 'queue_sync' that is issued on behalf of the most recent
+		 * of them.
+		 */
+		bool _execute_sync()
+		{
+			using Type = Block::Operation::Type;
+
+			if (!_sync_leader) {
+
+				uint64_t oldest_write = ~0ull;
+				for (Slot const &slot : _slots)
+					if (slot.pending(Type::WRITE))
+						oldest_write = min(oldest_write, slot.seq);
+
+				for (Slot &slot : _slots)
+					if (slot.pending(Type::SYNC) && slot.seq < oldest_write
+					 && (!_sync_leader || slot.seq > _sync_leader->seq))
+						_sync_leader = &slot;
+
+				if (!_sync_leader)
+					return false;
+			}
+
+			Slot &leader = *_sync_leader;
+
+			bool const progress = leader.job->execute();
+			if (!leader.job->completed())
+				return progress;
+
+			for (Slot &slot : _slots)
+				if (slot.pending(Type::SYNC) && slot.seq < leader.seq)
+					slot.job->finish(leader.job->succeeded());
+
+			_sync_leader = nullptr;
+			return true;
+		}
+
 	public:
 
 		File(Genode::Allocator &alloc,
 		     Vfs::File_system  &vfs,
 		     File_info   const &info)
 		:
-			_vfs        { vfs },
-			_vfs_handle { nullptr }
+			_alloc    { alloc },
+			_vfs      { vfs },
+			_info     { info },
+			_max_jobs { info.jobs }
 		{
 			using DS = Vfs::Directory_service;
 
-			unsigned const mode =
-				info.writeable ? DS::OPEN_MODE_RDWR
-				               : DS::OPEN_MODE_RDONLY;
-
-			using Open_result = DS::Open_result;
-			Open_result res = _vfs.open(info.path.string(), mode,
-			                            &_vfs_handle, alloc);
-			if (res != Open_result::OPEN_OK) {
+			if (!_open(_slots[0].handle)) {
 				error("Could not open '", info.path.string(), "'");
 				throw Genode::Exception();
 			}
+			_num_handles = 1;
 
 			using Stat_result = DS::Stat_result;
 			Vfs::Directory_service::Stat stat { };
 			Stat_result stat_res = _vfs.stat(info.path.string(), stat);
 			if (stat_res != Stat_result::STAT_OK) {
-				_vfs.close(_vfs_handle);
+				_vfs.close(_slots[0].handle);
 				error("Could not stat '", info.path.string(), "'");
 				throw Genode::Exception();
 			}
@@ -129,23 +234,75 @@ class Vfs_block::File
 			 * Sync is expected to be done through the Block
 			 * request stream, omit it here.
 			 */
-			_vfs.close(_vfs_handle);
+			for (unsigned i = 0; i < _num_handles; i++) {
+				_slots[i].job.destruct();
+				_vfs.close(_slots[i].handle);
+			}
 		}
 
 		Block::Session::Info block_info() const { return _block_info; }
 
 		bool execute()
 		{
-			if (!_job.constructed()) {
-				return false;
+			bool progress = false;
+
+			for (unsigned i = 0; i < _num_handles; i++) {
+				Slot &slot = _slots[i];
+
+				if (!slot.job.constructed()
+				 || slot.job->request.operation.type == Block::Operation::Type::SYNC)
+					continue;
+
+				progress |= slot.job->execute();
 			}
 
-			return _job->execute();
+			progress |= _execute_sync();
+
+			return progress;
 		}
 
-		bool acceptable() const
+		/*
+		 * Jobs are executed concurrently on different handles, so the
+		 * order of overlapping requests is not preserved. Hence, a
+		 * request that overlaps an in-flight job is deferred unless both
+		 * only read.
+		 */
+		bool _overlaps_pending_job(Block::Operation const &op) const
 		{
-			return !_job.constructed();
+			using Type = Block::Operation::Type;
+
+			auto ranged = [] (Type type) {
+				return type == Type::READ || type == Type::WRITE
+				    || type == Type::TRIM; };
+
+			if (!ranged(op.type))
+				return false;
+
+			for (unsigned i = 0; i < _num_handles; i++) {
+				Slot const &slot = _slots[i];
+
+				if (!slot.job.constructed() || slot.job->completed())
+					continue;
+
+				Block::Operation const &other = slot.job->request.operation;
+
+				if (!ranged(other.type)
+				 || (op.type == Type::READ && other.type == Type::READ))
+					continue;
+
+				if (op.block_number < other.block_number + other.count
+				 && other.block_number < op.block_number + op.count)
+					return true;
+			}
+			return false;
+		}
+
+		bool acceptable(Block::Request const &request)
+		{
+			if (_overlaps_pending_job(request.operation))
+				return false;
+
+			return _free_slot() != nullptr;
 		}
 
 		bool valid(Block::Request const &request)
@@ -171,28 +328,43 @@ class Vfs_block::File
 			}
 		}
 
+		/*
+		 * Must only be called if 'acceptable' returned true for the request
+		 */
 		void submit(Block::Request req, void *ptr, size_t length)
 		{
+			Slot *slot = _free_slot();
+			if (!slot)
+				return;
+
 			file_offset const base_offset =
 				req.operation.block_number * _block_info.block_size;
 
-			_job.construct(*_vfs_handle, req, base_offset,
-			               reinterpret_cast<char*>(ptr), length);
+			slot->job.construct(*slot->handle, req, base_offset,
+			                    reinterpret_cast<char*>(ptr), length);
+			slot->seq = _seq++;
 		}
 
+		/*
+		 * Jobs are completed in any order
+		 */
 		template <typename FN>
 		void with_any_completed_job(FN const &fn)
 		{
-			if (!_job.constructed() || !_job->completed()) {
-				return;
-			}
+			for (unsigned i = 0; i < _num_handles; i++) {
+				Slot &slot = _slots[i];
+
+				if (!slot.job.constructed() || !slot.job->completed())
+					continue;
 
-			Block::Request req = _job->request;
-			req.success = _job->succeeded();
+				Block::Request req = slot.job->request;
+				req.success = slot.job->succeeded();
 
-			_job.destruct();
+				slot.job.destruct();
 
-			fn(req);
+				fn(req);
+				return;
+			}
 		}
 };
 
@@ -241,7 +413,7 @@ struct Block_session_component : Rpc_object<Block::Session>,
 
 				using Response = Block::Request_stream::Response;
 
-				if (!_file.acceptable()) {
+				if (!_file.acceptable(request)) {
 					return Response::RETRY;
 				}
 
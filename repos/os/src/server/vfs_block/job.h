@@ -263,6 +263,17 @@ namespace Vfs_block {
 		bool completed() const { return complete; }
 		bool succeeded()   const { return success; }
 
+		/**
+		 * Complete job without executing it, e.g., a SYNC job that is
+		 * covered by the sync of another job
+		 */
+		void finish(bool succeeded)
+		{
+			state    = State::COMPLETE;
+			success  = succeeded;
+			complete = true;
+		}
+
 		void print(Genode::Output &out) const
 		{
 			Genode::print(out, "(", request.operation, ")",
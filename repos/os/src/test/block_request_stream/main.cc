@@ -15,12 +15,16 @@
 #include <block/request_stream.h>
 #include <base/component.h>
 #include <base/attached_ram_dataspace.h>
+#include <base/attached_rom_dataspace.h>
+#include <base/allocator_avl.h>
+#include <base/heap.h>
 #include <root/root.h>
 
 namespace Test {
 
 	struct Block_session_component;
 	template <unsigned> struct Jobs;
+	struct Merge_test;
 
 	struct Main;
 
@@ -38,6 +42,7 @@ struct Test::Block_session_component : Rpc_object<Block::Session>,
 
 	using Block::Request_stream::with_requests;
 	using Block::Request_stream::with_content;
+	using Block::Request_stream::merge_requests;
 	using Block::Request_stream::try_acknowledge;
 	using Block::Request_stream::wakeup_client_if_needed;
 
@@ -143,10 +148,167 @@ struct Test::Jobs : Noncopyable
 };
 
 
+/**
+ * Check request merging with packets submitted by a local packet source
+ *
+ * A run of packets contiguous on the device and in the packet buffer is
+ * followed by a run that is contiguous in the packet buffer only. Each run
+ * must reach the driver as one request. The driver completes the first
+ * request successfully and fails the second one. Each packet must then be
+ * acknowledged with its own tag, offset, and block, and with the success
+ * state of its request.
+ */
+struct Test::Merge_test
+{
+	static constexpr size_t BLOCK_SIZE = Block_session_component::BLOCK_SIZE;
+
+	enum { RUN_A = 4, RUN_B = 3, NUM_PACKETS = RUN_A + RUN_B };
+
+	/* first block of the second run, not adjacent to the first run */
+	enum { BLOCK_B = 8 };
+
+	using Response = Block::Request_stream::Response;
+	using Source   = Packet_stream_source<Block::Session::Tx_policy>;
+
+	Env &_env;
+
+	Heap                   _heap         { _env.ram(), _env.rm() };
+	Allocator_avl          _packet_alloc { &_heap };
+	Attached_ram_dataspace _ds           { _env.ram(), _env.rm(), 128*1024 };
+
+	Block_session_component _session { _env.rm(), _ds.cap(), _env.ep(),
+	                                   Signal_context_capability() };
+
+	Source _source { _ds.cap(), _env.rm(), _packet_alloc };
+
+	unsigned _errors = 0;
+
+	void _check(bool condition, auto &&... args)
+	{
+		if (condition)
+			return;
+
+		error(args...);
+		_errors++;
+	}
+
+	static Block::block_number_t _block(unsigned i) {
+		return i < RUN_A ? i : BLOCK_B + (i - RUN_A); }
+
+	Merge_test(Env &env) : _env(env) { }
+
+	/**
+	 * Run test with merging limited to 'max_transfer' bytes
+	 *
+	 * 
+eturn true if the test succeeded
+	 */
+	bool run(size_t max_transfer)
+	{
+		_session.merge_requests({ max_transfer });
+
+		/* allocate one buffer, each packet refers to one block of it */
+		Block::Packet_descriptor const buffer =
+			_source.alloc_packet(NUM_PACKETS*BLOCK_SIZE, (unsigned)log2(BLOCK_SIZE));
+
+		auto offset = [&] (unsigned i) {
+			return buffer.offset() + (Block::off_t)(i*BLOCK_SIZE); };
+
+		/* the packets are processed right away, signals are not needed */
+		for (unsigned i = 0; i < NUM_PACKETS; i++)
+			_check(_source.try_submit_packet(Block::Packet_descriptor(
+				Block::Packet_descriptor(offset(i), BLOCK_SIZE),
+				Block::Packet_descriptor::WRITE, _block(i), 1, { i })),
+			       "failed to submit packet ", i);
+
+		/* import requests as driver */
+		Block::Request requests[NUM_PACKETS] { };
+		unsigned num_requests = 0;
+
+		_session.with_requests([&] (Block::Request request) {
+
+			if (num_requests == NUM_PACKETS)
+				return Response::RETRY;
+
+			requests[num_requests++] = request;
+			return Response::ACCEPTED;
+		});
+
+		_check(num_requests == 2, "packets handed to the driver as ",
+		       num_requests, " requests, expected 2");
+
+		if (num_requests != 2)
+			return false;
+
+		_check(requests[0].operation.block_number == 0
+		    && requests[0].operation.count        == RUN_A
+		    && requests[0].offset                 == offset(0),
+		       "unexpected first request: ", requests[0].operation);
+
+		_check(requests[1].operation.block_number == BLOCK_B
+		    && requests[1].operation.count        == RUN_B
+		    && requests[1].offset                 == offset(RUN_A),
+		       "unexpected second request: ", requests[1].operation);
+
+		/* complete the first request successfully, fail the second one */
+		requests[0].success = true;
+		requests[1].success = false;
+
+		unsigned num_completed = 0;
+		_session.try_acknowledge([&] (Block::Request_stream::Ack &ack) {
+			if (num_completed < num_requests)
+				ack.submit(requests[num_completed++]); });
+
+		/* check acknowledgements as client */
+		bool     acked[NUM_PACKETS] { };
+		unsigned num_acks = 0;
+
+		while (_source.ack_avail()) {
+
+			Block::Packet_descriptor const packet = _source.try_get_acked_packet();
+			num_acks++;
+
+			unsigned long const tag = packet.tag().value;
+			if (tag >= NUM_PACKETS || acked[tag]) {
+				_check(false, "unexpected acknowledgement with tag ", tag);
+				continue;
+			}
+			acked[tag] = true;
+
+			unsigned const i = (unsigned)tag;
+
+			_check(packet.offset() == offset(i),
+			       "packet ", i, " acknowledged with offset ", packet.offset());
+
+			_check(packet.block_number() == _block(i) && packet.block_count() == 1,
+			       "packet ", i, " acknowledged with block ", packet.block_number(),
+			       " count ", packet.block_count());
+
+			_check(packet.succeeded() == (i < RUN_A),
+			       "packet ", i, " acknowledged with success state ",
+			       packet.succeeded());
+		}
+
+		_check(num_acks == NUM_PACKETS, "got ", num_acks,
+		       " acknowledgements, expected ", (unsigned)NUM_PACKETS);
+
+		_source.release_packet(buffer);
+
+		return _errors == 0;
+	}
+};
+
+
 struct Test::Main : Rpc_object<Typed_root<Block::Session> >
 {
 	Env &_env;
 
+	Attached_rom_dataspace _config { _env, "config" };
+
+	/* enable request merging if non-zero */
+	size_t const _max_transfer =
+		_config.xml().attribute_value("max_transfer", Number_of_bytes(0));
+
 	Constructible<Attached_ram_dataspace> _block_ds { };
 
 	Constructible<Block_session_component> _block_session { };
@@ -172,6 +334,18 @@ struct Test::Main : Rpc_object<Typed_root<Block::Session> >
 				if (!_jobs.acceptable(request))
 					return Block::Request_stream::Response::RETRY;
 
+				/*
+				 * The requests of the client must not exceed the maximum
+				 * transfer size for this check to apply to merged requests.
+				 */
+				size_t const bytes = request.operation.count
+				                   * Block_session_component::BLOCK_SIZE;
+				if (_max_transfer && bytes > _max_transfer) {
+					error("merged request exceeds maximum transfer size: ",
+					      request.operation);
+					return Block::Request_stream::Response::REJECTED;
+				}
+
 				/* access content of the request */
 				block_session.with_content(request, [&] (void *ptr, size_t size) {
 					(void)ptr;
@@ -231,6 +405,9 @@ struct Test::Main : Rpc_object<Typed_root<Block::Session> >
 		_block_session.construct(_env.rm(), _block_ds->cap(), _env.ep(),
 		                         _request_handler);
 
+		if (_max_transfer)
+			_block_session->merge_requests({ _max_transfer });
+
 		return _block_session->cap();
 	}
 
@@ -242,8 +419,23 @@ struct Test::Main : Rpc_object<Typed_root<Block::Session> >
 		_block_ds.destruct();
 	}
 
+	Constructible<Merge_test> _merge_test { };
+
 	Main(Env &env) : _env(env)
 	{
+		if (_max_transfer) {
+			_merge_test.construct(_env);
+			bool const success = _merge_test->run(_max_transfer);
+			_merge_test.destruct();
+
+			if (!success) {
+				error("request merging test failed");
+				_env.parent().exit(-1);
+				return;
+			}
+			log("request merging test succeeded");
+		}
+
 		_env.parent().announce(_env.ep().manage(*this));
 	}
 };
@@ -24,6 +24,7 @@
 #include <base/sleep.h>
 #include <base/attached_rom_dataspace.h>
 #include <os/vfs.h>
+#include <timer_session/connection.h>
 
 using namespace Net;
 using namespace Genode;
@@ -104,6 +105,25 @@ struct Pcap_packet_record
 };
 
 
+/**
+ * Straight-forward RFC 1071 implementation that serves as reference
+ */
+static uint16_t reference_checksum(uint8_t const *data_ptr, size_t data_sz)
+{
+	uint64_t sum = 0;
+	for (; data_sz > 1; data_sz -= 2, data_ptr += 2)
+		sum += ((Packed_uint16 const *)data_ptr)->value;
+
+	if (data_sz > 0)
+		sum += *data_ptr;
+
+	while (uint64_t const remainder = sum >> 16)
+		sum = (sum & 0xffff) + remainder;
+
+	return (uint16_t)~sum;
+}
+
+
 struct Main
 {
 	Env &env;
@@ -123,6 +143,8 @@ struct Main
 
 	Main(Env &env);
 
+	void benchmark();
+
 	void check_tcp(Tcp_packet &tcp, Ipv4_packet &ip, size_t tcp_size);
 
 	void check_udp(Udp_packet &udp, Ipv4_packet &ip);
@@ -268,8 +290,77 @@ Main::Main(Env &env) : env(env)
 	    ") in ", num_packets, " packet", num_packets == 1 ? "" : "s", " with ", num_errors, " error", num_errors == 1 ? "" : "s");
 
 	pcap_file.destruct();
+
+	if (config_rom.xml().attribute_value("benchmark", false))
+		benchmark();
+
 	env.parent().exit(num_errors ? -1 : 0);
 }
 
 
+void Main::benchmark()
+{
+	enum { BUF_SIZE = 16 * 1024, DURATION_US = 500 * 1000 };
+
+	Timer::Connection timer { env };
+
+	uint8_t *buf = (uint8_t *)heap.alloc(BUF_SIZE);
+	for (size_t i = 0; i < BUF_SIZE; i++)
+		buf[i] = prng.random_byte();
+
+	log("benchmark checksum variant \"", internet_checksum_variant(), "\"");
+
+	/*
+	 * Compare the result with the reference for all sizes and misalignments
+	 * up to some limit
+	 */
+	for (size_t offset = 0; offset < 8; offset++) {
+		for (size_t size = 0; size < 2048; size++) {
+			Packed_uint16 const *data_ptr = (Packed_uint16 const *)(buf + offset);
+			uint16_t const got    = internet_checksum(data_ptr, size);
+			uint16_t const expect = reference_checksum(buf + offset, size);
+			if (got != expect) {
+				error("benchmark: checksum of ", size, " bytes at offset ",
+				      offset, " failed (got ", Hex(got), " expected ",
+				      Hex(expect), ")");
+				num_errors++;
+			}
+		}
+	}
+
+	/* measure the throughput of the library against the reference */
+	auto measure = [&] (size_t size, auto const &checksum_fn)
+	{
+		uint64_t const start_us = timer.elapsed_us();
+		uint64_t end_us = start_us;
+		uint64_t bytes = 0;
+		uint16_t result = 0;
+		for (unsigned i = 0; end_us - start_us < DURATION_US; i++) {
+			for (unsigned j = 0; j < 1000; j++, bytes += size)
+				result = (uint16_t)(result ^ checksum_fn(buf + ((i + j) & 7), size));
+
+			end_us = timer.elapsed_us();
+		}
+		/* prevent the compiler from optimizing the loop away */
+		if (result == 0x1234)
+			log("");
+
+		return bytes / (end_us - start_us);
+	};
+	static size_t const sizes[] { 20, 64, 576, 1500, 9000 };
+	for (size_t size : sizes) {
+
+		uint64_t const lib_mb_per_s = measure(size, [] (uint8_t const *ptr, size_t sz) {
+			return internet_checksum((Packed_uint16 const *)ptr, sz); });
+
+		uint64_t const ref_mb_per_s = measure(size, [] (uint8_t const *ptr, size_t sz) {
+			return reference_checksum(ptr, sz); });
+
+		log("benchmark ", size, " bytes: ", lib_mb_per_s, " MB/s (reference ",
+		    ref_mb_per_s, " MB/s)");
+	}
+	heap.free(buf, BUF_SIZE);
+}
+
+
 void Component::construct(Env &env) { static Main main(env); }
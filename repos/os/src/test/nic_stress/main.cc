@@ -19,12 +19,21 @@
 #include <base/attached_ram_dataspace.h>
 #include <nic/packet_allocator.h>
 #include <nic_session/connection.h>
+#include <nic_session/client.h>
+#include <timer_session/connection.h>
+#include <net/ethernet.h>
+#include <net/ipv4.h>
+#include <net/udp.h>
+#include <net/size_guard.h>
 
 namespace Local {
 
 	using namespace Genode;
+	using namespace Net;
 	struct Bad_args_nic;
+	struct Bench_nic;
 	struct Construct_destruct_test;
+	struct Link_throughput_test;
 	struct Main;
 }
 
@@ -41,6 +50,20 @@ struct Local::Bad_args_nic : Connection<Nic::Session>
 };
 
 
+struct Local::Bench_nic : Connection<Nic::Session>, Nic::Session_client
+{
+	Bench_nic(Env &env, Range_allocator &tx_block_alloc, size_t ram_quota,
+	          size_t buf_size, Session::Label const &label)
+	:
+		Genode::Connection<Nic::Session>(env, label,
+		                                 Ram_quota { ram_quota + 2 * buf_size },
+		                                 Args("tx_buf_size=", buf_size, ", "
+		                                      "rx_buf_size=", buf_size)),
+		Nic::Session_client(cap(), tx_block_alloc, env.rm())
+	{ }
+};
+
+
 struct Local::Construct_destruct_test
 {
 	enum { DEFAULT_NR_OF_ROUNDS  = 10 };
@@ -129,6 +152,189 @@ struct Local::Construct_destruct_test
 };
 
 
+/**
+ * Measure the packet rate of a NIC router in relation to the number of links
+ *
+ * The test sends UDP packets at the "client" session round-robin over a
+ * given number of flows that differ in source IP and port. The NIC router is
+ * expected to route them to the "server" session, creating one link per
+ * flow. Starting with one flow, the number of flows gets doubled for each
+ * round until the configured maximum is reached. Each round measures, after
+ * all of its flows were sent once, the rate of packets received at the
+ * "server" session.
+ */
+struct Local::Link_throughput_test
+{
+	enum { DEFAULT_MAX_LINKS   = 16384 };
+	enum { DEFAULT_DURATION_MS = 1000 };
+	enum { DEFAULT_SESSION_RAM = 16 * 1024 * 1024 };
+	enum { PKT_SIZE = 64 };
+	enum { BUF_SIZE = 256 * Nic::Packet_allocator::DEFAULT_PACKET_SIZE };
+	enum { PORTS_PER_SRC_IP = 60000, FIRST_SRC_PORT = 1024 };
+
+	Env                       &_env;
+	Signal_context_capability  _completed_sigh;
+	Xml_node            const  _node;
+	Timer::Connection          _timer          { _env };
+	Nic::Packet_allocator      _client_alloc;
+	Nic::Packet_allocator      _server_alloc;
+
+	unsigned long const _max_links {
+		_node.attribute_value("max_links", (unsigned long)DEFAULT_MAX_LINKS) };
+
+	uint64_t const _duration_ms {
+		_node.attribute_value("duration_ms", (uint64_t)DEFAULT_DURATION_MS) };
+
+	size_t const _session_ram {
+		_node.attribute_value("session_ram", Number_of_bytes(DEFAULT_SESSION_RAM)) };
+
+	Ipv4_address const _src_ip {
+		_node.attribute_value("src_ip", Ipv4_address()) };
+
+	Ipv4_address const _dst_ip {
+		_node.attribute_value("dst_ip", Ipv4_address()) };
+
+	Bench_nic _client { _env, _client_alloc, _session_ram, BUF_SIZE, "client" };
+	Bench_nic _server { _env, _server_alloc, _session_ram, BUF_SIZE, "server" };
+
+	Mac_address const _client_mac { _client.mac_address() };
+
+	unsigned long _nr_of_links    { 1 };
+	unsigned long _next_flow      { 0 };
+	unsigned long _sent           { 0 };
+	unsigned long _received       { 0 };
+	unsigned long _received_start { 0 };
+	uint64_t      _start_ms       { 0 };
+	bool          _measuring      { false };
+	bool          _done           { false };
+
+	Signal_handler<Link_throughput_test> _nic_handler {
+		_env.ep(), *this, &Link_throughput_test::_handle_nic };
+
+	uint64_t _now_ms() { return _timer.curr_time().trunc_to_plain_ms().value; }
+
+	void _send_packet(unsigned long flow)
+	{
+		Packet_descriptor const pkt { _client.tx()->alloc_packet(PKT_SIZE) };
+		Size_guard size_guard { PKT_SIZE };
+
+		Ethernet_frame &eth { Ethernet_frame::construct_at(_client.tx()->packet_content(pkt), size_guard) };
+		eth.dst(Ethernet_frame::broadcast());
+		eth.src(_client_mac);
+		eth.type(Ethernet_frame::Type::IPV4);
+
+		size_t const ip_off { size_guard.head_size() };
+		Ipv4_address src_ip { _src_ip };
+		src_ip.addr[3] = (uint8_t)(src_ip.addr[3] + flow / PORTS_PER_SRC_IP);
+		Ipv4_packet &ip { eth.construct_at_data<Ipv4_packet>(size_guard) };
+		ip.header_length(sizeof(Ipv4_packet) / 4);
+		ip.version(4);
+		ip.time_to_live(64);
+		ip.protocol(Ipv4_packet::Protocol::UDP);
+		ip.src(src_ip);
+		ip.dst(_dst_ip);
+
+		size_t const udp_off { size_guard.head_size() };
+		Udp_packet &udp { ip.construct_at_data<Udp_packet>(size_guard) };
+		udp.src_port(Port((uint16_t)(FIRST_SRC_PORT + flow % PORTS_PER_SRC_IP)));
+		udp.dst_port(Port(9));
+		size_guard.consume_head(size_guard.unconsumed());
+		udp.length((uint16_t)(size_guard.head_size() - udp_off));
+		udp.update_checksum(ip.src(), ip.dst());
+
+		ip.total_length((uint16_t)(size_guard.head_size() - ip_off));
+		ip.update_checksum();
+
+		_client.tx()->submit_packet(pkt);
+	}
+
+	void _finish_round()
+	{
+		uint64_t const duration_ms { _now_ms() - _start_ms };
+		unsigned long const packets { _received - _received_start };
+		log("links ", _nr_of_links, ": ",
+		    duration_ms ? (packets * 1000) / duration_ms : 0, " packets/s");
+
+		_measuring = false;
+		_sent      = 0;
+		_next_flow = 0;
+		_nr_of_links <<= 1;
+		if (_nr_of_links > _max_links) {
+			_done = true;
+			Signal_transmitter(_completed_sigh).submit();
+		}
+	}
+
+	void _handle_nic()
+	{
+		if (_done)
+			return;
+
+		/* release acknowledged packets */
+		while (_client.tx()->ack_avail())
+			_client.tx()->release_packet(_client.tx()->get_acked_packet());
+
+		/* consume routed packets */
+		while (_server.rx()->packet_avail() && _server.rx()->ack_slots_free()) {
+			_server.rx()->acknowledge_packet(_server.rx()->get_packet());
+			_received++;
+		}
+		/* ignore anything else the router sends to the client */
+		while (_client.rx()->packet_avail() && _client.rx()->ack_slots_free())
+			_client.rx()->acknowledge_packet(_client.rx()->get_packet());
+
+		/* start measuring once each flow of the round has a link */
+		if (!_measuring && _sent >= _nr_of_links) {
+			_measuring      = true;
+			_start_ms       = _now_ms();
+			_received_start = _received;
+		}
+		if (_measuring && _now_ms() - _start_ms >= _duration_ms) {
+			_finish_round();
+			if (_done)
+				return;
+		}
+		/* fill the submit queue */
+		try {
+			while (_client.tx()->ready_to_submit()) {
+				_send_packet(_next_flow);
+				_sent++;
+				_next_flow = (_next_flow + 1) % _nr_of_links;
+			}
+		}
+		catch (Nic::Session::Tx::Source::Packet_alloc_failed) { }
+
+		_client.tx()->wakeup();
+		_server.rx()->wakeup();
+		_client.rx()->wakeup();
+	}
+
+	Link_throughput_test(Env                       &env,
+	                     Allocator                 &alloc,
+	                     Signal_context_capability  completed_sigh,
+	                     Xml_node            const &node)
+	:
+		_env            { env },
+		_completed_sigh { completed_sigh },
+		_node           { node },
+		_client_alloc   { &alloc },
+		_server_alloc   { &alloc }
+	{
+		log("link throughput: max_links=", _max_links,
+		    " duration_ms=", _duration_ms);
+
+		_client.tx_channel()->sigh_ack_avail(_nic_handler);
+		_client.tx_channel()->sigh_ready_to_submit(_nic_handler);
+		_client.rx_channel()->sigh_packet_avail(_nic_handler);
+		_client.rx_channel()->sigh_ready_to_ack(_nic_handler);
+		_server.rx_channel()->sigh_packet_avail(_nic_handler);
+		_server.rx_channel()->sigh_ready_to_ack(_nic_handler);
+
+		_handle_nic();
+	}
+};
+
+
 struct Local::Main
 {
 	Env                                    &_env;
@@ -136,6 +342,7 @@ struct Local::Main
 	Attached_rom_dataspace                  _config_rom { _env, "config" };
 	Xml_node                          const _config     { _config_rom.xml() };
 	Constructible<Construct_destruct_test>  _test_1     { };
+	Constructible<Link_throughput_test>     _test_2     { };
 
 	bool const _exit_support {
 		_config.attribute_value("exit_support", true) };
@@ -143,17 +350,38 @@ struct Local::Main
 	Signal_handler<Main> _test_completed_handler {
 		_env.ep(), *this, &Main::_handle_test_completed };
 
+	Signal_handler<Main> _test_2_completed_handler {
+		_env.ep(), *this, &Main::_handle_test_2_completed };
+
+	void _finish()
+	{
+		log("--- finished NIC stress test ---");
+		if (_exit_support) {
+			_env.parent().exit(0); }
+	}
+
 	void _handle_test_completed()
 	{
 		if (_test_1.constructed()) {
 			_test_1.destruct();
-			log("--- finished NIC stress test ---");
-			if (_exit_support) {
-				_env.parent().exit(0); }
+			if (_config.has_sub_node("link_throughput")) {
+				_test_2.construct(_env, _heap, _test_2_completed_handler,
+				                  _config.sub_node("link_throughput"));
+				return;
+			}
+			_finish();
 			return;
 		}
 	}
 
+	void _handle_test_2_completed()
+	{
+		if (_test_2.constructed()) {
+			_test_2.destruct();
+			_finish();
+		}
+	}
+
 	Main(Env &env) : _env(env)
 	{
 		log("--- NIC stress test ---");
@@ -1,6 +1,6 @@
 TARGET     = test-nic_stress
 SRC_CC     = main.cc
-LIBS       = base
+LIBS       = base net
 CONFIG_XSD = config.xsd
 
 CC_CXX_WARN_STRICT_CONVERSION =
@@ -0,0 +1,379 @@
+/*
+ * \brief  Multi-threaded benchmark of the thread-cached allocator
+ * \author agent
+ * \date   2026-10-18
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#include <base/attached_rom_dataspace.h>
+#include <base/component.h>
+#include <base/heap.h>
+#include <base/log.h>
+#include <base/semaphore.h>
+#include <base/thread.h>
+#include <base/thread_cached_allocator.h>
+#include <timer_session/connection.h>
+
+namespace Test {
+
+	using namespace Genode;
+
+	struct Worker;
+	struct Handoff;
+	struct Main;
+
+	enum { BURST = 64, STACK_SIZE = 16*1024 };
+
+	/**
+	 * Release the cache of the calling thread if 'alloc' has caches
+	 */
+	static void release_cache(Allocator &alloc)
+	{
+		if (Thread_cached_allocator * const cached =
+		    dynamic_cast<Thread_cached_allocator *>(&alloc))
+			cached->release_cache();
+	}
+}
+
+
+/**
+ * Thread that allocates and frees bursts of differently sized blocks
+ */
+struct Test::Worker : Thread
+{
+	Allocator      &_alloc;
+	unsigned const  _rounds;
+	unsigned        _seed;
+	bool            _failed { false };
+
+	Worker(Env &env, Allocator &alloc, unsigned rounds, unsigned seed)
+	:
+		Thread(env, "worker", STACK_SIZE), _alloc(alloc), _rounds(rounds),
+		_seed(seed)
+	{ }
+
+	size_t _random_size()
+	{
+		static size_t const sizes[] = { 16, 24, 48, 64, 100, 200, 500, 1000, 1800 };
+
+		_seed = _seed*1103515245 + 12345;
+		return sizes[(_seed >> 16) % (sizeof(sizes)/sizeof(sizes[0]))];
+	}
+
+	void entry() override
+	{
+		void *blocks[BURST] { };
+
+		for (unsigned round = 0; round < _rounds && !_failed; round++) {
+
+			for (void *&block : blocks)
+				_alloc.try_alloc(_random_size()).with_result(
+					[&] (void *ptr) { block = ptr; *(char *)ptr = 1; },
+					[&] (Allocator::Alloc_error) { _failed = true; });
+
+			for (void *&block : blocks) {
+				if (block)
+					_alloc.free(block, 0);
+				block = nullptr;
+			}
+		}
+		release_cache(_alloc);
+	}
+};
+
+
+/**
+ * Pair of threads, the producer allocates blocks freed by the consumer
+ */
+struct Test::Handoff
+{
+	/*
+	 * Noncopyable
+	 */
+	Handoff(Handoff const &);
+	Handoff &operator = (Handoff const &);
+
+	struct Party : Thread
+	{
+		Handoff &_handoff;
+		bool const _producer;
+
+		Party(Env &env, Handoff &handoff, bool producer)
+		:
+			Thread(env, producer ? "producer" : "consumer", STACK_SIZE),
+			_handoff(handoff), _producer(producer)
+		{ }
+
+		void entry() override
+		{
+			if (_producer) _handoff._produce();
+			else           _handoff._consume();
+		}
+	};
+
+	Allocator      &_alloc;
+	unsigned const  _rounds;
+	void           *_blocks[BURST] { };
+	Semaphore       _filled { 0 };
+	Semaphore       _emptied { 1 };
+	bool            _failed { false };
+
+	Party _producer, _consumer;
+
+	void _produce()
+	{
+		for (unsigned round = 0; round < _rounds; round++) {
+			_emptied.down();
+			for (void *&block : _blocks)
+				_alloc.try_alloc(128).with_result(
+					[&] (void *ptr) { block = ptr; },
+					[&] (Allocator::Alloc_error) { block = nullptr; _failed = true; });
+			_filled.up();
+		}
+		_emptied.down();
+		release_cache(_alloc);
+	}
+
+	void _consume()
+	{
+		for (unsigned round = 0; round < _rounds; round++) {
+			_filled.down();
+			for (void *&block : _blocks) {
+				if (block)
+					_alloc.free(block, 0);
+				block = nullptr;
+			}
+			_emptied.up();
+		}
+		release_cache(_alloc);
+	}
+
+	Handoff(Env &env, Allocator &alloc, unsigned rounds)
+	:
+		_alloc(alloc), _rounds(rounds),
+		_producer(env, *this, true), _consumer(env, *this, false)
+	{ }
+
+	void run()
+	{
+		_producer.start(); _consumer.start();
+		_producer.join();  _consumer.join();
+	}
+};
+
+
+struct Test::Main
+{
+	Env &_env;
+
+	Attached_rom_dataspace _config { _env, "config" };
+
+	unsigned const _threads {
+		_config.xml().attribute_value("threads", 4U) };
+
+	unsigned const _rounds {
+		_config.xml().attribute_value("rounds", 20000U) };
+
+	Heap _heap { _env.ram(), _env.rm() };
+
+	Timer::Connection _timer { _env };
+
+	bool _failed = false;
+
+	static uint64_t _ns_per_op(uint64_t us, uint64_t ops) {
+		return ops ? (us*1000)/ops : 0; }
+
+	/**
+	 * Run 'num_threads' workers on 'alloc' and return ns per operation
+	 */
+	uint64_t _run_workers(Allocator &alloc, unsigned num_threads)
+	{
+		enum { MAX_THREADS = 16 };
+
+		Constructible<Worker> workers[MAX_THREADS];
+
+		num_threads = min(num_threads, (unsigned)MAX_THREADS);
+
+		uint64_t const start_us = _timer.elapsed_us();
+
+		for (unsigned i = 0; i < num_threads; i++) {
+			workers[i].construct(_env, alloc, _rounds, i + 1);
+			workers[i]->start();
+		}
+		for (unsigned i = 0; i < num_threads; i++) {
+			workers[i]->join();
+			_failed |= workers[i]->_failed;
+		}
+
+		uint64_t const ops = 2ull*num_threads*_rounds*BURST;
+		return _ns_per_op(_timer.elapsed_us() - start_us, ops);
+	}
+
+	/**
+	 * Run producer/consumer pair on 'alloc' and return ns per operation
+	 */
+	uint64_t _run_handoff(Allocator &alloc)
+	{
+		Handoff handoff { _env, alloc, _rounds };
+
+		uint64_t const start_us = _timer.elapsed_us();
+		handoff.run();
+		_failed |= handoff._failed;
+
+		return _ns_per_op(_timer.elapsed_us() - start_us, 2ull*_rounds*BURST);
+	}
+
+	/**
+	 * Compare the cost per operation with and without contention
+	 *
+	 * The ratio between the cost with all threads and with a single thread
+	 * quantifies the contention on the allocator.
+	 */
+	void _benchmark(char const *name, Allocator &alloc)
+	{
+		uint64_t const single  = _run_workers(alloc, 1);
+		uint64_t const multi   = _run_workers(alloc, _threads);
+		uint64_t const handoff = _run_handoff(alloc);
+
+		log(name, ": 1 thread ", single, " ns/op, ",
+		    _threads, " threads ", multi, " ns/op (contention ",
+		    single ? (multi*100)/single : 0, "%), "
+		    "cross-thread free ", handoff, " ns/op");
+	}
+
+	/**
+	 * Check that blocks freed by another thread return to the owner
+	 */
+	bool _test_owner_return(Thread_cached_allocator &alloc)
+	{
+		enum { BLOCKS = Thread_cached_allocator::MAGAZINE_SIZE };
+		void *blocks[BLOCKS] { };
+		void *allocated[BLOCKS] { };
+
+		alloc.flush();
+
+		for (unsigned i = 0; i < BLOCKS; i++)
+			blocks[i] = allocated[i] = alloc.alloc(128);
+
+		struct Freeing_thread : Thread
+		{
+			Allocator &alloc;
+			void    *(&blocks)[BLOCKS];
+
+			Freeing_thread(Env &env, Allocator &alloc, void *(&blocks)[BLOCKS])
+			: Thread(env, "freeing", STACK_SIZE), alloc(alloc), blocks(blocks) { }
+
+			void entry() override
+			{
+				for (void *block : blocks)
+					alloc.free(block, 0);
+			}
+		} freeing_thread { _env, alloc, blocks };
+
+		freeing_thread.start();
+		freeing_thread.join();
+
+		/* the entrypoint must get its own blocks back */
+		bool returned = true;
+		for (void *&block : blocks) {
+			block = alloc.alloc(128);
+
+			bool found = false;
+			for (void *ptr : allocated)
+				found |= (ptr == block);
+			returned &= found;
+		}
+
+		for (void *block : blocks)
+			alloc.free(block, 0);
+
+		return returned;
+	}
+
+	/**
+	 * Check that threads beyond 'MAX_CACHES' get a cache if others exited
+	 */
+	bool _test_thread_churn(Thread_cached_allocator &alloc)
+	{
+		struct Churn_thread : Thread
+		{
+			Thread_cached_allocator &alloc;
+			bool cached = false;
+
+			Churn_thread(Env &env, Thread_cached_allocator &alloc)
+			: Thread(env, "churn", STACK_SIZE), alloc(alloc) { }
+
+			void entry() override
+			{
+				void * const first = alloc.alloc(128);
+				alloc.free(first, 0);
+
+				/* a cached block is handed out again */
+				void * const second = alloc.alloc(128);
+				cached = (first == second);
+				alloc.free(second, 0);
+
+				alloc.release_cache();
+			}
+		};
+
+		enum { THREADS = 3*Thread_cached_allocator::MAX_CACHES };
+
+		for (unsigned i = 0; i < THREADS; i++) {
+			Churn_thread thread { _env, alloc };
+			thread.start();
+			thread.join();
+
+			if (!thread.cached)
+				return false;
+		}
+		return true;
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		log("--- thread-cached allocator test (", _threads, " threads, ",
+		    _rounds, " rounds) ---");
+
+		size_t const consumed_before = _heap.consumed();
+
+		_benchmark("heap         ", _heap);
+
+		{
+			Thread_cached_allocator cached_alloc { _heap };
+
+			_benchmark("thread-cached", cached_alloc);
+
+			if (!_test_owner_return(cached_alloc)) {
+				error("blocks freed by another thread did not return to the owner");
+				_failed = true;
+			}
+
+			if (!_test_thread_churn(cached_alloc)) {
+				error("threads started after others exited got no cache");
+				_failed = true;
+			}
+		}
+
+		if (_heap.consumed() != consumed_before) {
+			error("heap consumption changed from ", consumed_before,
+			      " to ", _heap.consumed(), " bytes");
+			_failed = true;
+		}
+
+		if (_failed) {
+			error("test failed");
+			return;
+		}
+		log("--- test finished ---");
+	}
+};
+
+
+void Component::construct(Genode::Env &env) { static Test::Main main(env); }
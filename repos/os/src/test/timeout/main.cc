@@ -784,6 +784,171 @@ struct Fast_polling : Test
 };
 
 
+struct Many_timeouts : Test
+{
+	static constexpr char const *brief = "schedule and discard many timeouts";
+
+	using Timeout = Timer::One_shot_timeout<Many_timeouts>;
+
+	enum { NR_OF_PROBES = 32 };
+	enum { STRIDE = 7919 };
+
+	/*
+	 * The timeouts of the load are scheduled far enough in the future that
+	 * they do not trigger during the lifetime of the test.
+	 */
+	static constexpr uint64_t LOAD_US  = (uint64_t)1000 * 1000 * 1000;
+	static constexpr uint64_t PROBE_US = (uint64_t)10 * 1000;
+
+	/*
+	 * Discarding a timeout must take constant time. Hence, discarding with
+	 * the full load scheduled must not be notably slower than discarding
+	 * with only a small part of the load scheduled. The slack absorbs the
+	 * resolution of the time measurement and cache effects.
+	 */
+	enum { SMALL_LOAD_DIVISOR   = 16 };
+	enum { MAX_DISCARD_SCALING  = 4 };
+	enum { DISCARD_SLACK_NS     = 100 };
+
+	unsigned const nr_of_timeouts {
+		max(config.xml().attribute_value("many_timeouts", 16384U),
+		    (unsigned)NR_OF_PROBES) };
+
+	Attached_ram_dataspace timeouts_ds {
+		env.ram(), env.rm(), nr_of_timeouts*sizeof(Constructible<Timeout>) };
+
+	uint64_t probes_start_us { 0 };
+	unsigned nr_of_probes    { 0 };
+
+	Constructible<Timeout> &timeout(unsigned idx) {
+		return timeouts_ds.local_addr<Constructible<Timeout>>()[idx]; }
+
+	/**
+	 * Return index of the 'i'th timeout in a pseudo-random order
+	 */
+	unsigned shuffled(unsigned i) const {
+		return (unsigned)(((uint64_t)i * STRIDE) % nr_of_timeouts); }
+
+	uint64_t now_us() { return timer.curr_time().trunc_to_plain_us().value; }
+
+	/**
+	 * Execute 'fn' and return the average duration of its operations in ns
+	 */
+	template <typename FN>
+	uint64_t measure(char const *operation, unsigned nr_of_ops, FN const &fn)
+	{
+		uint64_t const start_us { now_us() };
+		fn();
+		uint64_t const duration_us { now_us() - start_us };
+		uint64_t const op_ns       { (duration_us * 1000) / nr_of_ops };
+
+		log(operation, ": ", nr_of_ops, " operations in ", duration_us,
+		    " us, ", op_ns, " ns per operation");
+
+		return op_ns;
+	}
+
+	void handle_probe(Duration time)
+	{
+		/*
+		 * The probes are scheduled with distinct deadlines. Hence, the n'th
+		 * triggered probe must not trigger before the n'th deadline.
+		 */
+		uint64_t const elapsed_us { time.trunc_to_plain_us().value - probes_start_us };
+		uint64_t const expected_us { (nr_of_probes + 1) * PROBE_US };
+		if (elapsed_us < expected_us) {
+			error("probe ", nr_of_probes, " triggered after ", elapsed_us,
+			      " us, expected ", expected_us, " us");
+			error_cnt++;
+		}
+		if (++nr_of_probes < NR_OF_PROBES) {
+			return; }
+
+		/* none of the probes may be left and none of the load triggered */
+		for (unsigned i = 0; i < nr_of_timeouts; i++) {
+			if (timeout(i)->scheduled() != (i >= NR_OF_PROBES)) {
+				error("unexpected state of timeout ", i);
+				error_cnt++;
+				break;
+			}
+		}
+		log("all ", (unsigned)NR_OF_PROBES, " probes triggered in order");
+
+		measure("discard remaining", nr_of_timeouts - NR_OF_PROBES, [&] {
+			for (unsigned i = NR_OF_PROBES; i < nr_of_timeouts; i++)
+				timeout(i)->discard(); });
+
+		done.submit();
+	}
+
+	Many_timeouts(Env                       &env,
+	              unsigned                  &error_cnt,
+	              Signal_context_capability  done,
+	              unsigned                   id)
+	:
+		Test(env, error_cnt, done, id, brief)
+	{
+		for (unsigned i = 0; i < nr_of_timeouts; i++) {
+			construct_at<Constructible<Timeout>>(&timeout(i));
+			timeout(i).construct(timer, *this, &Many_timeouts::handle_probe);
+		}
+
+		/* measure discarding with a small load as reference */
+		unsigned const nr_of_small { nr_of_timeouts / SMALL_LOAD_DIVISOR };
+		for (unsigned i = 0; i < nr_of_small; i++)
+			timeout(i * SMALL_LOAD_DIVISOR)->schedule(
+				Microseconds { LOAD_US + shuffled(i) });
+
+		uint64_t const small_discard_ns {
+			measure("discard with small load", nr_of_small, [&] {
+				for (unsigned i = 0; i < nr_of_small; i++)
+					timeout(((i * STRIDE) % nr_of_small) *
+					        SMALL_LOAD_DIVISOR)->discard(); }) };
+
+		measure("schedule", nr_of_timeouts, [&] {
+			for (unsigned i = 0; i < nr_of_timeouts; i++)
+				timeout(shuffled(i))->schedule(
+					Microseconds { LOAD_US + shuffled(i) }); });
+
+		measure("re-schedule", nr_of_timeouts, [&] {
+			for (unsigned i = 0; i < nr_of_timeouts; i++)
+				timeout(shuffled(i))->schedule(
+					Microseconds { LOAD_US + i }); });
+
+		uint64_t const discard_ns {
+			measure("discard", nr_of_timeouts / 2, [&] {
+				for (unsigned i = 0; i < nr_of_timeouts / 2; i++)
+					timeout(shuffled(i))->discard(); }) };
+
+		if (discard_ns > small_discard_ns * MAX_DISCARD_SCALING +
+		                 DISCARD_SLACK_NS) {
+
+			error("discard takes ", discard_ns, " ns with ", nr_of_timeouts,
+			      " timeouts but ", small_discard_ns, " ns with ",
+			      nr_of_small, " timeouts");
+			error_cnt++;
+		}
+
+		measure("schedule", nr_of_timeouts / 2, [&] {
+			for (unsigned i = 0; i < nr_of_timeouts / 2; i++)
+				timeout(shuffled(i))->schedule(
+					Microseconds { LOAD_US + i }); });
+
+		/* replace the load timeouts with the lowest indices by probes */
+		probes_start_us = now_us();
+		for (unsigned i = 0; i < NR_OF_PROBES; i++)
+			timeout(i)->schedule(
+				Microseconds { (NR_OF_PROBES - i) * PROBE_US });
+	}
+
+	~Many_timeouts()
+	{
+		for (unsigned i = 0; i < nr_of_timeouts; i++)
+			timeout(i).destruct();
+	}
+};
+
+
 struct Main
 {
 	Env                           &env;
@@ -792,10 +957,12 @@ struct Main
 	Constructible<Duration_test>   test_1      { };
 	Constructible<Fast_polling>    test_2      { };
 	Constructible<Mixed_timeouts>  test_3      { };
+	Constructible<Many_timeouts>   test_4      { };
 	Signal_handler<Main>           test_0_done { env.ep(), *this, &Main::handle_test_0_done };
 	Signal_handler<Main>           test_1_done { env.ep(), *this, &Main::handle_test_1_done };
 	Signal_handler<Main>           test_2_done { env.ep(), *this, &Main::handle_test_2_done };
 	Signal_handler<Main>           test_3_done { env.ep(), *this, &Main::handle_test_3_done };
+	Signal_handler<Main>           test_4_done { env.ep(), *this, &Main::handle_test_4_done };
 
 	Main(Env &env) : env(env)
 	{
@@ -823,6 +990,12 @@ struct Main
 	void handle_test_3_done()
 	{
 		test_3.destruct();
+		test_4.construct(env, error_cnt, test_4_done, 4);
+	}
+
+	void handle_test_4_done()
+	{
+		test_4.destruct();
 		if (error_cnt) {
 			error("test failed because of ", error_cnt, " error(s)");
 			env.parent().exit(-1);
@@ -37,6 +37,7 @@
 #include <timer_session/connection.h>
 #include <base/heap.h>
 #include <base/attached_rom_dataspace.h>
+#include <base/attached_dataspace.h>
 #include <base/component.h>
 #include <base/log.h>
 #include <base/exception.h>
@@ -269,6 +270,70 @@ struct Populate_test : public Stress_test
 };
 
 
+struct Lookup_test : public Stress_test
+{
+	void lookup(int depth)
+	{
+		if (++depth > MAX_DEPTH) return;
+
+		size_t path_len = 1+strlen(path.base());
+		char dir_type = *(path.base()+(path_len-2));
+
+		using namespace Vfs;
+
+		path.append("/c");
+		{
+			Directory_service::Stat stat { };
+			if (vfs.stat(path.base(), stat) != Directory_service::STAT_OK) {
+				error("stat of '", path, "' failed");
+				throw Exception();
+			}
+			++count;
+		}
+
+		switch (dir_type) {
+		case 'a':
+			path.base()[path_len] = '\0';
+			path.append("a");
+			lookup(depth);
+			[[fallthrough]];
+
+		case 'b':
+			path.base()[path_len] = '\0';
+			path.append("b");
+			lookup(depth);
+			return;
+
+		default:
+			error("bad directory ", Char(dir_type), " at the end of '", path, "'");
+			throw Exception();
+		}
+	}
+
+	Lookup_test(Vfs::File_system &vfs, Genode::Allocator &alloc, char const *parent)
+	: Stress_test(vfs, alloc, parent)
+	{
+		size_t path_len = strlen(path.base());
+		try {
+			path.append("/a");
+			lookup(1);
+
+			path.base()[path_len] = '\0';
+			path.append("/b");
+			lookup(1);
+		} catch (...) {
+			error("failed at ",path," after ",count," lookups");
+			throw;
+		}
+	}
+
+	Vfs::file_size wait()
+	{
+		return count;
+	}
+};
+
+
 struct Write_test : public Stress_test
 {
 	Vfs::Env::Io &_io;
@@ -513,6 +578,164 @@ struct Unlink_test : public Stress_test
 	}
 };
 
+/**
+ * Check a file that spans multiple extents of the RAM file system
+ *
+ * The file is exported as dataspace, modified, truncated, and extended
+ * across extent boundaries afterwards, which must leave the exported content
+ * intact. A write far beyond the end of the file must not allocate memory
+ * for the hole.
+ */
+struct Extent_test
+{
+	Genode::Env       &env;
+	Vfs::File_system  &vfs;
+	Genode::Allocator &alloc;
+	Vfs::Env::Io      &io;
+
+	char const * const path = "/extents";
+
+	enum {
+		SIZE   = 3*1024*1024 + 123,
+		CUT    = SIZE/3 + 17,
+		MODIFY = 1024*1024 - 2,
+		HOLE   = 64*1024*1024,
+	};
+
+	char _buf[4096] { };
+
+	static char pattern(Vfs::file_size pos) { return char(pos ^ (pos >> 12)); }
+
+	void write(Vfs::Vfs_handle &handle, Vfs::file_size at, char const *src, size_t len)
+	{
+		handle.seek(at);
+
+		size_t n = 0;
+		assert_write(handle.fs().write(&handle, Const_byte_range_ptr(src, len), n));
+		if (n != len) {
+			error("short write of ", n, " bytes at offset ", at);
+			throw Exception();
+		}
+	}
+
+	void read(Vfs::Vfs_handle &handle, Vfs::file_size at, char *dst, size_t len)
+	{
+		handle.seek(at);
+		handle.fs().queue_read(&handle, len);
+
+		size_t n = 0;
+		Vfs::File_io_service::Read_result result;
+		while ((result = handle.fs().complete_read(&handle, Byte_range_ptr(dst, len), n)) ==
+		       Vfs::File_io_service::READ_QUEUED)
+			io.commit_and_wait();
+
+		assert_read(result);
+		if (n != len) {
+			error("short read of ", n, " bytes at offset ", at);
+			throw Exception();
+		}
+	}
+
+	void ftruncate(Vfs::Vfs_handle &handle, Vfs::file_size size)
+	{
+		if (handle.fs().ftruncate(&handle, size) != Vfs::File_io_service::FTRUNCATE_OK) {
+			error("failed to truncate file to ", size, " bytes");
+			throw Exception();
+		}
+	}
+
+	void verify(Vfs::Vfs_handle &handle, Vfs::file_size from, Vfs::file_size to,
+	            auto const &expected)
+	{
+		for (Vfs::file_size pos = from; pos < to; ) {
+			size_t const len = (size_t)min(to - pos, (Vfs::file_size)sizeof(_buf));
+			read(handle, pos, _buf, len);
+			for (size_t i = 0; i < len; i++) {
+				if (_buf[i] != expected(pos + i)) {
+					error("unexpected file content at offset ", pos + i);
+					throw Exception();
+				}
+			}
+			pos += len;
+		}
+	}
+
+	void verify_exported(Dataspace_capability ds)
+	{
+		Attached_dataspace exported(env.rm(), ds);
+
+		char const * const content = exported.local_addr<char const>();
+		if (exported.size() < SIZE) {
+			error("exported dataspace too small");
+			throw Exception();
+		}
+		for (size_t i = 0; i < exported.size(); i++) {
+			if (content[i] != ((i < SIZE) ? pattern(i) : 0)) {
+				error("unexpected exported content at offset ", i);
+				throw Exception();
+			}
+		}
+	}
+
+	Extent_test(Genode::Env &env, Vfs::File_system &vfs,
+	            Genode::Allocator &alloc, Vfs::Env::Io &io)
+	:
+		env(env), vfs(vfs), alloc(alloc), io(io)
+	{
+		using namespace Vfs;
+
+		{
+			Vfs_handle *handle = nullptr;
+			assert_open(vfs.open(path, Directory_service::OPEN_MODE_RDWR
+			                         | Directory_service::OPEN_MODE_CREATE,
+			                     &handle, alloc));
+			Vfs_handle::Guard guard(handle);
+
+			for (file_size pos = 0; pos < SIZE; ) {
+				size_t const len = (size_t)min(SIZE - pos, (file_size)sizeof(_buf));
+				for (size_t i = 0; i < len; i++)
+					_buf[i] = pattern(pos + i);
+				write(*handle, pos, _buf, len);
+				pos += len;
+			}
+			verify(*handle, 0, SIZE, pattern);
+
+			Dataspace_capability const ds = vfs.dataspace(path);
+			if (!ds.valid()) {
+				error("failed to obtain dataspace of '", path, "'");
+				throw Exception();
+			}
+			verify_exported(ds);
+
+			/* modify, truncate, and extend the exported file */
+			write(*handle, MODIFY, "~~~~", 4);
+			ftruncate(*handle, CUT);
+			ftruncate(*handle, SIZE);
+
+			verify(*handle, 0, SIZE, [&] (file_size pos) {
+				return (pos >= MODIFY && pos < MODIFY + 4) ? '~'
+				     : (pos < CUT) ? pattern(pos) : 0; });
+
+			verify_exported(ds);
+			vfs.release(path, ds);
+
+			/* a hole in a sparse file occupies no memory */
+			size_t const used_ram = env.pd().used_ram().value;
+			write(*handle, HOLE, "~", 1);
+			if (env.pd().used_ram().value - used_ram > 1024*1024) {
+				error("hole in sparse file occupies memory");
+				throw Exception();
+			}
+			auto hole = [&] (file_size pos) { return (pos == HOLE) ? '~' : 0; };
+			verify(*handle, SIZE, SIZE + 4096, hole);
+			verify(*handle, HOLE - 4096, HOLE + 1, hole);
+		}
+
+		assert_unlink(vfs.unlink(path));
+	}
+};
+
+
 void die(Genode::Env &env, int code) { env.parent().exit(code); }
 
 void Component::construct(Genode::Env &env)
@@ -551,6 +774,15 @@ void Component::construct(Genode::Env &env)
 	/* populate the directory file system at / */
 	vfs_root.num_dirent("/");
 
+	if (config_xml.attribute_value("extents", false)) {
+		log("checking extents...");
+		try { Extent_test test(env, vfs_root, heap, vfs_env.io()); }
+		catch (...) {
+			error("extent test failed");
+			return die(env, -1);
+		}
+	}
+
 	size_t initial_consumption = env.pd().used_ram().value;
 
 	/**************************
@@ -605,6 +837,31 @@ void Component::construct(Genode::Env &env)
 	}
 
 
+	/******************
+	 ** Lookup files **
+	 ******************/
+
+	if (unsigned const rounds = config_xml.attribute_value("lookup", 0U)) {
+		Vfs::file_size count = 0;
+		log("looking up files...");
+		elapsed_ms = timer.elapsed_ms();
+
+		for (unsigned round = 0; round < rounds; ++round) {
+			for (int i = 0; i < ROOT_TREE_COUNT; ++i) {
+				path = { "/", i };
+				Lookup_test test(vfs_root, heap, path.string());
+				count += test.wait();
+			}
+		}
+
+		elapsed_ms = timer.elapsed_ms() - elapsed_ms;
+
+		if (count > 0)
+			log("looked up ",count," files, ",
+			    (elapsed_ms*1000*1000)/count,"ns/op");
+	}
+
+
 	/*****************
 	 ** Write files **
 	 *****************/